@@ -23,24 +23,46 @@
   w danym punkcie,
   15) COMPOSE @p k -- usuwa ze stosu wielomianów @f$k+1@f$ wielomianów
   i pierwszy z nich składa z pozostałymi, ułożonymi w odwrotnej kolejności
-  do tej, z jaką są ściągane ze stosu.
+  do tej, z jaką są ściągane ze stosu,
+  16) IS_EQ_FAST @p k [@p t] -- probabilistyczne sprawdzenie w @p t próbach
+  (domyślnie czterech), czy wielomian z wierzchołka stosu jest równy
+  iloczynowi @p k wielomianów znajdujących się pod nim, bez ich wymnażania,
+  17) POW @p e -- zastąpienie wielomianu z wierzchołka stosu jego @p e-tą
+  potęgą,
+  18) MUL_TRUNC @p n -- zastąpienie dwóch wielomianów z wierzchołka stosu
+  ich iloczynem bez wyrazów stopnia większego od @p n względem @f$x_0@f$,
+  19) TRUNC @p n -- usunięcie z wielomianu z wierzchołka stosu wyrazów
+  stopnia większego od @p n względem @f$x_0@f$,
+  20) "FMA" -- zastąpienie trzech wielomianów z wierzchołka stosu sumą
+  trzeciego z nich i iloczynu dwóch pierwszych,
+  21) ADD_N @p n -- zastąpienie @p n wielomianów z wierzchołka stosu ich
+  sumą.
+  Polecenia są czytane ze standardowego wejścia, a jeśli podano argumenty
+  -- z plików o podanych ścieżkach, odwzorowanych w pamięci. Wywołanie
+  @p poly @p --jobs @p N @p plik1 @p plik2 ... wykonuje pliki niezależnie
+  od siebie, w @p N wątkach, i wypisuje ich wyniki w kolejności plików.
   
   @author Dawid Mędrek
   @date 2021
 */
 
-#include <stdlib.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 #include <limits.h>
 #include <errno.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <pthread.h>
 
 #include "poly.h"
 #include "polystack.h"
 #include "newstring.h"
-#include "monovector.h"
+#include "output.h"
+#include "parser.h"
+#include "script.h"
 
 
 /**
@@ -53,6 +75,14 @@ typedef enum {
   NoDegByParam, ///< brak parametru dla polecenia @p DEG_BY
   NoAtParam, ///< brak parametru dla polecenia @p AT
   NoComposeParam, ///< brak parametru lub jego brak dla polecenia @p COMPOSE
+  NoIsEqFastParam, ///< brak lub niepoprawny parametr polecenia @p IS_EQ_FAST
+  NoPowParam, ///< brak lub niepoprawny parametr polecenia @p POW
+  NoMulTruncParam, ///< brak lub niepoprawny parametr polecenia @p MUL_TRUNC
+  NoTruncParam, ///< brak lub niepoprawny parametr polecenia @p TRUNC
+  NoAddNParam, ///< brak lub niepoprawny parametr polecenia @p ADD_N
+  NoSaveParam, ///< brak parametru polecenia @p SAVE lub błąd zapisu pliku
+  NoLoadParam, ///< brak parametru polecenia @p LOAD lub błąd odczytu pliku
+  NoFreezeParam, ///< brak parametru polecenia @p FREEZE lub błąd zapisu pliku
   StackUnderflow, ///< brak wystarczającej liczby wielomianów na stosie
   ParsingErr, ///< błąd podczas parsowania wielomianu
   NoError ///< brak błędu
@@ -109,10 +139,10 @@ static inline InputErr ExecuteIsCoeff(stack_t *stack) {
 
   Poly topPoly = ShowTop(stack);
   if (PolyIsCoeff(&topPoly)) {
-    printf("1\n");
+    WriteString(StandardOutput, "1\n");
   }
   else {
-    printf("0\n");
+    WriteString(StandardOutput, "0\n");
   }
 
   return NoError;
@@ -136,10 +166,10 @@ static inline InputErr ExecuteIsZero(stack_t *stack) {
 
   Poly topPoly = ShowTop(stack);
   if (PolyIsZero(&topPoly)) {
-    printf("1\n");
+    WriteString(StandardOutput, "1\n");
   }
   else {
-    printf("0\n");
+    WriteString(StandardOutput, "0\n");
   }
 
   return NoError;
@@ -166,11 +196,12 @@ static inline InputErr ExecuteClone(stack_t *stack) {
 
 /**
  * Ściąga z przekazanego stosu wielomianów dwa wielomiany i dodaje ich sumę
- * do tego stosu. Wykorzystane w tym celu wielomiany są następnie usuwane
- * z pamięci. Jeżeli jednak na stosie nie ma wymaganej do tej operacji liczby
- * wielomianów, funkcja zwraca @p StackUnderflow i nie robi nic. W przeciwnym
- * wypadku zwraca @p NoError. Funkcja zakłada także, że przekazany wskaźnik
- * na stos wskazuje na istniejący i poprawny stos.
+ * do tego stosu. Wykorzystane w tym celu wielomiany są przejmowane przez
+ * funkcję @p PolyAddOwn, która wykorzystuje lub zwalnia ich pamięć. Jeżeli
+ * jednak na stosie nie ma wymaganej do tej operacji liczby wielomianów,
+ * funkcja zwraca @p StackUnderflow i nie robi nic. W przeciwnym wypadku
+ * zwraca @p NoError. Funkcja zakłada także, że przekazany wskaźnik na stos
+ * wskazuje na istniejący i poprawny stos.
  * @param[in] stack : stos wielomianów
  * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
  * dwóch wielomianów; @p NoError w przeciwnym przypadku
@@ -182,9 +213,7 @@ static inline InputErr ExecuteAdd(stack_t *stack) {
   else {
     Poly p1 = TakePoly(stack);
     Poly p2 = TakePoly(stack);
-    PushPoly(stack, PolyAdd(&p1, &p2));
-    PolyDestroy(&p1);
-    PolyDestroy(&p2);
+    PushPoly(stack, PolyAddOwn(&p1, &p2));
     return NoError;
   }
 }
@@ -194,8 +223,10 @@ static inline InputErr ExecuteAdd(stack_t *stack) {
  * do tego stosu. Wykorzystane w tym celu wielomiany są następnie usuwane
  * z pamięci. Jeżeli jednak na stosie nie ma wymaganej do tej operacji liczby
  * wielomianów, funkcja zwraca @p StackUnderflow i nie robi nic. W przeciwnym
- * wypadku zwraca @p NoError. Funkcja zakłada także, że przekazany wskaźnik
- * na stos wskazuje na istniejący i poprawny stos.
+ * wypadku zwraca @p NoError. Równe wielomiany są podnoszone do kwadratu
+ * funkcją @p PolySqr, a pozostałe mnożone funkcją @p PolyMulOwn, która
+ * wykorzystuje pamięć wielomianów ze stosu. Funkcja zakłada także, że
+ * przekazany wskaźnik na stos wskazuje na istniejący i poprawny stos.
  * @param[in] stack : stos wielomianów
  * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
  * dwóch wielomianów; @p NoError w przeciwnym przypadku
@@ -207,7 +238,42 @@ static inline InputErr ExecuteMul(stack_t *stack) {
   else {
     Poly p1 = TakePoly(stack);
     Poly p2 = TakePoly(stack);
-    PushPoly(stack, PolyMul(&p1, &p2));
+
+    // Mnożenie wielomianu przez siebie (np. po poleceniu CLONE)
+    if (PolyIsEq(&p1, &p2)) {
+      PushPoly(stack, PolySqr(&p1));
+    }
+    else {
+      PushPoly(stack, PolyMulOwn(&p1, &p2));
+    }
+
+    PolyDestroy(&p1);
+    PolyDestroy(&p2);
+    return NoError;
+  }
+}
+
+/**
+ * Ściąga z przekazanego stosu wielomianów trzy wielomiany @f$a@f$, @f$b@f$ i
+ * @f$c@f$ (w tej kolejności) i dodaje do niego wielomian @f$c + a * b@f$,
+ * obliczony funkcją @p PolyFma. Wielomian @f$c@f$ jest modyfikowany w
+ * miejscu, a pozostałe wykorzystane wielomiany są usuwane z pamięci. Jeżeli
+ * na stosie nie ma trzech wielomianów, funkcja nie robi nic i zwraca
+ * @p StackUnderflow.
+ * @param[in] stack : stos wielomianów
+ * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
+ * trzech wielomianów; @p NoError w przeciwnym przypadku
+ */
+static inline InputErr ExecuteFma(stack_t *stack) {
+  if (StackSize(stack) < 3) {
+    return StackUnderflow;
+  }
+  else {
+    Poly p1 = TakePoly(stack);
+    Poly p2 = TakePoly(stack);
+    Poly acc = TakePoly(stack);
+    PolyFma(&acc, &p1, &p2);
+    PushPoly(stack, acc);
     PolyDestroy(&p1);
     PolyDestroy(&p2);
     return NoError;
@@ -239,11 +305,12 @@ static inline InputErr ExecuteNeg(stack_t *stack) {
 
 /**
  * Ściąga z przekazanego stosu wielomianów dwa wielomiany i dodaje ich różnicę
- * do tego stosu. Wykorzystane w tym celu wielomiany są następnie usuwane
- * z pamięci. Jeżeli jednak na stosie nie ma wymaganej do tej operacji liczby
- * wielomianów, funkcja zwraca @p StackUnderflow i nie robi nic. W przeciwnym
- * wypadku zwraca @p NoError. Funkcja zakłada także, że przekazany wskaźnik
- * na stos wskazuje na istniejący i poprawny stos.
+ * do tego stosu. Wykorzystane w tym celu wielomiany są przejmowane przez
+ * funkcję @p PolySubOwn, która wykorzystuje lub zwalnia ich pamięć. Jeżeli
+ * jednak na stosie nie ma wymaganej do tej operacji liczby wielomianów,
+ * funkcja zwraca @p StackUnderflow i nie robi nic. W przeciwnym wypadku
+ * zwraca @p NoError. Funkcja zakłada także, że przekazany wskaźnik na stos
+ * wskazuje na istniejący i poprawny stos.
  * @param[in] stack : stos wielomianów
  * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
  * dwóch wielomianów; @p NoError w przeciwnym przypadku
@@ -255,9 +322,7 @@ static inline InputErr ExecuteSub(stack_t *stack) {
   else {
     Poly p1 = TakePoly(stack);
     Poly p2 = TakePoly(stack);
-    PushPoly(stack, PolySub(&p1, &p2));
-    PolyDestroy(&p1);
-    PolyDestroy(&p2);
+    PushPoly(stack, PolySubOwn(&p1, &p2));
     return NoError;
   }
 }
@@ -283,12 +348,64 @@ static inline InputErr ExecuteIsEq(stack_t *stack) {
     PushPoly(stack, p1);
 
     if (PolyIsEq(&p1, &p2)) {
-      printf("%d\n", 1);
+      WriteString(StandardOutput, "1\n");
+    }
+    else {
+      WriteString(StandardOutput, "0\n");
+    }
+
+    return NoError;
+  }
+}
+
+/**
+ * Liczba prób wykonywanych przez polecenie @p IS_EQ_FAST, jeśli nie podano
+ * jej w poleceniu. Prawdopodobieństwo błędnej odpowiedzi maleje wykładniczo
+ * wraz z liczbą prób.
+ */
+#define IS_EQ_FAST_DEFAULT_TRIALS 4
+
+/**
+ * Sprawdza probabilistycznie funkcją @p PolyProbablyEqProduct, czy wielomian
+ * z wierzchołka stosu jest równy iloczynowi @p polysNum wielomianów
+ * znajdujących się pod nim, nie wymnażając ich. Wypisuje @p 1, jeśli
+ * wielomiany są (z dużym prawdopodobieństwem) równe, a @p 0 w przeciwnym
+ * razie. Stos pozostaje bez zmian. Funkcja zakłada, że przekazany wskaźnik
+ * wskazuje na istniejący i poprawny stos wielomianów.
+ * @param[in] stack : stos wielomianów
+ * @param[in] polysNum : liczba czynników iloczynu
+ * @param[in] trials : liczba prób (dodatnia)
+ * @return @p StackUnderflow, jeśli przekazany stos nie zawiera co najmniej
+ * @p polysNum+1 wielomianów; @p NoError w przeciwnym razie
+ */
+static inline InputErr ExecuteIsEqFast(stack_t *stack, size_t polysNum,
+                                       unsigned trials) {
+  // Muszą być oba warunki, aby uniknąć overflow
+  if (StackIsEmpty(stack) || StackSize(stack) - 1 < polysNum) {
+    return StackUnderflow;
+  }
+  else {
+    // Wielomian z wierzchołka stosu i czynniki iloczynu
+    Poly *polys = malloc((polysNum + 1) * sizeof(Poly));
+
+    CHECK_PTR(polys);
+
+    for (size_t i = 0; i <= polysNum; i++) {
+      polys[i] = TakePoly(stack);
+    }
+
+    if (PolyProbablyEqProduct(&polys[0], polysNum, polys + 1, trials)) {
+      WriteString(StandardOutput, "1\n");
     }
     else {
-      printf("%d\n", 0);
+      WriteString(StandardOutput, "0\n");
+    }
+
+    for (size_t i = polysNum + 1; i > 0; i--) {
+      PushPoly(stack, polys[i - 1]);
     }
 
+    free(polys);
     return NoError;
   }
 }
@@ -309,7 +426,8 @@ static inline InputErr ExecuteDeg(stack_t *stack) {
   else {
     Poly p = ShowTop(stack);
     poly_exp_t polyDeg = PolyDeg(&p);
-    printf("%d\n", (int) polyDeg);
+    WriteLong(StandardOutput, polyDeg);
+    WriteChar(StandardOutput, '\n');
     return NoError;
   }
 }
@@ -333,7 +451,8 @@ static inline InputErr ExecuteDegBy(stack_t *stack, size_t idx) {
   else {
     Poly p = ShowTop(stack);
     poly_exp_t polyDeg = PolyDegBy(&p, idx);
-    printf("%d\n", (int) polyDeg);
+    WriteLong(StandardOutput, polyDeg);
+    WriteChar(StandardOutput, '\n');
     return NoError;
   }
 }
@@ -363,6 +482,79 @@ static inline InputErr ExecuteAt(stack_t *stack, poly_coeff_t x) {
   }
 }
 
+/**
+ * Ściąga wielomian z wierzchołka przekazanego stosu wielomianów, podnosi go
+ * do danej potęgi funkcją @p PolyPow i wynik wstawia na stos. Zwraca
+ * następnie @p NoError. Oryginalny wielomian jest usuwany z pamięci.
+ * Jeśli jednak przekazany stos jest pusty, funkcja nie robi nic i zwraca
+ * @p StackUnderflow. Funkcja zakłada, że wskaźnik na stos wielomianów
+ * wskazuje na istniejący i poprawny stos.
+ * @param[in] stack : stos wielomianów
+ * @param[in] exp : wykładnik potęgi
+ * @return @p StackUnderflow, jeśli przekazany stos jest pusty;
+ * w przeciwnym razie @p NoError
+ */
+static inline InputErr ExecutePow(stack_t *stack, poly_exp_t exp) {
+  if (StackIsEmpty(stack)) {
+    return StackUnderflow;
+  }
+  else {
+    Poly p = TakePoly(stack);
+    Poly newPoly = PolyPow(&p, exp);
+    PolyDestroy(&p);
+    PushPoly(stack, newPoly);
+    return NoError;
+  }
+}
+
+/**
+ * Ściąga z przekazanego stosu wielomianów dwa wielomiany i dodaje do niego
+ * ich iloczyn obcięty do stopnia @p deg względem zmiennej @f$x_0@f$,
+ * obliczony funkcją @p PolyMulTrunc. Wykorzystane wielomiany są następnie
+ * usuwane z pamięci. Jeżeli na stosie nie ma dwóch wielomianów, funkcja
+ * nie robi nic i zwraca @p StackUnderflow.
+ * @param[in] stack : stos wielomianów
+ * @param[in] deg : ograniczenie stopnia
+ * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
+ * dwóch wielomianów; @p NoError w przeciwnym przypadku
+ */
+static inline InputErr ExecuteMulTrunc(stack_t *stack, poly_exp_t deg) {
+  if (StackSize(stack) < 2) {
+    return StackUnderflow;
+  }
+  else {
+    Poly p1 = TakePoly(stack);
+    Poly p2 = TakePoly(stack);
+    PushPoly(stack, PolyMulTrunc(&p1, &p2, 0, deg));
+    PolyDestroy(&p1);
+    PolyDestroy(&p2);
+    return NoError;
+  }
+}
+
+/**
+ * Zastępuje wielomian z wierzchołka przekazanego stosu wielomianów
+ * wielomianem obciętym do stopnia @p deg względem zmiennej @f$x_0@f$
+ * za pomocą funkcji @p PolyTrunc. Jeśli stos jest pusty, funkcja nie robi
+ * nic i zwraca @p StackUnderflow.
+ * @param[in] stack : stos wielomianów
+ * @param[in] deg : ograniczenie stopnia
+ * @return @p StackUnderflow, jeśli przekazany stos jest pusty;
+ * w przeciwnym razie @p NoError
+ */
+static inline InputErr ExecuteTrunc(stack_t *stack, poly_exp_t deg) {
+  if (StackIsEmpty(stack)) {
+    return StackUnderflow;
+  }
+  else {
+    Poly p = TakePoly(stack);
+    Poly newPoly = PolyTrunc(&p, 0, deg);
+    PolyDestroy(&p);
+    PushPoly(stack, newPoly);
+    return NoError;
+  }
+}
+
 /**
  * Wyświeta przekazany wielomian. Funkcja zakłada, że przekazany wskaźnik
  * wskazuje na istniejący i poprawny wielomian.
@@ -371,19 +563,21 @@ static inline InputErr ExecuteAt(stack_t *stack, poly_coeff_t x) {
 static inline void AuxPrintPoly(Poly *p) {
   // Jeśli wielomian jest stały, wyświetla jego wartość
   if (PolyIsCoeff(p)) {
-    printf("%ld", p->coeff);
+    WriteLong(StandardOutput, p->coeff);
   }
   else {
     // Jeśli wielomian nie jest stały, wypisuje go w postaci jednomianów
     for (size_t i = 0; i < p->size; i++) {
-      printf("(");
+      WriteChar(StandardOutput, '(');
       // Wyświetla wielomian w obecnie rozważanym jednomianie
       AuxPrintPoly(&p->arr[i].p);
       // Wyświetla wykładnik jednomianu
-      printf(",%d)", MonoGetExp(&p->arr[i]));
+      WriteChar(StandardOutput, ',');
+      WriteLong(StandardOutput, MonoGetExp(&p->arr[i]));
+      WriteChar(StandardOutput, ')');
 
       if (i + 1 < p->size) {
-        printf("+");
+        WriteChar(StandardOutput, '+');
       }
     }
   }
@@ -392,14 +586,24 @@ static inline void AuxPrintPoly(Poly *p) {
 /**
  * Wyświetla w linii przekazany wielomian i zwraca @p NoError. Funkcja
  * zakłada, że przekazany wskaźnik wskazuje na istniejący i poprawny wielomian.
+ * Współczynniki zamrożonego wielomianu są zapisane w obrazie jako
+ * przesunięcia, więc wyświetlana jest jego kopia.
  * @param[in] p : wielomian do wyświetlenia
  * @return @p NoError
  */
 static inline InputErr PrintPoly(Poly *p) {
   // Wyświetla wielomian
-  AuxPrintPoly(p);
+  if (PolyIsFrozen(p)) {
+    Poly copy = PolyClone(p);
+
+    AuxPrintPoly(&copy);
+    PolyDestroy(&copy);
+  }
+  else {
+    AuxPrintPoly(p);
+  }
   // Przechodzi do nowej linii
-  printf("\n");
+  WriteChar(StandardOutput, '\n');
   return NoError;
 }
 
@@ -492,6 +696,147 @@ static inline InputErr ExecuteCompose(stack_t *stack, size_t polysNum) {
   }
 }
 
+/**
+ * Ściąga z przekazanego stosu wielomianów @p polysNum wielomianów
+ * i dodaje do niego ich sumę, obliczoną jednym scaleniem funkcją
+ * @p PolySumMany. Wykorzystane wielomiany są następnie usuwane z pamięci.
+ * Jeżeli na stosie nie ma wystarczającej liczby wielomianów, funkcja
+ * nie robi nic i zwraca @p StackUnderflow.
+ * @param[in] stack : stos wielomianów
+ * @param[in] polysNum : liczba sumowanych wielomianów
+ * @return @p StackUnderflow w przypadku, gdy stos nie zawiera co najmniej
+ * @p polysNum wielomianów; @p NoError w przeciwnym przypadku
+ */
+static inline InputErr ExecuteAddN(stack_t *stack, size_t polysNum) {
+  if (StackSize(stack) < polysNum) {
+    return StackUnderflow;
+  }
+  else if (polysNum == 0) {
+    PushPoly(stack, PolyZero());
+    return NoError;
+  }
+  else {
+    // Tablica sumowanych wielomianów
+    Poly *polys = malloc(polysNum * sizeof(Poly));
+
+    CHECK_PTR(polys);
+
+    for (size_t i = 0; i < polysNum; i++) {
+      polys[i] = TakePoly(stack);
+    }
+
+    Poly result = PolySumMany(polysNum, polys);
+
+    for (size_t i = 0; i < polysNum; i++) {
+      PolyDestroy(&polys[i]);
+    }
+
+    free(polys);
+    PushPoly(stack, result);
+    return NoError;
+  }
+}
+
+/**
+ * Zapisuje wielomian z wierzchołka przekazanego stosu wielomianów do pliku
+ * w postaci binarnej (funkcją @p PolySerialize) i zwraca @p NoError.
+ * Wielomian pozostaje na stosie. Jeśli stos jest pusty, funkcja nie robi nic
+ * i zwraca @p StackUnderflow; jeśli pliku nie udało się zapisać -- zwraca
+ * @p NoSaveParam.
+ * @param[in] stack : stos wielomianów
+ * @param[in] path : ścieżka pliku
+ * @return @p StackUnderflow, jeśli przekazany stos jest pusty;
+ * @p NoSaveParam w przypadku błędu zapisu; w przeciwnym razie @p NoError
+ */
+static inline InputErr ExecuteSave(stack_t *stack, const char *path) {
+  if (StackIsEmpty(stack)) {
+    return StackUnderflow;
+  }
+
+  Poly p = ShowTop(stack);
+  // Zapis binarny wielomianu
+  size_t size;
+  uint8_t *data = PolySerialize(&p, &size);
+  FILE *file = fopen(path, "wb");
+  bool written = false;
+
+  if (file != NULL) {
+    written = fwrite(data, 1, size, file) == size;
+    // Błąd może zostać zgłoszony dopiero przy zamknięciu pliku
+    written = fclose(file) == 0 && written;
+  }
+
+  free(data);
+  return written ? NoError : NoSaveParam;
+}
+
+/**
+ * Zapisuje zamrożony obraz wielomianu z wierzchołka przekazanego stosu
+ * wielomianów do pliku (funkcją @p PolyFreeze) i zwraca @p NoError.
+ * Wielomian pozostaje na stosie. Jeśli stos jest pusty, funkcja nie robi nic
+ * i zwraca @p StackUnderflow; jeśli pliku nie udało się zapisać -- zwraca
+ * @p NoFreezeParam.
+ * @param[in] stack : stos wielomianów
+ * @param[in] path : ścieżka pliku
+ * @return @p StackUnderflow, jeśli przekazany stos jest pusty;
+ * @p NoFreezeParam w przypadku błędu zapisu; w przeciwnym razie @p NoError
+ */
+static inline InputErr ExecuteFreeze(stack_t *stack, const char *path) {
+  if (StackIsEmpty(stack)) {
+    return StackUnderflow;
+  }
+
+  Poly p = ShowTop(stack);
+
+  return PolyFreeze(&p, path) ? NoError : NoFreezeParam;
+}
+
+/**
+ * Odczytuje wielomian z pliku zapisanego poleceniem @p SAVE lub @p FREEZE
+ * i dodaje go na przekazany stos wielomianów. Zamrożony obraz jest
+ * odwzorowywany w pamięci funkcją @p PolyLoadFrozen i trafia na stos bez
+ * kopiowania. W przeciwnym razie plik jest odwzorowywany w pamięci,
+ * a wielomian odczytywany wprost z odwzorowania funkcją @p PolyDeserialize.
+ * Jeśli pliku nie udało się odczytać lub nie zawiera on dokładnie jednego
+ * poprawnego zapisu wielomianu, funkcja nie robi nic i zwraca
+ * @p NoLoadParam.
+ * @param[in] stack : stos wielomianów
+ * @param[in] path : ścieżka pliku
+ * @return @p NoLoadParam w przypadku błędu odczytu; w przeciwnym razie
+ * @p NoError
+ */
+static inline InputErr ExecuteLoad(stack_t *stack, const char *path) {
+  Poly p;
+
+  // Zamrożony obraz
+  if (PolyLoadFrozen(path, &p)) {
+    PushPoly(stack, p);
+    return NoError;
+  }
+
+  MappedFile file;
+
+  if (!MapFile(path, &file)) {
+    return NoLoadParam;
+  }
+
+  const size_t size = PolyDeserialize((const uint8_t *) file.data,
+                                      file.size, &p);
+
+  UnmapFile(&file);
+
+  if (size == 0 || size != file.size) {
+    if (size != 0) {
+      PolyDestroy(&p);
+    }
+
+    return NoLoadParam;
+  }
+
+  PushPoly(stack, p);
+  return NoError;
+}
+
 
 //////////////////////////////////////////
 //                                      //
@@ -518,52 +863,65 @@ typedef enum {
   DEG_BY,
   AT,
   COMPOSE,
+  IS_EQ_FAST,
+  FMA,
+  POW,
+  MUL_TRUNC,
+  TRUNC,
+  ADD_N,
+  SAVE,
+  LOAD,
+  FREEZE,
   INVALID_COMMAND
 } CommandType;
 
-/** To jest struktura reprezentująca polecenie nie przyjmujące argumentu */
+/** To jest struktura reprezentująca polecenie kalkulatora */
 typedef struct {
-  const CommandType type; ///< typ polecenia
   const char *name; ///< ciąg znaków odpowiadający poleceniu
-} NonParamCommand;
-
-/** Liczba poleceń nie przyjmujących żadnych argumentów */
-#define NUM_OF_NON_PARAM_COMMANDS 12
-
-/** To jest tablica zawierająca charakteryzacje poleceń, które
-    nie przyjmują argumentów */
-static const NonParamCommand NonParamCommands[NUM_OF_NON_PARAM_COMMANDS] = {
-  { .type = ZERO,      .name = "ZERO"     },
-  { .type = IS_COEFF,  .name = "IS_COEFF" },
-  { .type = IS_ZERO,   .name = "IS_ZERO"  },
-  { .type = CLONE,     .name = "CLONE"    },
-  { .type = ADD,       .name = "ADD"      },
-  { .type = MUL,       .name = "MUL"      },
-  { .type = NEG,       .name = "NEG"      },
-  { .type = SUB,       .name = "SUB"      },
-  { .type = IS_EQ,     .name = "IS_EQ"    },
-  { .type = DEG,       .name = "DEG"      },
-  { .type = PRINT,     .name = "PRINT"    },
-  { .type = POP,       .name = "POP"      }
-};
+  const size_t nameLength; ///< długość nazwy polecenia
+  const bool hasParam; ///< czy polecenie przyjmuje argument
+} Command;
 
-/** To jest struktura reprezentująca polecenie przyjmujące
-    co najmniej jeden argument */
-typedef struct {
-  const CommandType type; ///< typ polecenia
-  const char *name; ///< ciąg znaków odpowiadający poleceniu
-  const int nameLength; ///< długość nazwy polecenia
-} ParamCommand;
-
-/** Liczba poleceń przyjmujących co najmniej jeden parametr */
-#define NUM_OF_PARAM_COMMANDS 3
-
-/** To jest tablica zawierająca charakteryzacje poleceń, które
-    przyjmują co najmniej jeden argument */
-static const ParamCommand ParamCommands[NUM_OF_PARAM_COMMANDS] = {
-  { .type = DEG_BY,  .name = "DEG_BY",  .nameLength = 6 },
-  { .type = AT,      .name = "AT",      .nameLength = 2 },
-  { .type = COMPOSE, .name = "COMPOSE", .nameLength = 7 }
+/** Liczba poleceń -- typów poleceń poza @p INVALID_COMMAND */
+#define NUM_OF_COMMANDS INVALID_COMMAND
+
+/**
+ * Charakteryzacja polecenia o nazwie @p text.
+ * @param[in] text : nazwa polecenia -- literał znakowy
+ * @param[in] param : czy polecenie przyjmuje argument
+ */
+#define COMMAND(text, param) \
+  { .name = text, .nameLength = sizeof(text) - 1, .hasParam = param }
+
+/** To jest tablica zawierająca charakteryzacje poleceń, indeksowana ich
+    typami. Nazwy poleceń składają się z wielkich liter i znaków '_'.
+    Tablica z haszowaniem, w której wyszukiwane są polecenia, jest budowana
+    na jej podstawie -- nowe polecenie wystarczy do niej dopisać */
+static const Command Commands[NUM_OF_COMMANDS] = {
+  [ZERO]       = COMMAND("ZERO",       false),
+  [IS_COEFF]   = COMMAND("IS_COEFF",   false),
+  [IS_ZERO]    = COMMAND("IS_ZERO",    false),
+  [CLONE]      = COMMAND("CLONE",      false),
+  [ADD]        = COMMAND("ADD",        false),
+  [MUL]        = COMMAND("MUL",        false),
+  [NEG]        = COMMAND("NEG",        false),
+  [SUB]        = COMMAND("SUB",        false),
+  [IS_EQ]      = COMMAND("IS_EQ",      false),
+  [DEG]        = COMMAND("DEG",        false),
+  [PRINT]      = COMMAND("PRINT",      false),
+  [POP]        = COMMAND("POP",        false),
+  [DEG_BY]     = COMMAND("DEG_BY",     true),
+  [AT]         = COMMAND("AT",         true),
+  [COMPOSE]    = COMMAND("COMPOSE",    true),
+  [IS_EQ_FAST] = COMMAND("IS_EQ_FAST", true),
+  [FMA]        = COMMAND("FMA",        false),
+  [POW]        = COMMAND("POW",        true),
+  [MUL_TRUNC]  = COMMAND("MUL_TRUNC",  true),
+  [TRUNC]      = COMMAND("TRUNC",      true),
+  [ADD_N]      = COMMAND("ADD_N",      true),
+  [SAVE]       = COMMAND("SAVE",       true),
+  [LOAD]       = COMMAND("LOAD",       true),
+  [FREEZE]     = COMMAND("FREEZE",     true)
 };
 
 
@@ -574,76 +932,138 @@ static const ParamCommand ParamCommands[NUM_OF_PARAM_COMMANDS] = {
 //////////////////////////////////////////
 
 
+/** Liczba bitów indeksu tablicy z haszowaniem nazw poleceń */
+#define COMMAND_TABLE_BITS 6
+
+/** Rozmiar tablicy z haszowaniem nazw poleceń */
+#define COMMAND_TABLE_SIZE (1 << COMMAND_TABLE_BITS)
+
+/** Maksymalna długość nazwy polecenia */
+#define MAX_COMMAND_NAME_LENGTH 16
+
+/** Nieparzysty mnożnik funkcji haszującej, przy którym nazwy wszystkich
+    poleceń trafiają pod różne indeksy tablicy; po zmianie listy poleceń
+    może być konieczne dobranie nowego */
+#define COMMAND_HASH_MULTIPLIER 0x676C4999u
+
+/** Tablica z haszowaniem nazw poleceń: pod indeksem wyznaczonym przez
+    skrót nazwy znajduje się typ polecenia, a miejsca nieprzypisane żadnemu
+    poleceniu zawierają @p INVALID_COMMAND */
+static CommandType CommandTable[COMMAND_TABLE_SIZE];
+
+/** Czy tablica z haszowaniem nazw poleceń została zbudowana */
+static bool commandTableBuilt = false;
+
 /**
- * Porównuje string z poleceniem o indeksie @p commandNumber w tablicy
- * poleceń przyjmujących argument. Jeśli string nie pasuje do porównywanego
- * polecenia, zwraca @p false. W przeciwnym razie zwraca @p true.
- * @param[in] line : string reprezentujący polecenie
- * @param[in] commandNumber : indeks porównywanego polecenia z tablicy
- * poleceń przyjmujących argument
- * @return Jeśli string nie odpowiada danemu poleceniu, zwraca @p false;
- * W przeciwnym razie zwraca @p true.
+ * Sprawdza, czy znak może być częścią nazwy polecenia.
+ * @param[in] c : znak
+ * @return @p true, jeśli znak jest wielką literą lub znakiem @p '_';
+ * @p false w przeciwnym razie
  */
-static inline bool IsParamCommand(string_t *line, const int commandNumber) {
-  const size_t commandLength = ParamCommands[commandNumber].nameLength;
-  // Jeśli string jest krótszy od nazwy polecenia, nie może go reprezentować
-  if (StringLength(line) < commandLength) {
-    return false;
-  }
+static inline bool IsCommandNameChar(const char c) {
+  return isupper((unsigned char) c) || c == '_';
+}
 
-  // Porównanie znaków, z których składają się string i dane polecenie
-  for (size_t i = 0; i < commandLength; i++) {
-    if (CharAt(line, i) != ParamCommands[commandNumber].name[i]) {
-      return false;
-    }
-  }
+/**
+ * Wyznacza indeks nazwy w tablicy z haszowaniem nazw poleceń: skrót
+ * wszystkich znaków nazwy jest mnożony przez mnożnik, a indeksem są
+ * najstarsze bity iloczynu.
+ * @param[in] name : nazwa
+ * @param[in] length : długość nazwy
+ * @param[in] multiplier : nieparzysty mnożnik
+ * @return indeks w tablicy z haszowaniem
+ */
+static inline size_t CommandSlot(const char *name, const size_t length,
+                                 const uint32_t multiplier) {
+  uint32_t key = (uint32_t) length;
 
-  // Niepoprawna nazwa polecenia (aby uniknąć pomyłki, gdyby występowałby
-  // dwa polecenia z parametrem, wśród których nazwa jednego jest początkiem
-  // drugiego, np. "POLECENIE" oraz "POLECENIEE")
-  if (StringLength(line) == commandLength + 1
-      && isalpha(CharAt(line, commandLength))) {
-      return false;
+  for (size_t i = 0; i < length; i++) {
+    key = key * 31 + (unsigned char) name[i];
   }
 
-  // String może przedstawiać dane polecenie
-  return true;
+  return (key * multiplier) >> (32 - COMMAND_TABLE_BITS);
 }
 
 /**
- * Sprawdza, czy polecenie jest operacją przyjmującą argument
- * i zwraca jego typ.
- * @param[in] line : polecenie
- * @return Typ polecenia
+ * Buduje tablicę z haszowaniem nazw poleceń na podstawie tablicy
+ * @p Commands, z mnożnikiem @p COMMAND_HASH_MULTIPLIER. Nazwy wszystkich
+ * poleceń trafiają pod różne indeksy, więc każde polecenie jest wyszukiwane
+ * jednym porównaniem nazwy. Jest to sprawdzane przy każdym uruchomieniu
+ * programu: jeśli dwie nazwy kolidują (na przykład po dodaniu polecenia),
+ * funkcja wypisuje je na standardowe wyjście błędów i kończy działanie
+ * programu kodem @p 1.
  */
-static inline CommandType DefineParamCommand(string_t *line) {
-  // Porównanie polecenia z operacjami przyjmującymi argument
-  for (int i = 0; i < NUM_OF_PARAM_COMMANDS; i++) {
-    if (IsParamCommand(line, i)) {
-      return ParamCommands[i].type;
+static void BuildCommandTable(void) {
+  for (size_t i = 0; i < COMMAND_TABLE_SIZE; i++) {
+    CommandTable[i] = INVALID_COMMAND;
+  }
+
+  for (int type = 0; type < NUM_OF_COMMANDS; type++) {
+    assert(Commands[type].nameLength <= MAX_COMMAND_NAME_LENGTH);
+
+    const size_t slot = CommandSlot(Commands[type].name,
+                                    Commands[type].nameLength,
+                                    COMMAND_HASH_MULTIPLIER);
+
+    if (CommandTable[slot] != INVALID_COMMAND) {
+      WriteString(ErrorOutput, "command table: hash collision between ");
+      WriteString(ErrorOutput, Commands[CommandTable[slot]].name);
+      WriteString(ErrorOutput, " and ");
+      WriteString(ErrorOutput, Commands[type].name);
+      WriteString(ErrorOutput, "; choose another COMMAND_HASH_MULTIPLIER");
+      WriteChar(ErrorOutput, '\n');
+      exit(1);
     }
+
+    CommandTable[slot] = (CommandType) type;
   }
 
-  // Polecenie nie jest żadną z operacji przyjmujących argument
-  // -- jest niepoprawnym poleceniem
-  return INVALID_COMMAND;
+  commandTableBuilt = true;
 }
 
 /**
- * Określa typ polecenia i zwraca go.
- * @param[in] line : polecenie
+ * Określa typ polecenia i zwraca go. Nazwą polecenia jest najdłuższy
+ * początkowy ciąg wielkich liter i znaków @p '_' w linii. Polecenie
+ * nieprzyjmujące argumentu musi stanowić całą linię; za nazwą polecenia
+ * przyjmującego argument może znajdować się dowolny ciąg znaków -- jest on
+ * sprawdzany przy wykonywaniu polecenia.
+ * @param[in] line : niepusta linia
  * @return Typ polecenia
  */
 static inline CommandType DefineCommand(string_t *line) {
-  // Sprawdzenie, czy polecenie jest operacją bezargumentową
-  for (int i = 0; i < NUM_OF_NON_PARAM_COMMANDS; i++) {
-    if (CompareTo(line, NonParamCommands[i].name)) {
-      return NonParamCommands[i].type;
-    }
+  assert(commandTableBuilt);
+
+  const char *chars = GetCharArrayAt(line, 0);
+  const size_t lineLength = StringLength(line);
+  // Długość nazwy polecenia
+  size_t length = 0;
+
+  while (length < lineLength && length <= MAX_COMMAND_NAME_LENGTH &&
+         IsCommandNameChar(chars[length])) {
+    length++;
+  }
+
+  // Linia nie zaczyna się nazwą lub nazwa jest dłuższa od nazwy
+  // każdego polecenia
+  if (length == 0 || length > MAX_COMMAND_NAME_LENGTH) {
+    return INVALID_COMMAND;
+  }
+
+  const CommandType type =
+    CommandTable[CommandSlot(chars, length, COMMAND_HASH_MULTIPLIER)];
+
+  // Pod indeksem nie ma polecenia lub jest inne polecenie
+  if (type == INVALID_COMMAND || Commands[type].nameLength != length ||
+      memcmp(Commands[type].name, chars, length) != 0) {
+    return INVALID_COMMAND;
+  }
+
+  // Za nazwą polecenia bez argumentu nie może być innych znaków
+  if (!Commands[type].hasParam && length != lineLength) {
+    return INVALID_COMMAND;
   }
 
-  // Sprawdzenie, czy polecenie jest operacją przyjmującą argument
-  return DefineParamCommand(line);
+  return type;
 }
 
 
@@ -655,6 +1075,17 @@ static inline CommandType DefineCommand(string_t *line) {
 //////////////////////////////////////////
 
 
+/**
+ * Sprawdza, czy znak kończy linię. Linie wczytane do stringa kończą się
+ * znakiem @p '\\0', a linie czytane wprost z odwzorowanego w pamięci pliku
+ * -- znakiem nowej linii.
+ * @param[in] c : znak
+ * @return @p true, jeśli znak kończy linię; @p false w przeciwnym razie
+ */
+static inline bool IsLineEnd(const char c) {
+  return c == '\0' || c == '\n';
+}
+
 /**
  * Liczba niedozwolonych białych znaków pomiędzy
  * poleceniem a jego argumentem.
@@ -698,18 +1129,10 @@ static const char INVALID_WHITESPACE_CHARS[NUM_OF_INVALID_WHITESPACE_CHARS] = {
  */
 static inline InputErr InitialParamCommCheck(string_t *line, char **arrayPtr,
                                              const CommandType commType) {
-  // Indeks polecenia w tablicy sparametryzowanych poleceń
-  // odpowiadający `commType`
-  int commandID;
-  for (int i = 0; i < NUM_OF_PARAM_COMMANDS; i++) {
-    if (commType == ParamCommands[i].type) {
-      commandID = i;
-      break;
-    }
-  }
+  assert(Commands[commType].hasParam);
 
   // Długość nazwy polecenia
-  const size_t commandLen = ParamCommands[commandID].nameLength;
+  const size_t commandLen = Commands[commType].nameLength;
 
   // Jeśli polecenie jest tej samej długości co jego nazwa,
   // to nie ma parametru -- błąd
@@ -781,11 +1204,14 @@ static inline InputErr RunDegBy(stack_t *stack, string_t *line) {
   // Pomocniczy wskaźnik
   char *ptr = NULL;
 
+  // Funkcje `strto*` nie zerują `errno` -- błąd zakresu z poprzedniej
+  // linii nie może wpłynąć na wynik
+  errno = 0;
   // Konwertowanie argumentu polecenia na liczbę typu size_t
   size_t num = strtoul(arg, &ptr, 10);
   // Argument poza akceptowalnym zakresem lub niedozwolone znaki w argumencie
   // -- błąd
-  if (errno == ERANGE || *ptr != '\0') {
+  if (errno == ERANGE || !IsLineEnd(*ptr)) {
     return NoDegByParam;
   }
   // Poprawny argument. Wykonanie operacji
@@ -845,11 +1271,14 @@ static inline InputErr RunAt(stack_t *stack, string_t *line) {
   // Pomocniczy wskaźnik
   char *ptr = NULL;
 
+  // Funkcje `strto*` nie zerują `errno` -- błąd zakresu z poprzedniej
+  // linii nie może wpłynąć na wynik
+  errno = 0;
   // Konwertowanie argumentu na liczbę typu long (poly_coeff_t)
   long num = strtol(arg, &ptr, 10);
   // Argument poza akceptowalnym zakresem lub niedozwolone znaki w argumencie
   // -- błąd
-  if (errno == ERANGE || *ptr != '\0') {
+  if (errno == ERANGE || !IsLineEnd(*ptr)) {
     return NoAtParam;
   }
   else {
@@ -868,65 +1297,417 @@ static inline InputErr RunAt(stack_t *stack, string_t *line) {
 }
 
 /**
- * Wykonuje polecenie @p COMPOSE -- zastępuje wielomian z wierzchołka
- * przekazanego stosu jego złożeniem z innymi ze stosu i zwraca @p NoError.
- * W przypadku napotkania błędu funkcja nie robi nic i zwraca komunikat
- * o błędzie: @p NoComposeParam -- w przypadku błędu związanego z parametrem
- * operacji, @p InvalidCommandName -- w przypadku błędu związanego z nazwą
- * polecenia. Funkcja zakłada, że przekazane wskaźniki na stos wielomianów
- * i string wskazują na istniejące i poprawne struktury danych.
- * @param[in] stack : stos wielomianów
+ * Odczytuje argument polecenia będący liczbą z zakresu typu @p size_t.
+ * @param[in] arg : pierwszy znak argumentu
+ * @param[out] end : pierwszy znak za argumentem
+ * @param[out] num : odczytany argument
+ * @return czy argument jest liczbą nieujemną z zakresu typu @p size_t
+ */
+static inline bool ReadSizeArg(char *arg, char **end, size_t *num) {
+  // Argument musi być liczbą nieujemną
+  if (!isdigit(arg[0])) {
+    return false;
+  }
+
+  // Funkcje `strto*` nie zerują `errno` -- błąd zakresu z poprzedniej
+  // linii nie może wpłynąć na wynik
+  errno = 0;
+  // Konwertowanie argumentu polecenia na liczbę typu size_t
+  *num = strtoul(arg, end, 10);
+
+  return errno != ERANGE;
+}
+
+/**
+ * Sprawdza polecenie, którego parametrem jest liczba wielomianów (liczba
+ * z zakresu typu @p size_t), i odczytuje ten parametr. Jeśli polecenie
+ * przyjmuje drugi, opcjonalny parametr tego samego rodzaju, oddzielony
+ * spacją, to odczytuje także jego. Funkcja zakłada, że przekazane wskaźniki
+ * wskazują na istniejące i poprawne struktury danych.
  * @param[in] line : polecenie
- * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
- * polecenia -- @p NoComposeParam; w przypadku nieprawidłowej nazwy polecenia
+ * @param[in] commType : typ polecenia
+ * @param[out] num : odczytany parametr
+ * @param[out] opt : odczytany opcjonalny parametr (pozostaje bez zmian, jeśli
+ * go nie podano) lub @p NULL, jeśli polecenie go nie przyjmuje
+ * @return W przypadku sukcesu -- @p NoError; w przypadku braku lub błędu
+ * parametru -- @p NoParam; w przypadku nieprawidłowej nazwy polecenia
  * -- @p InvalidCommandName
  */
-static inline InputErr RunCompose(stack_t *stack, string_t *line) {
+static inline InputErr GetSizeParam(string_t *line, const CommandType commType,
+                                    size_t *num, size_t *opt) {
   // Wskaźnik na pierwszy znak odpowiadający argumentowi polecenia
   char *arg = NULL;
   // Wstępnie sprawdzenie poprawności polecenia
-  switch (InitialParamCommCheck(line, &arg, COMPOSE)) {
-    // Błąd związany z argumentem polecenia
-    case NoParam:
-      return NoComposeParam;
-    // Błąd związany z poleceniem
-    case InvalidCommandName:
-      return InvalidCommandName;
-    // Sukces -- funkcja przechodzi do sprawdzenia argumentu
-    case NoError:
-      break;
-    // Błąd funkcji `InitialParamCommCheck`
+  InputErr error = InitialParamCommCheck(line, &arg, commType);
+
+  if (error != NoError) {
+    return error;
+  }
+
+  // Pomocniczy wskaźnik
+  char *ptr = NULL;
+
+  if (!ReadSizeArg(arg, &ptr, num)) {
+    return NoParam;
+  }
+
+  // Opcjonalny drugi parametr
+  if (opt != NULL && *ptr == ' ' && !ReadSizeArg(ptr + 1, &ptr, opt)) {
+    return NoParam;
+  }
+
+  // Wskaźnik na początek polecenia
+  char *lineStart = GetCharArrayAt(line, 0);
+
+  // Niedozwolone znaki w argumencie -- błąd
+  if (!IsLineEnd(*ptr) ||
+      (ptr - lineStart) / sizeof(char) < StringLength(line)) {
+    return NoParam;
+  }
+
+  return NoError;
+}
+
+/**
+ * Wykonuje polecenie @p COMPOSE -- zastępuje wielomian z wierzchołka
+ * przekazanego stosu jego złożeniem z innymi ze stosu i zwraca @p NoError.
+ * W przypadku napotkania błędu funkcja nie robi nic i zwraca komunikat
+ * o błędzie: @p NoComposeParam -- w przypadku błędu związanego z parametrem
+ * operacji, @p InvalidCommandName -- w przypadku błędu związanego z nazwą
+ * polecenia. Funkcja zakłada, że przekazane wskaźniki na stos wielomianów
+ * i string wskazują na istniejące i poprawne struktury danych.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoComposeParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunCompose(stack_t *stack, string_t *line) {
+  size_t num;
+
+  switch (GetSizeParam(line, COMPOSE, &num, NULL)) {
+    case NoParam:
+      return NoComposeParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
     default:
-      assert(false);
+      return ExecuteCompose(stack, num);
+  }
+}
+
+/**
+ * Wykonuje polecenie @p IS_EQ_FAST -- sprawdza, czy wielomian z wierzchołka
+ * przekazanego stosu jest równy iloczynowi @p k wielomianów znajdujących się
+ * pod nim, w podanej po @p k liczbie prób (domyślnie
+ * @p IS_EQ_FAST_DEFAULT_TRIALS), i zwraca @p NoError. W przypadku napotkania
+ * błędu funkcja nie robi nic i zwraca komunikat o błędzie: @p NoIsEqFastParam
+ * -- w przypadku błędu związanego z parametrem operacji (także zerowej lub
+ * zbyt dużej liczby prób), @p InvalidCommandName -- w przypadku błędu
+ * związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoIsEqFastParam; w przypadku nieprawidłowej nazwy
+ * polecenia -- @p InvalidCommandName
+ */
+static inline InputErr RunIsEqFast(stack_t *stack, string_t *line) {
+  size_t num;
+  size_t trials = IS_EQ_FAST_DEFAULT_TRIALS;
+
+  switch (GetSizeParam(line, IS_EQ_FAST, &num, &trials)) {
+    case NoParam:
+      return NoIsEqFastParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default:
+      // Liczba prób musi być dodatnia i mieścić się w typie unsigned
+      if (trials == 0 || trials > UINT_MAX) {
+        return NoIsEqFastParam;
+      }
+
+      return ExecuteIsEqFast(stack, num, (unsigned) trials);
+  }
+}
+
+/**
+ * Wykonuje polecenie @p ADD_N -- zastępuje @p n wielomianów z wierzchołka
+ * przekazanego stosu ich sumą i zwraca @p NoError. W przypadku napotkania
+ * błędu funkcja nie robi nic i zwraca komunikat o błędzie: @p NoAddNParam
+ * -- w przypadku błędu związanego z parametrem operacji,
+ * @p InvalidCommandName -- w przypadku błędu związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoAddNParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunAddN(stack_t *stack, string_t *line) {
+  size_t num;
+
+  switch (GetSizeParam(line, ADD_N, &num, NULL)) {
+    case NoParam:
+      return NoAddNParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default:
+      return ExecuteAddN(stack, num);
+  }
+}
+
+/**
+ * Sprawdza polecenie, którego parametrem jest wykładnik (liczba z zakresu
+ * typu @p poly_exp_t), i odczytuje ten parametr. Funkcja zakłada, że
+ * przekazane wskaźniki wskazują na istniejące i poprawne struktury danych.
+ * @param[in] line : polecenie
+ * @param[in] commType : typ polecenia
+ * @param[out] exp : odczytany parametr
+ * @return W przypadku sukcesu -- @p NoError; w przypadku braku lub błędu
+ * parametru -- @p NoParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr GetExpParam(string_t *line, const CommandType commType,
+                                   poly_exp_t *exp) {
+  // Wskaźnik na pierwszy znak odpowiadający argumentowi polecenia
+  char *arg = NULL;
+  // Wstępnie sprawdzenie poprawności polecenia
+  InputErr error = InitialParamCommCheck(line, &arg, commType);
+
+  if (error != NoError) {
+    return error;
   }
 
   // Argument musi być liczbą nieujemną
   if (!isdigit(arg[0])) {
-    return NoComposeParam;
+    return NoParam;
   }
 
   // Pomocniczy wskaźnik
   char *ptr = NULL;
 
-  // Konwertowanie argumentu polecenia na liczbę typu size_t
-  size_t num = strtoul(arg, &ptr, 10);
-  // Argument poza akceptowalnym zakresem lub niedozwolone znaki w argumencie
-  // -- błąd
-  if (errno == ERANGE || *ptr != '\0') {
-    return NoComposeParam;
+  // Funkcje `strto*` nie zerują `errno` -- błąd zakresu z poprzedniej
+  // linii nie może wpłynąć na wynik
+  errno = 0;
+  // Konwertowanie argumentu polecenia na liczbę typu unsigned long
+  unsigned long num = strtoul(arg, &ptr, 10);
+  // Wskaźnik na początek polecenia
+  char *lineStart = GetCharArrayAt(line, 0);
+
+  // Argument poza zakresem typu poly_exp_t lub niedozwolone znaki
+  // w argumencie -- błąd
+  if (errno == ERANGE || num > INT_MAX || !IsLineEnd(*ptr) ||
+      (ptr - lineStart) / sizeof(char) < StringLength(line)) {
+    return NoParam;
   }
-  // Poprawny argument. Wykonanie operacji
-  else {
-    // Wskaźnik na początek polecenia
-    char *lineStart = GetCharArrayAt(line, 0);
-    // W argumencie znajdują się nieprzejrzane znaki -- a więc
-    // argument zawiera niedozwolone znaki
-    if ((ptr - lineStart) / sizeof(char) < StringLength(line)) {
-      return NoComposeParam;
+
+  *exp = (poly_exp_t) num;
+
+  return NoError;
+}
+
+/**
+ * Wykonuje polecenie @p POW -- zastępuje wielomian z wierzchołka
+ * przekazanego stosu jego potęgą o danym wykładniku i zwraca @p NoError.
+ * W przypadku napotkania błędu funkcja nie robi nic i zwraca komunikat
+ * o błędzie: @p NoPowParam -- w przypadku błędu związanego z parametrem
+ * operacji, @p InvalidCommandName -- w przypadku błędu związanego z nazwą
+ * polecenia. Funkcja zakłada, że przekazane wskaźniki na stos wielomianów
+ * i string wskazują na istniejące i poprawne struktury danych.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoPowParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunPow(stack_t *stack, string_t *line) {
+  poly_exp_t exp;
+
+  switch (GetExpParam(line, POW, &exp)) {
+    case NoParam:
+      return NoPowParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default:
+      return ExecutePow(stack, exp);
+  }
+}
+
+/**
+ * Wykonuje polecenie @p MUL_TRUNC -- zastępuje dwa wielomiany z wierzchołka
+ * przekazanego stosu ich iloczynem obciętym do danego stopnia względem
+ * zmiennej @f$x_0@f$ i zwraca @p NoError. W przypadku napotkania błędu
+ * funkcja nie robi nic i zwraca komunikat o błędzie: @p NoMulTruncParam --
+ * w przypadku błędu związanego z parametrem operacji, @p InvalidCommandName
+ * -- w przypadku błędu związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoMulTruncParam; w przypadku nieprawidłowej nazwy
+ * polecenia -- @p InvalidCommandName
+ */
+static inline InputErr RunMulTrunc(stack_t *stack, string_t *line) {
+  poly_exp_t deg;
+
+  switch (GetExpParam(line, MUL_TRUNC, &deg)) {
+    case NoParam:
+      return NoMulTruncParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default:
+      return ExecuteMulTrunc(stack, deg);
+  }
+}
+
+/**
+ * Wykonuje polecenie @p TRUNC -- usuwa z wielomianu z wierzchołka
+ * przekazanego stosu wyrazy stopnia większego od danego względem zmiennej
+ * @f$x_0@f$ i zwraca @p NoError. W przypadku napotkania błędu funkcja
+ * nie robi nic i zwraca komunikat o błędzie: @p NoTruncParam -- w przypadku
+ * błędu związanego z parametrem operacji, @p InvalidCommandName --
+ * w przypadku błędu związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia -- @p NoTruncParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunTrunc(stack_t *stack, string_t *line) {
+  poly_exp_t deg;
+
+  switch (GetExpParam(line, TRUNC, &deg)) {
+    case NoParam:
+      return NoTruncParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default:
+      return ExecuteTrunc(stack, deg);
+  }
+}
+
+/**
+ * Sprawdza polecenie, którego parametrem jest ścieżka pliku -- wszystkie
+ * znaki za spacją oddzielającą ją od nazwy polecenia -- i kopiuje ją
+ * do nowo zaalokowanego ciągu znaków zakończonego znakiem @p '\\0'.
+ * Funkcja zakłada, że przekazane wskaźniki wskazują na istniejące
+ * i poprawne struktury danych.
+ * @param[in] line : polecenie
+ * @param[in] commType : typ polecenia
+ * @param[out] path : kopia ścieżki, którą należy zwolnić funkcją @p free
+ * @return W przypadku sukcesu -- @p NoError; w przypadku braku lub błędu
+ * parametru -- @p NoParam; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr GetPathParam(string_t *line, const CommandType commType,
+                                    char **path) {
+  // Wskaźnik na pierwszy znak odpowiadający argumentowi polecenia
+  char *arg = NULL;
+  // Wstępnie sprawdzenie poprawności polecenia
+  InputErr error = InitialParamCommCheck(line, &arg, commType);
+
+  if (error != NoError) {
+    return error;
+  }
+
+  // Długość ścieżki -- linia nie musi kończyć się znakiem '\0'
+  const size_t length = StringLength(line) -
+                        (size_t) (arg - GetCharArrayAt(line, 0));
+
+  // Ścieżka nie może zawierać znaku '\0'
+  if (memchr(arg, '\0', length) != NULL) {
+    return NoParam;
+  }
+
+  *path = malloc(length + 1);
+  CHECK_PTR(*path);
+  memcpy(*path, arg, length);
+  (*path)[length] = '\0';
+
+  return NoError;
+}
+
+/**
+ * Wykonuje polecenie @p SAVE -- zapisuje wielomian z wierzchołka
+ * przekazanego stosu do pliku o podanej ścieżce i zwraca @p NoError.
+ * W przypadku napotkania błędu funkcja zwraca komunikat o błędzie:
+ * @p NoSaveParam -- w przypadku braku parametru lub błędu zapisu,
+ * @p InvalidCommandName -- w przypadku błędu związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia lub zapisu -- @p NoSaveParam; w przypadku pustego stosu --
+ * @p StackUnderflow; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunSave(stack_t *stack, string_t *line) {
+  char *path;
+
+  switch (GetPathParam(line, SAVE, &path)) {
+    case NoParam:
+      return NoSaveParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default: {
+      InputErr error = ExecuteSave(stack, path);
+      free(path);
+      return error;
     }
-    // Poprawny argument. Wykonanie operacji
-    else {
-      return ExecuteCompose(stack, num);
+  }
+}
+
+/**
+ * Wykonuje polecenie @p FREEZE -- zapisuje zamrożony obraz wielomianu
+ * z wierzchołka przekazanego stosu do pliku o podanej ścieżce i zwraca
+ * @p NoError. W przypadku napotkania błędu funkcja zwraca komunikat
+ * o błędzie: @p NoFreezeParam -- w przypadku braku parametru lub błędu
+ * zapisu, @p InvalidCommandName -- w przypadku błędu związanego z nazwą
+ * polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia lub zapisu -- @p NoFreezeParam; w przypadku pustego stosu --
+ * @p StackUnderflow; w przypadku nieprawidłowej nazwy polecenia
+ * -- @p InvalidCommandName
+ */
+static inline InputErr RunFreeze(stack_t *stack, string_t *line) {
+  char *path;
+
+  switch (GetPathParam(line, FREEZE, &path)) {
+    case NoParam:
+      return NoFreezeParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default: {
+      InputErr error = ExecuteFreeze(stack, path);
+      free(path);
+      return error;
+    }
+  }
+}
+
+/**
+ * Wykonuje polecenie @p LOAD -- dodaje na przekazany stos wielomian
+ * zapisany w pliku o podanej ścieżce i zwraca @p NoError. W przypadku
+ * napotkania błędu funkcja nie robi nic i zwraca komunikat o błędzie:
+ * @p NoLoadParam -- w przypadku braku parametru, błędu odczytu lub
+ * niepoprawnej zawartości pliku, @p InvalidCommandName -- w przypadku
+ * błędu związanego z nazwą polecenia.
+ * @param[in] stack : stos wielomianów
+ * @param[in] line : polecenie
+ * @return W przypadku sukcesu -- @p NoError; w przypadku błędu parametru
+ * polecenia lub odczytu -- @p NoLoadParam; w przypadku nieprawidłowej
+ * nazwy polecenia -- @p InvalidCommandName
+ */
+static inline InputErr RunLoad(stack_t *stack, string_t *line) {
+  char *path;
+
+  switch (GetPathParam(line, LOAD, &path)) {
+    case NoParam:
+      return NoLoadParam;
+    case InvalidCommandName:
+      return InvalidCommandName;
+    default: {
+      InputErr error = ExecuteLoad(stack, path);
+      free(path);
+      return error;
     }
   }
 }
@@ -979,6 +1760,13 @@ static inline InputErr ExecuteCommand(stack_t *stack, string_t *line) {
     // Sprawdza, czy dwa wielomiany z wierzchołka stosu są równe
     case IS_EQ:
       return ExecuteIsEq(stack);
+    // Sprawdza probabilistycznie, czy wielomian z wierzchołka stosu jest
+    // równy iloczynowi wielomianów znajdujących się pod nim
+    case IS_EQ_FAST:
+      return RunIsEqFast(stack, line);
+    // Dodaje iloczyn dwóch wielomianów z wierzchołka stosu do trzeciego
+    case FMA:
+      return ExecuteFma(stack);
     // Wypisuje stopień wielomianu z wierzchołka stosu
     case DEG:
       return ExecuteDeg(stack);
@@ -998,6 +1786,27 @@ static inline InputErr ExecuteCommand(stack_t *stack, string_t *line) {
     // Składa wielomiany ze stosu
     case COMPOSE:
       return RunCompose(stack, line);
+    // Zastępuje wielomian z wierzchołka stosu jego potęgą
+    case POW:
+      return RunPow(stack, line);
+    // Zastępuje dwa wielomiany z wierzchołka stosu ich obciętym iloczynem
+    case MUL_TRUNC:
+      return RunMulTrunc(stack, line);
+    // Obcina wielomian z wierzchołka stosu do danego stopnia
+    case TRUNC:
+      return RunTrunc(stack, line);
+    // Zastępuje n wielomianów z wierzchołka stosu ich sumą
+    case ADD_N:
+      return RunAddN(stack, line);
+    // Zapisuje wielomian z wierzchołka stosu do pliku
+    case SAVE:
+      return RunSave(stack, line);
+    // Dodaje na stos wielomian zapisany w pliku
+    case LOAD:
+      return RunLoad(stack, line);
+    // Zapisuje zamrożony obraz wielomianu z wierzchołka stosu do pliku
+    case FREEZE:
+      return RunFreeze(stack, line);
     // Niepoprawne polecenie -- błąd
     case INVALID_COMMAND:
       return InvalidCommandName;
@@ -1016,396 +1825,28 @@ static inline InputErr ExecuteCommand(stack_t *stack, string_t *line) {
 //////////////////////////////////////////
 
 
-/**
- * Konwertuje ciąg charów do wielomianu stałego, przypisuje go do
- * odpowiadającej wskaźnikowi zmiennej i ustawia wskaźnik oryginalnego
- * ciągu znaków na pierwszy nieprzetworzony znak. Funkcja rozpatruje
- * tylko liczby w zapisie dziesiętnym. W przypadku sukcesu zwraca
- * @p NoError; w przypadku napotkania błędu w trakcie konwersji,
- * zwraca @p ParsingErr. Funkcja zakłada, że przekazane wskaźniki wskazują
- * na istniejące i poprawne struktury danych.
- * @param[in] number : adres tablicy znaków
- * @param[in] p : wielomian, do którego zostanie przypisany wynik
- * @return @p NoError, jeśli konwersja zakończyła się sukcesem; @p parsinErr,
- * jeśli napotkano błędy
- */
-static inline InputErr ConvertToPolyCoeffT(char **number, Poly *p) {
-  // Wskaźnik na pierwszy nieprzetworzony znak
-  char *ptr = NULL;
-  // Konwersja ciągu do liczby typu long
-  poly_coeff_t val = strtol(*number, &ptr, 10);
-  // Liczba wykracza poza akceptowalny zakres lub konwersja nie powiodła się
-  // -- nie przetworzono nawet jednego znaku. Błąd
-  if (errno == ERANGE || ptr == *number) {
-    return ParsingErr;
-  }
-  // Konwersja zakończona sukcesem
-  else {
-    // Aktualizacja oryginalnego wskaźnika na ciąg znaków
-    *number = ptr;
-    // Przypisanie wielomianu
-    *p = PolyFromCoeff(val);
-    return NoError;
-  }
-}
-
-
-/**
- * Odpowiednik funkcji @p strtol dla typu @p int. Konwertuje ciąg znaków
- * @p num na liczbę typu @p int. Ustawia wskaźnik @p ptr w miejscu
- * pierwszego nieprzetworzonego znaku w ciągu @p num. Przy konwersji
- * funkcja przyjmuje system liczbowy o podstawie równej zmiennej @p base.
- * Musi ona być w zakresie @p [2,36]. Jeżeli otrzymana w trakcie konwersji
- * liczba wykracza poza zakres typu @p int, zwraca odpowiednio maksymalną
- * lub minimalną wartość, jaką może przechowywać ten typ oraz ustawia wartość
- * @p errno na @p ERANGE. W przypadku braku błędów zwraca znalezioną wartość.
- * @param[in] num : ciąg znaków konwertowany do liczby typu @p int
- * @param[in] ptr : wskaźnik na ciąg znaków @p char, który po wykonaniu
- * funkcji wskazuje na pierwszy nieprzetworzony znak w ciągu @p num
- * @param[in] base : podstawa systemu liczbowego, w ramach którego dokonywana
- * jest konwersja
- * @return wartość liczby odpowiadającej pewnemu początkowemu spójnemu
- * podciągowi ciągu @p num
- */
-static inline int strtoi(char *num, char **ptr, const int base) {
-  // System liczbowy musi być zgodny z wymaganiem funkcji `strtol`,
-  // tj. musi być w zakresie [2, 36] (funkcja nie akceptuje podstawy równej 0)
-  assert(2 <= base && base <= 32);
-
-  // Obliczanie wartości liczbowej odpowiadającej maksymalnemu poprawnemu
-  // ciągowi zaczynającemu się na początku `num`
-  int val = strtol(num, ptr, base);
-  // Wykroczono poza zakres
-  if (val < INT_MIN) {
-    errno = ERANGE;
-    val = INT_MIN;
-  }
-  // Wykroczono poza zakres
-  else if (val > INT_MAX) {
-    errno = ERANGE;
-    val = INT_MAX;
-  }
-
-  return val;
-}
-
-/**
- * Konwertuje maksymalny podciąg przekazanego ciągu znaków rozpoczynający się
- * na jego początku i przedstawiający liczbę w systemie dziesiętnym do
- * liczby typu @p poly_exp_t. Przypisuje jej wartość do zmiennej odpowiadającej
- * przekazanemu wskaźnikowi @p val. Jeśli otrzymana liczba wykracza poza zakres
- * tego typu, konwersja się nie powiodła lub jej wartość jest ujemna, zwraca
- * błąd @p ParsingErr. W przypadku błędu, zmienna odpowiadająca wskaźnikowi
- * @p val nie jest modyfikowana. W przypadku sukcesu zwraca @p NoError.
- * Funkcja modyfikuje także wskaźnik odpowiadający oryginalnej tablicy znaków,
- * ustawiając go na pierwszy nieprzetworzony znak. Funkcja zakłada, że
- * przekazane wskaźniki wskazują na istniejące i poprawne
- * struktury danych / zmienne.
- * @param[in] exp : adres tablicy znaków
- * @param[in] val : wskaźnik na zmienną, do której powinna zostać przypisana
- * obliczona wartość
- * @return @p NoError, jeśli konwersja zakończyła się sukcesem; @p parsinErr,
- * jeśli napotkano błędy
- */
-static inline InputErr ConvertToPolyExpT(char **exp, poly_exp_t *val) {
-  // Wskaźnik na pierwszy nieprzetworzony znak w ciągu `exp`
-  char *ptr = NULL;
-  // Konwersja maksymalnego podciągu zaczynającego się na początku ciągu `exp`
-  *val = strtoi(*exp, &ptr, 10);
-  // Wykroczono poza zakres typu `int`; nie przekonwertowano żadnego znaku;
-  // wartość jest ujemna -- błąd
-  if (errno == ERANGE || ptr == *exp || *val < 0) {
-    return ParsingErr;
-  }
-  // Sukces konwersji -- przypisanie wartości do zmiennej odpowiadajacej
-  // wskaźnikowi `exp` -- brak błędu
-  else {
-    *exp = ptr;
-    return NoError;
-  }
-}
-
-/**
- * Usuwa z pamięci wektor wraz ze wszystkimi jednomianami,
- * z których się składa.
- * @param[in] vector : wektor jednomianów
- */
-static inline void FreeVector(MonoVector *vector) {
-  // Usunięcie jednomianów
-  DestroyMonos(vector);
-  // Usunięcie wektora
-  DestroyVector(vector);
-}
-
-static inline InputErr GetPoly(char **input, Poly *p, bool recursiveCall);
-
-/**
- * Konwertuje ciąg znaków na odpowiadający im wielomian i przypisuje jego
- * wartość do zmiennej odpowiadającej danemu wskaźnikowi. W przypadku sukcesu
- * zwraca @p NoError. Jeśli jednak podczas tego procesu wystąpi błąd,
- * funkcja nie modyfikuje @p *newPoly i zwraca @p ParsingErr. Funkcja zakłada,
- * że dane wskaźniki wskazują na istniejące i poprawne struktury danych.
- * @param[in] ptr : wskaźnik na ciąg znaków reprezentujacych wielomian
- * @param[in] newPoly : wskaźnik na wielomian będący wynikiem tej funkcji
- * @return @p NoError -- w przypadku sukcesu w konwersji;
- * @p ParsingErr -- w przypadku wystąpienia błędu podczas konwersji
- */
-static inline InputErr GetPolyInMono(char **ptr, Poly *newPoly) {
-  // Wielomian nie jest stały -- składa się z jednomianów
-  if (**ptr == '(') {
-    // Konwersja jednomianów na wielomian i przesunięcie wskaźnika `*ptr` na
-    // pierwszy nieprzeanalizowany znak w ciągu `*ptr`
-    if (GetPoly(ptr, newPoly, true) != NoError) {
-      // Konwersja na wielomian zakończona błędem.
-      return ParsingErr;
-    }
-  }
-  // Wielomian jest stały
-  else if (isdigit(**ptr) || **ptr == '-') {
-    // Konwersja ciągu na wielomian i przesunięcie wskaźnika `*ptr` na
-    // pierwszy nieprzeanalizowany znak w tym ciągu
-    if (ConvertToPolyCoeffT(ptr, newPoly) != NoError) {
-      // Konwersja na wielomian zakończona błędem.
-      return ParsingErr;
-    }
-  }
-  // Niedozwolony znak -- błąd
-  else {
-    return ParsingErr;
-  }
-
-  // Konwersja zakończona sukcesem -- brak błędu
-  return NoError;
-}
-
-/**
- * Konwertuje ciąg znaków na odpowiadającą im liczbę typu @p poly_exp_t
- * i przypisuje jej wartość do zmiennej odpowiadającej danemu wskaźnikowi.
- * W przypadku sukcesu zwraca @p NoError. Jeśli jednak podczas tego procesu
- * wystąpi błąd, funkcja nie modyfikuje @p *exp i zwraca @p ParsingErr.
- * Funkcja zakłada, że dane wskaźniki wskazują na istniejące i poprawne
- * zmienne.
- * @param[in] ptr : wskaźnik na ciąg znaków reprezentujacych liczbę typu
- * @p poly_exp_t
- * @param[in] exp : wskaźnik na zmienną typu @p poly_exp_t będącą wynikiem
- * działania tej funkcji
- * @return @p NoError -- w przypadku sukcesu w konwersji;
- * @p ParsingErr -- w przypadku wystąpienia błędu podczas konwersji
- */
-static inline InputErr GetExpInMono(char **ptr, poly_exp_t *exp) {
-  // Liczba jest nieujemna i nie może zawierać znaków '+'/'-'
-  if (!isdigit(**ptr)) {
-    return ParsingErr;
-  }
-  else {
-    // Konwersja ciągu na liczbę typu `poly_exp_t` i ustawienie wskaźnika
-    // `*ptr` na pierwszy nieprzetworzony znak
-    if (ConvertToPolyExpT(ptr, exp) != NoError) {
-      return ParsingErr;
-    }
-  }
-
-  // Konwersja zakończona sukcesem
-  return NoError;
-}
-
-/**
- * Konwertuje ciąg znaków na odpowiadający mu jednomian i dodaje go do
- * danego wektora jednomianów. Jednocześnie przesuwa wskaźnik @p *ptr
- * tak, aby wskazywał na pierwszy nieprzeanalizowany przez tę funkcję
- * znak w tym ciągu znaków. W przypadku suckesu zwraca @p NoError;
- * w przypadku napotkania błędu zwraca @p ParsingErr. Funkcja zakłada,
- * że dane wskaźniki wskazują na istniejące i poprawne dane.
- * @param[in] ptr : wskaźnik na ciąg znaków
- * @param[in] vector : wskaźnik na wektor jednomianów
- * @return @p NoError -- w przypadku sukcesu; @p ParsingErr -- w przypadku
- * błędu podczas konwersji
- */
-static inline InputErr GetMono(char **ptr, MonoVector *vector) {
-  // Jednomian musi zaczynać się nawiasem
-  if (**ptr != '(') {
-    return ParsingErr;
-  }
-
-  // Przesunięcie wskaźnika na kolejny znak
-  *ptr = *ptr + 1;
-
-  // Wielomian, z którego składa się szukany jednomian
-  Poly newPoly;
-
-  // Wczytanie wielomianu `newPoly`
-  if (GetPolyInMono(ptr, &newPoly) != NoError) {
-    // Błąd podczas wczytywania
-    return ParsingErr;
-  }
-
-  // Wielomian musi być oddzielony od wykładnika pojedynczym przecinkiem
-  if (**ptr != ',') {
-    // Błąd, zwolnienie pamięci przydzielonej na wielomian
-    PolyDestroy(&newPoly);
-    return ParsingErr;
-  }
-
-  // Wykładnik odpowiadający szukanemu jednomianowi
-  poly_exp_t exp;
-  // Przesunięcie wskaźnika na wartość wykładnika
-  *ptr = *ptr + 1;
-  
-  // Wczytanie wykładnika jednomianu
-  if (GetExpInMono(ptr, &exp) != NoError) {
-    // Błąd, zwolnienie pamięci przydzielonej na wielomian
-    PolyDestroy(&newPoly);
-    return ParsingErr;
-  }
-
-  // Jeśli wielomian jest zerowy, funkcja nie dodaje go do wektora
-  if (!PolyIsZero(&newPoly)) {
-    // Dodanie jednomianu do wektora
-    AppendMono(vector, MonoFromPoly(&newPoly, exp));
-  }
-
-  // Wskaźnik `*ptr` wskazuje teraz na pierwszy znak po wczytanym wykładniku
-
-  // Jednomian musi kończyć się nawiasem
-  if (**ptr != ')') {
-    return ParsingErr;
-  }
-
-  // Przesunięcie wskaźnika na pierwszy znak po jedomianie
-  *ptr = *ptr + 1;
-
-  // Sukces
-  return NoError;
-}
-
-/**
- * Przeprowadza końcową analizę ciągu znaków reprezentującego wielomian
- * po przeprowadzeniu konwersji jego części na jednomian. W przypadku wykrycia
- * błędu w tym ciągu zwraca @p parsinErr. W przeciwnym razie zwraca @p NoError.
- * Funkcja modyfikuje także zmienną @p *continueLoop, której wartość
- * odpowiada temu, czy należy kontynuować wczytywanie kolejnych jednomianów.
- * Jeśli należy to robić, funkcja przesuwa wskaźnik @p *ptr na kolejny
- * znak. Funckja zakłada, że wszystkie przekazane wskaźniki wskazują na
- * istniejące i poprawne dane.
- * @param[in] ptr : wskaźnik na ciąg znaków
- * @param[in] recursiveCall : czy badany jedomian jest częścią pewnego
- * jednomianu
- * @param[in] continueLoop : czy kontynuować wczytywanie jednomianów
- * @return @p NoError -- w przypadku braku wykrycia błędów; @p ParsingErr
- * -- w przeciwnym razie
- */
-static inline InputErr CloseMono(char **ptr, bool recursiveCall,
-                                 bool *continueLoop) {
-  // Badanie znaku następującego bezpośrednio po jednomianie
-  switch (**ptr) {
-    case ',':
-      // Jednomian jest częścią innego jednomianu; przecinek wskazuje,
-      // że następnie zostany wczytany jego wykładnik -- należy
-      // przerwać budowanie wielomianu
-      if (recursiveCall) {
-        *continueLoop = false;
-        break;
-      }
-      // Jeśli jednomian nie jest częścią innego jednomianu, to
-      // przecinek jest niedozwolonym znakiem -- błąd
-      else {
-        return ParsingErr;
-      }
-    case '+':
-      // Należy wczytać kolejny jednomian
-      *ptr = *ptr + 1;
-      *continueLoop = true;
-      break;
-    case '\0':
-      // Koniec ciągu znaków, należy przerwać wczytywnie kolejnych
-      // jednomianów
-      *continueLoop = false;
-      break;
-    default:
-      // Niedozwolony znak -- błąd
-      return ParsingErr;
-  }
-
-  // Brak wykrytych błędów
-  return NoError;
-}
-
-/**
- * Konwertuje ciąg znaków na odpowiadający im wielomian nie będący wielomianem
- * stałym -- a więc zbudowany z jednomianów. Przesuwa następnie
- * wskaźnik @p *input tak, aby wskazywał na pierwszy nieprzetworzony znak
- * w tym ciągu. Przypisuje wynik do zmiennej @p *p. W przypadku sukcesu
- * zwraca @p NoError; w przypadku napotkania błędu zwraca @p ParsingErr
- * i nie modyfikuje @p *p. Funkcja zakłada, że dane wskaźniki wskazują
- * na istniejące i poprawne dane.
- * @param[in] input : wskaźnik na ciąg znaków
- * @param[in] p : wskaźnik na wielomian będący wynikiem konwersji
- * @param[in] recursiveCall : czy funkcja została wywołana rekurencyjnie
- * @return @p NoError -- w przypadku sukcesu; @p ParsingErr -- w przypadku
- * napotkania błędu
- */
-static inline InputErr GetPoly(char **input, Poly *p, bool recursiveCall) {
-  // Wektor jednomianów -- ich suma jest wielomianem wynikowym
-  MonoVector vector = CreateMonoVector();
-  // Czy kontynuować wczytywanie jednomianów
-  bool continueLoop = true;
-
-  while (continueLoop) {
-    // Wczytanie jednomianu
-    if (GetMono(input, &vector) != NoError) {
-      // Napotkano błąd. Usunięcie z pamięci jednomianów i wektora jednomianów
-      FreeVector(&vector);
-      return ParsingErr;
-    }
-    
-    // Wskaźnik `*input` wskazuje teraz na pierwszy znak
-    // po wczytanym jednomianie
-
-    // Analiza znaku następującego po jednomianie. Jeśli należy wczytywać
-    // kolejne jednomiany, wskaźnik `*input` zostanie przesunięty na pierwszy
-    // znak kolejnego jednomianu. W przeciwnym razie `continueLoop` zmieni
-    // wartość na false
-    if (CloseMono(input, recursiveCall, &continueLoop) != NoError) {
-      // Niepoprawny znak -- błąd.
-      // Usunięcie z pamięci jednomianów i wektora jednomianów
-      FreeVector(&vector);
-      return ParsingErr;
-    }
-  }
-
-  // Wskaźnik `*input` wskazuje na pierwszy nieprzetworzony znak
-
-  // Sumuje jednomiany z wektora jednomianów -- jest to szukany wielomian
-  if (VectorLength(&vector) > 0) {
-    *p = PolyAddMonos(VectorLength(&vector), ConvertToArr(&vector));
-  }
-  // W przypadku braku jednomianów, jest to wielomian zerowy
-  else {
-    *p = PolyZero();
-  }
-  // Zwolnienie pamięci przydzielonej na wektor
-  DestroyVector(&vector);
-  return NoError;
-}
-
 /**
  * Konwertuje ciąg znaków prawdopodobnie przedstawiający wielomian złożony
  * z jednomianów na wielomian i dodaje go do przekazanego stosu wielomianów.
  * W przypadku sukcesu -- zwraca @p NoError; w przypadku napotkaniu błędu
  * -- zwraca @p ParsingErr. Funkcja zakłada, że przekazane wskaźniki na
- * stos wielomianów i ciąg znaków wskazują na istniejące i poprawne dane.
+ * stos wielomianów, parser i ciąg znaków wskazują na istniejące i poprawne
+ * dane.
  * @param[in] stack : stos wielomianów
+ * @param[in] parser : parser wielomianów
  * @param[in] poly : ciąg znaków
+ * @param[in] end : wskaźnik na znak kończący linię
  * @return @p NoError w przypadku sukcesu w dodaniu wielomianu do stosu;
  * @p ParsingErr w przypadku napotkania błędu związanego z parsowaniem
  * wielomianu użytkownika
  */
-static inline InputErr ParsePoly(stack_t *stack, char **poly) {
+static inline InputErr ParsePoly(stack_t *stack, PolyParser *parser,
+                                 char **poly, const char *end) {
   // Wielomian odpowiadający wielomianowi przedstawionemu za pomocą ciągu
   // znaków w tablicy `poly`
   Poly newPoly;
   // Napotkano problemy z parsowaniem wielomianu -- błąd
-  if (GetPoly(poly, &newPoly, false) != NoError) {
+  if (!ParseMonos(parser, poly, end, &newPoly)) {
     return ParsingErr;
   }
   // Dodanie wielomianu do stosu -- brak błędu
@@ -1422,40 +1863,40 @@ static inline InputErr ParsePoly(stack_t *stack, char **poly) {
  * Funkcja zakłada, że przekazane wskaźniki na stos wielomianów i na
  * linię tekstu (string) wskazują na istniejące i poprawne struktury danych.
  * @param[in] stack : stos wielomianów
+ * @param[in] parser : parser wielomianów
  * @param[in] line : wielomian przekazany przez użytkownika
  * @return @p NoError w przypadku sukcesu w dodaniu wielomianu do stosu;
  * @p ParsingErr w przypadku napotkania błędu związanego z parsowaniem
  * wielomianu użytkownika
  */
-static inline InputErr ExecutePoly(stack_t *stack, string_t *line) {
+static inline InputErr ExecutePoly(stack_t *stack, PolyParser *parser,
+                                   string_t *line) {
   // Konwersja całego stringa na tablicę charów
   char *poly = GetCharArrayAt(line, 0);
   char *copy = poly;
+  // Znak kończący linię
+  const char *end = poly + StringLength(line);
   InputErr errors = NoError;
 
   // Podany wielomian jest wielomianem stałym
   if (CharAt(line, 0) == '-' || isdigit(CharAt(line, 0))) {
-    char *remainingChar = NULL;
-    // Konwersja maksymalnego poprawnego ciągu przedstawiającego liczbę
-    // w systemie dziesiętnym na liczbę typu long
-    long argValue = strtol(poly, &remainingChar, 10);
+    poly_coeff_t argValue;
     // Wartość liczby wykracza poza zakres typu long lub ciąg znaków
     // zawiera niedozwolony znak (spójny podciąg znaków przedstawiający
     // liczbę nie kończy się wraz z końcem tablicy znaków) -- błąd
-    if (errno == ERANGE || *remainingChar != '\0') {
+    if (!ParseCoeff(&poly, end, &argValue) || !IsLineEnd(*poly)) {
       return ParsingErr;
     }
     // Linia przedstawia poprawny wielomian stały;
     // dodanie go do przekazanego stosu -- brak błędów
     else {
-      PushPoly(stack, PolyFromCoeff((poly_coeff_t) argValue));
-      poly = remainingChar;
+      PushPoly(stack, PolyFromCoeff(argValue));
       errors = NoError;
     }
   }
   // Podany wielomian jest przedstawiony w postaci jednomianów lub jest błędny
   else {
-    errors = ParsePoly(stack, &poly);
+    errors = ParsePoly(stack, parser, &poly, end);
   }
 
   // Pojawił się null char w środku stringa -- błąd.
@@ -1487,10 +1928,12 @@ static inline InputErr ExecutePoly(stack_t *stack, string_t *line) {
  * przekazane wskaźniki na stos wielomianów i na linię tekstu (string)
  * wskazują na istniejące i poprawne struktury danych.
  * @param[in] stack : stos wielomianów
+ * @param[in] parser : parser wielomianów
  * @param[in] line : linia
  * @return komunikat o napotkanych błędach lub ich braku
  */
-static inline InputErr ExecuteLine(stack_t *stack, string_t *line) {
+static inline InputErr ExecuteLine(stack_t *stack, PolyParser *parser,
+                                   string_t *line) {
   // Linia jest pusta lub należy ją zignorować -- brak błędów
   if (StringLength(line) == 0 || CharAt(line, 0) == '#') {
     return NoError;
@@ -1502,7 +1945,7 @@ static inline InputErr ExecuteLine(stack_t *stack, string_t *line) {
   }
   // Linia zawiera wielomian
   else {
-    return ExecutePoly(stack, line);
+    return ExecutePoly(stack, parser, line);
   }
 }
 
@@ -1521,37 +1964,79 @@ static inline InputErr ExecuteLine(stack_t *stack, string_t *line) {
  * @param[in] numberOfLine : number linii, w której nastąpił błąd
  */
 static inline void PrintError(InputErr errorMessage, size_t numberOfLine) {
+  // Treść komunikatu o błędzie
+  const char *message;
+
   switch (errorMessage) {
     // Niepoprawna nazwa polecenia
     case InvalidCommandName:
-      fprintf(stderr, "ERROR %zu WRONG COMMAND\n", numberOfLine);
+      message = "WRONG COMMAND";
       break;
     // Niepoprawny argument polecenia DEG_BY
     case NoDegByParam:
-      fprintf(stderr, "ERROR %zu DEG BY WRONG VARIABLE\n", numberOfLine);
+      message = "DEG BY WRONG VARIABLE";
       break;
     // Niepoprawny argument polecenia AT
     case NoAtParam:
-      fprintf(stderr, "ERROR %zu AT WRONG VALUE\n", numberOfLine);
+      message = "AT WRONG VALUE";
       break;
     case NoComposeParam:
-      fprintf(stderr, "ERROR %zu COMPOSE WRONG PARAMETER\n", numberOfLine);
+      message = "COMPOSE WRONG PARAMETER";
+      break;
+    // Niepoprawny argument polecenia IS_EQ_FAST
+    case NoIsEqFastParam:
+      message = "IS_EQ_FAST WRONG PARAMETER";
+      break;
+    // Niepoprawny argument polecenia POW
+    case NoPowParam:
+      message = "POW WRONG EXPONENT";
+      break;
+    // Niepoprawny argument polecenia MUL_TRUNC
+    case NoMulTruncParam:
+      message = "MUL_TRUNC WRONG DEGREE";
+      break;
+    // Niepoprawny argument polecenia TRUNC
+    case NoTruncParam:
+      message = "TRUNC WRONG DEGREE";
+      break;
+    // Niepoprawny argument polecenia ADD_N
+    case NoAddNParam:
+      message = "ADD_N WRONG PARAMETER";
+      break;
+    // Niepoprawny argument polecenia SAVE lub błąd zapisu
+    case NoSaveParam:
+      message = "SAVE WRONG FILE";
+      break;
+    // Niepoprawny argument polecenia LOAD lub błąd odczytu
+    case NoLoadParam:
+      message = "LOAD WRONG FILE";
+      break;
+    // Niepoprawny argument polecenia FREEZE lub błąd zapisu
+    case NoFreezeParam:
+      message = "FREEZE WRONG FILE";
       break;
     // Brak odpowiedniej liczby wielomianów na stosie wielomianów
     case StackUnderflow:
-      fprintf(stderr, "ERROR %zu STACK UNDERFLOW\n", numberOfLine);
+      message = "STACK UNDERFLOW";
       break;
     // Błąd podczas parsowania wielomianu
     case ParsingErr:
-      fprintf(stderr, "ERROR %zu WRONG POLY\n", numberOfLine);
+      message = "WRONG POLY";
       break;
     // Brak błędów
     case NoError:
-      break;
+      return;
     // Błędny komunikat
     default:
       assert(false);
+      return;
   }
+
+  WriteString(ErrorOutput, "ERROR ");
+  WriteSize(ErrorOutput, numberOfLine);
+  WriteChar(ErrorOutput, ' ');
+  WriteString(ErrorOutput, message);
+  WriteChar(ErrorOutput, '\n');
 }
 
 
@@ -1564,20 +2049,26 @@ static inline void PrintError(InputErr errorMessage, size_t numberOfLine) {
 
 /**
  * Kalkulator wielomianów wielu zmiennych. Wczytuje polecenia od użytkownika
- * i wykonuje je. W przypadku błędu wyświetla je. Kontynuuje aż do napotkania
- * linii zakończonej znakiem @p EOF.
+ * (ze standardowego wejścia lub z plików) i wykonuje je. W przypadku
+ * błędu wyświetla je. Kontynuuje aż do napotkania linii zakończonej
+ * końcem skryptu.
+ * @param[in] script : skrypt, z którego czytane są linie
  * 
  * @details
  * Tworzy stos wielomianów, na którym będzie przechowywać wielomiany tworzone
- * przez użytkownika oraz string, który będzie przyjmować polecenia.
- * Wczytuje pojedynczą linię,  wykonuje zawartą w niej instrukcję
- * i wypisuje ewentualny napotkany w trakcie błąd. Po zakończeniu działania
- * zwalnia całą zaalokowaną pamięć -- stos wraz ze wciąż znajdującymi się
- * na nim wielomianami oraz string.
+ * przez użytkownika oraz string, który będzie przyjmować polecenia. Wczytuje
+ * pojedynczą linię, wykonuje zawartą w niej instrukcję i wypisuje ewentualny
+ * napotkany w trakcie błąd. Linie skryptu są widokami na bloki wejścia lub
+ * odwzorowane w pamięci pliki, więc zwykle nie są kopiowane. Po zakończeniu
+ * działania zwalnia całą zaalokowaną pamięć -- stos wraz ze wciąż
+ * znajdującymi się na nim wielomianami, tablice parsera oraz string.
  */
-static inline void RunCalculator() {
+static inline void RunCalculator(Script *script) {
   // Stos wielomianów, na których będą wykonywane polecenia
   stack_t polyStack = CreateStack();
+  // Parser wielomianów, którego tablice jednomianów są używane ponownie
+  // w kolejnych liniach
+  PolyParser parser = CreateParser();
   // String przyjmujący polecenia od użytkownika
   string_t newLine = CreateString();
   // Typ polecenia -- wielomian / operacja na wielomianach
@@ -1589,7 +2080,7 @@ static inline void RunCalculator() {
 
   while (continueLoop) {
     // Wczytanie linii od użytkownika
-    type = ScanString(&newLine);
+    type = ReadScriptLine(script, &newLine);
 
     switch (type) {
       // Ostatnie polecenie -- koniec pliku
@@ -1597,12 +2088,12 @@ static inline void RunCalculator() {
         // Zatrzymanie kalkulatora po przetworzeniu linii
         continueLoop = false;
         // Wykonaj polecenie i wypisz ewentualny błąd
-        PrintError(ExecuteLine(&polyStack, &newLine), numberOfLine);
+        PrintError(ExecuteLine(&polyStack, &parser, &newLine), numberOfLine);
         break;
       // Polecenie, brak zatrzymania kalkulatora
       case EndOfLine:
         // Wykonaj polecenie i wypisz ewentualny błąd
-        PrintError(ExecuteLine(&polyStack, &newLine), numberOfLine);
+        PrintError(ExecuteLine(&polyStack, &parser, &newLine), numberOfLine);
         break;
       // Błędny typ linii -- błąd
       default:
@@ -1613,7 +2104,7 @@ static inline void RunCalculator() {
     numberOfLine++;
     // Zresetowanie stringa
     ResetString(&newLine);
-    // Dostowanie stosu do ilości znajdujących się w nim wielomianów
+    // Dostowanie stosu do ilości znajdujących się w nim wielomianów
     AdjustStack(&polyStack);
   }
 
@@ -1623,15 +2114,239 @@ static inline void RunCalculator() {
   // na nim wielomianów
   DestroyPolys(&polyStack);
   DestroyStack(&polyStack);
+  // Zwolnienie pamięci przydzielonej na tablice parsera
+  DestroyParser(&parser);
 }
 
+
+//////////////////////////////////////////
+//                                      //
+//             Tryb wsadowy             //
+//                                      //
+//////////////////////////////////////////
+
+
+/** Opcja programu włączająca tryb wsadowy */
+#define JOBS_OPTION "--jobs"
+
 /**
- * Uruchamia kalkulator.
+ * Plik ze skryptem wykonywany w trybie wsadowym.
  */
-int main() {
+typedef struct {
+  char *path; ///< ścieżka pliku
+  OutputCapture output; ///< wyjście przechwycone podczas wykonywania skryptu
+  bool opened; ///< czy plik udało się otworzyć
+  bool done; ///< czy wykonywanie skryptu się zakończyło
+} BatchFile;
+
+/**
+ * Pliki wykonywane w trybie wsadowym, wspólne dla wszystkich wątków.
+ */
+typedef struct {
+  BatchFile *files; ///< pliki w kolejności podania w argumentach
+  size_t numOfFiles; ///< liczba plików
+  size_t next; ///< indeks kolejnego pliku do wykonania
+  pthread_mutex_t mutex; ///< blokada chroniąca @p next i pola @p done
+  pthread_cond_t fileDone; ///< sygnalizuje zakończenie pliku
+} Batch;
+
+/**
+ * Wątek trybu wsadowego. Pobiera kolejne niewykonane pliki i każdy
+ * wykonuje osobnym kalkulatorem -- z własnym stosem i parserem -- tak jak
+ * skrypt podany jako jedyny argument programu. Wyjście i błędy (także
+ * błąd otwarcia pliku) są przechwytywane do wyjścia pliku.
+ * @param[in] arg : wskaźnik na pliki trybu wsadowego
+ * @return @p NULL
+ */
+static void *RunBatchWorker(void *arg) {
+  Batch *batch = arg;
+
+  while (true) {
+    pthread_mutex_lock(&batch->mutex);
+    const size_t i = batch->next < batch->numOfFiles ? batch->next++
+                                                     : batch->numOfFiles;
+    pthread_mutex_unlock(&batch->mutex);
+
+    if (i == batch->numOfFiles) {
+      return NULL;
+    }
+
+    BatchFile *file = &batch->files[i];
+    Script script;
+
+    StartCapture(&file->output);
+    file->opened = OpenScript(&script, 1, &file->path);
+
+    if (file->opened) {
+      RunCalculator(&script);
+      CloseScript(&script);
+    }
+
+    StopCapture();
+
+    pthread_mutex_lock(&batch->mutex);
+    file->done = true;
+    pthread_cond_signal(&batch->fileDone);
+    pthread_mutex_unlock(&batch->mutex);
+  }
+}
+
+/**
+ * Wykonuje pliki ze skryptami niezależnie od siebie, w @p numOfJobs
+ * wątkach (nie więcej niż plików).
+ * @param[in] numOfJobs : liczba wątków
+ * @param[in] numOfPaths : liczba plików
+ * @param[in] paths : ścieżki plików
+ * @return @p true, jeśli udało się otworzyć wszystkie pliki; @p false
+ * w przeciwnym razie
+ *
+ * @details
+ * Wątek główny nie wykonuje skryptów, lecz czeka na zakończenie kolejnych
+ * plików w kolejności podania i wypisuje ich przechwycone wyjście, więc
+ * wynik nie zależy od liczby wątków ani od ich przeplotu. Wyjście plików
+ * zakończonych przed poprzednimi czeka w pamięci. Jeśli nie udało się
+ * utworzyć żadnego wątku, pliki są wykonywane w wątku głównym.
+ */
+static bool RunBatch(size_t numOfJobs, const size_t numOfPaths,
+                     char *const paths[]) {
+  Batch batch = {
+    .files = malloc((numOfPaths > 0 ? numOfPaths : 1) * sizeof(BatchFile)),
+    .numOfFiles = numOfPaths,
+    .next = 0
+  };
+
+  CHECK_PTR(batch.files);
+  pthread_mutex_init(&batch.mutex, NULL);
+  pthread_cond_init(&batch.fileDone, NULL);
+
+  for (size_t i = 0; i < numOfPaths; i++) {
+    batch.files[i] = (BatchFile) {
+      .path = paths[i],
+      .output = CreateCapture(),
+      .opened = false,
+      .done = false
+    };
+  }
+
+  if (numOfJobs > numOfPaths) {
+    numOfJobs = numOfPaths;
+  }
+
+  pthread_t *threads = malloc((numOfJobs > 0 ? numOfJobs : 1) *
+                              sizeof(pthread_t));
+  // Liczba utworzonych wątków
+  size_t numOfThreads = 0;
+
+  CHECK_PTR(threads);
+
+  while (numOfThreads < numOfJobs &&
+         pthread_create(&threads[numOfThreads], NULL, RunBatchWorker,
+                        &batch) == 0) {
+    numOfThreads++;
+  }
+
+  if (numOfThreads == 0) {
+    RunBatchWorker(&batch);
+  }
+
+  bool opened = true;
+
+  for (size_t i = 0; i < numOfPaths; i++) {
+    pthread_mutex_lock(&batch.mutex);
+
+    while (!batch.files[i].done) {
+      pthread_cond_wait(&batch.fileDone, &batch.mutex);
+    }
+
+    pthread_mutex_unlock(&batch.mutex);
+
+    WriteCaptured(&batch.files[i].output);
+    DestroyCapture(&batch.files[i].output);
+    FlushOutput();
+    opened = opened && batch.files[i].opened;
+  }
+
+  for (size_t i = 0; i < numOfThreads; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  free(threads);
+  pthread_cond_destroy(&batch.fileDone);
+  pthread_mutex_destroy(&batch.mutex);
+  free(batch.files);
+  return opened;
+}
+
+/**
+ * Zamienia argument opcji @p --jobs na liczbę wątków.
+ * @param[in] arg : argument opcji
+ * @param[out] numOfJobs : liczba wątków
+ * @return @p true, jeśli argument jest dodatnią liczbą dziesiętną;
+ * @p false w przeciwnym razie
+ */
+static bool ParseJobs(const char *arg, size_t *numOfJobs) {
+  char *end;
+
+  if (!isdigit((unsigned char) arg[0])) {
+    return false;
+  }
+
+  errno = 0;
+  const unsigned long value = strtoul(arg, &end, 10);
+
+  if (errno == ERANGE || *end != '\0' || value == 0) {
+    return false;
+  }
+
+  *numOfJobs = (size_t) value;
+  return true;
+}
+
+/**
+ * Uruchamia kalkulator. Bez argumentów czyta polecenia ze standardowego
+ * wejścia; w przeciwnym razie argumenty są ścieżkami plików ze skryptem,
+ * czytanych tak, jakby zostały ze sobą połączone. Jeśli argumenty
+ * zaczynają się od @p --jobs @p N, pliki są wykonywane niezależnie
+ * od siebie w @p N wątkach.
+ * @param[in] argc : liczba argumentów programu
+ * @param[in] argv : argumenty programu
+ * @return @p 0 w przypadku sukcesu; @p 1, jeśli któregoś z plików nie udało
+ * się otworzyć lub liczba wątków jest niepoprawna
+ */
+int main(int argc, char *argv[]) {
+  // Buforowane wyjście jest zapisywane także przy awaryjnym zakończeniu
+  // programu funkcją `exit`
+  atexit(FlushOutput);
+  // Tablica z haszowaniem nazw poleceń, tworzona przed uruchomieniem wątków
+  BuildCommandTable();
+
+  // Tryb wsadowy -- każdy plik osobnym kalkulatorem
+  if (argc > 1 && strcmp(argv[1], JOBS_OPTION) == 0) {
+    size_t numOfJobs;
+
+    if (argc < 3 || !ParseJobs(argv[2], &numOfJobs)) {
+      WriteString(ErrorOutput, JOBS_OPTION ": expected a positive number "
+                               "of jobs\n");
+      return 1;
+    }
+
+    if (argc > 3) {
+      return RunBatch(numOfJobs, (size_t) argc - 3, argv + 3) ? 0 : 1;
+    }
+
+    argc = 1;
+  }
+
+  // Skrypt -- standardowe wejście, jeśli nie podano plików
+  Script script;
+
+  if (!OpenScript(&script, argc > 1 ? (size_t) argc - 1 : 0, argv + 1)) {
+    return 1;
+  }
+
   // Uruchomienie kalkulatora
-  RunCalculator();
+  RunCalculator(&script);
+  CloseScript(&script);
   
   return 0;
 }
-
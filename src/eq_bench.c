@@ -0,0 +1,170 @@
+/** @file
+  Program porównujący sprawdzanie równości wielomianu z iloczynem
+
+  Dla zestawu iloczynów wielomianów o różnej liczbie czynników, jednomianów,
+  rozpiętości wykładników i głębokości mierzy czas wymnożenia czynników
+  i porównania wyniku funkcją @p PolyIsEq (polecenia @p MUL i @p IS_EQ) oraz
+  czas sprawdzenia równości funkcją @p PolyProbablyEqProduct bez wymnażania
+  (polecenie @p IS_EQ_FAST), a następnie wypisuje wyniki na standardowe
+  wyjście.
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#include "poly.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Liczba powtórzeń każdego pomiaru; wynikiem jest najkrótszy czas */
+#define REPEATS 3
+
+/** Liczba prób testu probabilistycznego, domyślna w kalkulatorze */
+#define TRIALS 4
+
+/** Największa liczba czynników iloczynu */
+#define MAX_FACTORS 3
+
+/** Liczba mierzonych iloczynów */
+#define NUM_OF_WORKLOADS (sizeof(Workloads) / sizeof(Workloads[0]))
+
+/** Kształt iloczynu */
+typedef struct {
+  const char *name; ///< nazwa kształtu
+  size_t count; ///< liczba czynników
+  size_t size; ///< liczba jednomianów każdego czynnika
+  poly_exp_t range; ///< wykładniki są losowane z przedziału [0, range)
+  int depth; ///< liczba poziomów poniżej najwyższego
+} Workload;
+
+/** Zestaw mierzonych kształtów */
+static const Workload Workloads[] = {
+  { .name = "2 x 1000 sparse", .count = 2, .size = 1000, .range = 1000000,
+    .depth = 0 },
+  { .name = "2 x 300 dense",   .count = 2, .size = 300,  .range = 300,
+    .depth = 0 },
+  { .name = "3 x 100 sparse",  .count = 3, .size = 100,  .range = 1000000,
+    .depth = 0 },
+  { .name = "2 x 100 nested",  .count = 2, .size = 100,  .range = 20000,
+    .depth = 1 }
+};
+
+/**
+ * Tworzy losowy wielomian o danym kształcie.
+ * @param[in] size : liczba jednomianów
+ * @param[in] range : ograniczenie wykładników
+ * @param[in] depth : liczba poziomów poniżej najwyższego
+ * @return losowy wielomian
+ */
+static Poly RandPoly(size_t size, poly_exp_t range, int depth) {
+  Mono *monos = malloc(size * sizeof(Mono));
+
+  if (monos == NULL) {
+    exit(1);
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    Poly coeff = depth > 0 ? RandPoly(4, 8, depth - 1)
+                           : PolyFromCoeff(1 + rand() % 9);
+    monos[i] = (Mono) {.p = coeff, .exp = rand() % range};
+  }
+
+  return PolyOwnMonos(size, monos);
+}
+
+/**
+ * Wymnaża czynniki.
+ * @param[in] count : liczba czynników
+ * @param[in] factors : czynniki
+ * @return iloczyn czynników
+ */
+static Poly Expand(size_t count, const Poly factors[]) {
+  Poly product = PolyClone(&factors[0]);
+
+  for (size_t i = 1; i < count; i++) {
+    Poly next = PolyMul(&product, &factors[i]);
+
+    PolyDestroy(&product);
+    product = next;
+  }
+
+  return product;
+}
+
+/**
+ * Mierzy czas sprawdzenia, czy wielomian jest równy iloczynowi czynników.
+ * @param[in] p : wielomian
+ * @param[in] count : liczba czynników
+ * @param[in] factors : czynniki
+ * @param[in] expand : czy czynniki są wymnażane, a nie sprawdzane
+ * probabilistycznie
+ * @return najkrótszy czas w sekundach
+ */
+static double Measure(const Poly *p, size_t count, const Poly factors[],
+                      bool expand) {
+  double best = -1;
+
+  for (int r = 0; r < REPEATS; r++) {
+    clock_t start = clock();
+    bool eq;
+
+    if (expand) {
+      Poly product = Expand(count, factors);
+
+      eq = PolyIsEq(p, &product);
+      PolyDestroy(&product);
+    }
+    else {
+      eq = PolyProbablyEqProduct(p, count, factors, TRIALS);
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (!eq) {
+      fprintf(stderr, "wrong answer\n");
+      exit(1);
+    }
+
+    if (best < 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  return best;
+}
+
+/**
+ * Mierzy oba sposoby sprawdzania równości dla wszystkich kształtów
+ * i wypisuje wyniki.
+ */
+int main(void) {
+  srand(2021);
+
+  printf("%-16s %9s %9s %9s\n", "product", "terms", "MUL+IS_EQ",
+         "IS_EQ_FAST");
+
+  for (size_t i = 0; i < NUM_OF_WORKLOADS; i++) {
+    const Workload *w = &Workloads[i];
+    Poly factors[MAX_FACTORS];
+
+    for (size_t j = 0; j < w->count; j++) {
+      factors[j] = RandPoly(w->size, w->range, w->depth);
+    }
+
+    Poly p = Expand(w->count, factors);
+
+    printf("%-16s %9zu %8.4fs %8.4fs\n", w->name,
+           PolyIsCoeff(&p) ? (size_t) 1 : p.size,
+           Measure(&p, w->count, factors, true),
+           Measure(&p, w->count, factors, false));
+
+    PolyDestroy(&p);
+
+    for (size_t j = 0; j < w->count; j++) {
+      PolyDestroy(&factors[j]);
+    }
+  }
+
+  return 0;
+}
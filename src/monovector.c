@@ -200,6 +200,16 @@ void DestroyMonos(MonoVector *vector) {
   }
 }
 
+/**
+ * Sprawdza, czy przekazany wskaźnik na wektor nie jest równy @p NULL.
+ * Następnie zeruje liczbę jednomianów w wektorze, pozostawiając tablicę
+ * jednomianów przydzieloną.
+ */
+void ClearVector(MonoVector *vector) {
+  assert(vector != NULL);
+  vector->length = 0;
+}
+
 /**
  * Sprawdza, czy przekazany wskaźnik na wektor nie jest równy @p NULL.
  * Następnie, jeśli tablica jednomianów jest różna od @p NULL, zwalnia
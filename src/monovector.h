@@ -62,6 +62,14 @@ Mono *ConvertToArr(MonoVector *vector);
  */
 void DestroyMonos(MonoVector *vector);
 
+/**
+ * Removes all monomials from an array without freeing the memory allocated
+ * for the array, so it can be filled again. It does not free the memory
+ * allocated for the monomials in the array.
+ * @param[in] vector : pointer to an array
+ */
+void ClearVector(MonoVector *vector);
+
 /**
  * Removes an array of monomials from memory. It does not frees the memory
  * allocated for the monomials in the array.
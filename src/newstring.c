@@ -6,9 +6,9 @@
 */
 
 #include <assert.h>
-#include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "newstring.h"
 
@@ -44,6 +44,21 @@ string_t CreateString() {
   return newString;
 }
 
+/**
+ * Tworzy stringa wskazującego na cudze znaki. Zerowy rozmiar tablicy
+ * oznacza, że string nie przydzielił na nie pamięci, więc nie będzie jej
+ * zwalniać ani modyfikować.
+ */
+string_t StringView(char *chars, size_t length) {
+  assert(chars != NULL || length == 0);
+  string_t view = (string_t) {
+    .chars  = chars,
+    .length = length,
+    .size   = 0
+  };
+  return view;
+}
+
 /**
  * Sprawdza, czy wskaźnik na string nie jest równy @p NULL, a następnie
  * zwraca jego długość.
@@ -124,62 +139,43 @@ static inline size_t ChooseNewSize(const size_t consideredSize) {
 }
 
 /**
- * Dodaje znak na koniec stringa. Funkcja zakłada, że wskaźnik na string
- * wskazuje na istniejącą i poprawną strukturę danych.
- * @param[in] string : wskaźnik na string
- * @param[in] c : znak typu @p char
+ * Sprawdza, czy wskaźniki nie są równe @p NULL i czy string nie jest
+ * niepustym widokiem. Rozszerza tablicę znaków tak, aby zmieściły się
+ * dodawane znaki i kończący je znak @p '\\0', a następnie kopiuje je jednym
+ * wywołaniem funkcji @p memcpy.
  */
-static inline void AppendChar(string_t *string, const char c) {
-  // Należy rozszerzyć tablicę znaków
-  if (string->length >= string->size) {
-    // Nie da się rozszerzyć tablicy charów -- błąd
-    if (string->size == MAX_SIZE) {
-      exit(1);
-    }
+void AppendChars(string_t *string, const char *chars, size_t count) {
+  assert(string != NULL && (chars != NULL || count == 0));
+  assert(string->size > 0 || string->length == 0);
+
+  // Nie da się rozszerzyć tablicy charów -- błąd
+  if (count >= MAX_SIZE - string->length) {
+    exit(1);
+  }
 
-    // Stworzenie tablicy o domyślnym rozmiarze
+  // Potrzebny rozmiar tablicy, wliczając kończący znak `'\0'`
+  const size_t needed = string->length + count + 1;
+
+  if (needed > string->size) {
+    // Widok nie ma własnej tablicy -- zostanie ona utworzona
     if (string->size == 0) {
-      ResizeString(string, DEFAULT_SIZE);
+      string->chars = NULL;
     }
-    // Rozszerzenie tablicy
-    else {
-      ResizeString(string, ChooseNewSize(string->size));
-    }
-  }
 
-  // Przypisanie nowego znaku do tablicy
-  string->chars[string->length] = c;
-  // Aktualizacja długości stringa
-  string->length++;
-}
+    size_t newSize = string->size > 0 ? string->size : DEFAULT_SIZE;
 
-/**
- * Sprawdza, czy wskaźnik na string nie jest równy @p NULL. Wczytuje znaki
- * tak długo, aż nie napotka znaku nowej linii lub @p EOF i dodaje je do
- * tablicy znaków. Następnie zwraca odpowiedni typ linii.
- */
-LineType ScanString(string_t *string) {
-  assert(string != NULL);
-  // Zmienna pomocnicza służąca do wczytywania znaków z wejścia
-  char newChar;
-  
-  while (true) {
-    // Wczytuje znak
-    newChar = getchar();
-    
-    switch (newChar) {
-      // Koniec linii
-      case '\n':
-        return EndOfLine;
-      // Koniec pliku
-      case EOF:
-        return EndOfFile;
-      // "Zwykły" char -- dodaje do tablicy
-      default:
-        AppendChar(string, newChar);
-        break;
+    while (newSize < needed) {
+      newSize = ChooseNewSize(newSize);
     }
+
+    ResizeString(string, newSize);
+  }
+
+  if (count > 0) {
+    memcpy(string->chars + string->length, chars, count);
+    string->length += count;
   }
+  string->chars[string->length] = '\0';
 }
 
 /**
@@ -226,14 +222,19 @@ bool CompareTo(string_t *string, const char *text) {
 
 /**
  * Sprawdza, czy wskaźnik na string nie jest równy @p NULL i czy indeks
- * nie wykracza poza długość stringa. Jeśli rozmiar tablicy znaków
- * jest większy od długości stringa, ustawia znak nowej linii na odpowiednim
- * indeksie, aby zaznaczyć koniec ciągu znaków. Następnie zwraca wskaźnik
- * na znak na indeksie równym @p index w tablicy znaków.
+ * nie wykracza poza długość stringa. Jeśli string nie jest widokiem,
+ * ustawia znak @p '\\0' na indeksie równym jego długości (w razie potrzeby
+ * rozszerzając tablicę znaków), aby zaznaczyć koniec ciągu znaków. Następnie
+ * zwraca wskaźnik na znak na indeksie równym @p index w tablicy znaków.
  */
 char *GetCharArrayAt(string_t *string, const size_t index) {
   assert(string != NULL && index < string->length);
-  if (string->length < string->size) {
+  // Widok kończy się znakiem kończącym linię; w pozostałych przypadkach
+  // na znak `'\0'` musi zostać miejsce
+  if (string->size > 0) {
+    if (string->length == string->size) {
+      ResizeString(string, ChooseNewSize(string->size));
+    }
     string->chars[string->length] = '\0';
   }
   return &string->chars[index];
@@ -251,13 +252,15 @@ void ResetString(string_t *string) {
 
 /**
  * Sprawdza, czy wskaźnik na string nie jest równy @p NULL. Jeśli została
- * zaalokowana tablica typu @p char, zwalnia ją, a następnie przywraca
- * stringa do domyślnych wartości -- jego długość, rozmiar są równe zeru.
+ * zaalokowana tablica typu @p char (string nie jest widokiem), zwalnia ją,
+ * a następnie przywraca stringa do domyślnych wartości -- jego długość,
+ * rozmiar są równe zeru.
  */
 void DestroyString(string_t *string) {
   assert(string != NULL);
 
-  if (string->chars != NULL) {
+  // Widok nie jest właścicielem swoich znaków
+  if (string->size > 0) {
     free(string->chars);
   }
   string->chars = NULL;
@@ -22,7 +22,7 @@ typedef struct {
 
 /** Type representing what character a line ended with */
 typedef enum {
-  EndOfFile, ///< line ended with an EOF char
+  EndOfFile, ///< line ended with the end of the input
   EndOfLine ///< line ended with a new line character
 } LineType;
 
@@ -33,22 +33,32 @@ typedef enum {
 string_t CreateString();
 
 /**
- * Returns the number of characters a string consists of (its length).
- * @param[in] string : pointer to a string
- * @return length of the string
+ * Creates a string viewing @p length characters starting at @p chars,
+ * without copying them. The character following the viewed ones must be
+ * readable and must end the line (a new line or a null character). A view
+ * does not own its characters: @p DestroyString leaves them untouched
+ * and appending characters is allowed only after @p ResetString.
+ * @param[in] chars : viewed characters
+ * @param[in] length : number of viewed characters
+ * @return string viewing the characters
  */
-size_t StringLength(string_t *string);
+string_t StringView(char *chars, size_t length);
+
+/**
+ * Appends characters to the end of a string. The string is kept
+ * terminated with a null character.
+ * @param[in] string : pointer to a string that is not a non-empty view
+ * @param[in] chars : characters to append
+ * @param[in] count : number of characters to append
+ */
+void AppendChars(string_t *string, const char *chars, size_t count);
 
 /**
- * Gets input from the standard stream until coming across an @p EOF
- * or a new line character and adds them to a string (however, the ending
- * character is not added). If the line ended with an @p EOF, returns
- * @p EndOfFile. Otherwise, returns @p EndOfLine.
+ * Returns the number of characters a string consists of (its length).
  * @param[in] string : pointer to a string
- * @return @p EndOfFile if @p EOF was the last character in the line;
- * @p EndOfLine otherwise
+ * @return length of the string
  */
-LineType ScanString(string_t *string);
+size_t StringLength(string_t *string);
 
 /**
  * Returns the character at a given index in a string.
@@ -0,0 +1,348 @@
+/** @file
+  Implementacja buforowanego wyjścia
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "output.h"
+
+
+/** Rozmiar bufora każdego ze strumieni */
+#define BUFFER_SIZE (1 << 16)
+
+/** Liczba strumieni wyjścia */
+#define NUM_OF_STREAMS 2
+
+/** Maksymalna liczba cyfr dziesiętnych liczby 64-bitowej bez znaku */
+#define MAX_DIGITS 20
+
+/** Funkcja sprawdzająca, czy wskaźnik @p p jest równy @p NULL.
+ * Jeśli jest -- awaryjnie kończy działanie programu kodem @p 1.
+ * W przeciwnym wypadku nie robi nic.
+ * @param[in] p : wskaźnik
+ */
+#define CHECK_PTR(p)  \
+  do {                \
+    if (p == NULL) {  \
+      exit(1);        \
+    }                 \
+  } while (0)
+
+/**
+ * Bufor strumienia wyjścia.
+ */
+typedef struct {
+  int fd; ///< deskryptor pliku, do którego trafia zawartość bufora
+  size_t length; ///< liczba znaków w buforze
+  char chars[BUFFER_SIZE]; ///< znaki oczekujące na zapisanie
+} OutputBuffer;
+
+/** Bufory strumieni wyjścia, indeksowane wartościami @p OutputStream */
+static OutputBuffer buffers[NUM_OF_STREAMS] = {
+  [StandardOutput] = {.fd = STDOUT_FILENO, .length = 0},
+  [ErrorOutput] = {.fd = STDERR_FILENO, .length = 0}
+};
+
+/** Strumień, do którego ostatnio dopisano znaki */
+static OutputStream lastStream = StandardOutput;
+
+/** Wyjście przechwytywane przez bieżący wątek lub @p NULL */
+static _Thread_local OutputCapture *capture = NULL;
+
+/**
+ * Zapisy dziesiętne liczb @p 00..99, po dwa znaki na liczbę -- pozwalają
+ * wyznaczać dwie cyfry jednym dzieleniem.
+ */
+static const char DIGIT_PAIRS[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/**
+ * Zapisuje znaki do pliku funkcją @p write, ponawiając ją po przerwaniu
+ * sygnałem i po zapisaniu części znaków. Błędy zapisu są ignorowane, tak
+ * jak przy wypisywaniu funkcją @p printf.
+ * @param[in] fd : deskryptor pliku
+ * @param[in] chars : znaki
+ * @param[in] count : liczba znaków
+ */
+static void WriteAll(const int fd, const char *chars, size_t count) {
+  while (count > 0) {
+    const ssize_t written = write(fd, chars, count);
+
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return;
+    }
+
+    chars += written;
+    count -= (size_t) written;
+  }
+}
+
+/**
+ * Zapisuje zawartość bufora do pliku i opróżnia go.
+ * @param[in] buffer : bufor strumienia
+ */
+static inline void FlushBuffer(OutputBuffer *buffer) {
+  if (buffer->length > 0) {
+    WriteAll(buffer->fd, buffer->chars, buffer->length);
+    buffer->length = 0;
+  }
+}
+
+/**
+ * Zwraca bufor strumienia, w którym zmieści się co najmniej @p count
+ * znaków. Jeśli ostatnio dopisywano znaki do innego strumienia, najpierw
+ * zapisuje jego bufor, aby zachować kolejność komunikatów.
+ * @param[in] stream : strumień wyjścia
+ * @param[in] count : liczba znaków (nie większa od rozmiaru bufora)
+ * @return bufor strumienia
+ */
+static inline OutputBuffer *Reserve(const OutputStream stream,
+                                    const size_t count) {
+  assert(stream < NUM_OF_STREAMS && count <= BUFFER_SIZE);
+
+  if (stream != lastStream) {
+    FlushBuffer(&buffers[lastStream]);
+    lastStream = stream;
+  }
+
+  OutputBuffer *buffer = &buffers[stream];
+
+  if (BUFFER_SIZE - buffer->length < count) {
+    FlushBuffer(buffer);
+  }
+
+  return buffer;
+}
+
+/**
+ * Zwraca miejsce na @p count znaków na końcu przechwytywanego wyjścia,
+ * w razie potrzeby dwukrotnie powiększając jego tablice. Jeśli ostatnio
+ * przechwycone znaki należą do innego strumienia, rozpoczyna nowy
+ * fragment.
+ * @param[in] stream : strumień wyjścia
+ * @param[in] count : liczba znaków
+ * @return wskaźnik na miejsce na znaki
+ */
+static char *ClaimCaptured(const OutputStream stream, const size_t count) {
+  OutputCapture *c = capture;
+
+  if (c->numOfSegments == 0 ||
+      c->segments[c->numOfSegments - 1].stream != stream) {
+    if (c->numOfSegments == c->segmentsSize) {
+      c->segmentsSize = c->segmentsSize > 0 ? 2 * c->segmentsSize : 4;
+      c->segments = realloc(c->segments,
+                            c->segmentsSize * sizeof(CapturedSegment));
+      CHECK_PTR(c->segments);
+    }
+
+    c->segments[c->numOfSegments++] = (CapturedSegment) {
+      .stream = stream,
+      .length = 0
+    };
+  }
+
+  if (c->size - c->length < count) {
+    while (c->size - c->length < count) {
+      c->size = c->size > 0 ? 2 * c->size : BUFFER_SIZE;
+    }
+
+    c->chars = realloc(c->chars, c->size);
+    CHECK_PTR(c->chars);
+  }
+
+  char *chars = c->chars + c->length;
+
+  c->length += count;
+  c->segments[c->numOfSegments - 1].length += count;
+  return chars;
+}
+
+/**
+ * Zwraca miejsce na @p count znaków w buforze strumienia lub -- jeśli
+ * wątek przechwytuje wyjście -- na końcu przechwytywanego wyjścia.
+ * Znaki są uznawane za dopisane.
+ * @param[in] stream : strumień wyjścia
+ * @param[in] count : liczba znaków (nie większa od rozmiaru bufora)
+ * @return wskaźnik na miejsce na znaki
+ */
+static inline char *Claim(const OutputStream stream, const size_t count) {
+  if (capture != NULL) {
+    return ClaimCaptured(stream, count);
+  }
+
+  OutputBuffer *buffer = Reserve(stream, count);
+  char *chars = buffer->chars + buffer->length;
+
+  buffer->length += count;
+  return chars;
+}
+
+void WriteChar(OutputStream stream, char c) {
+  *Claim(stream, 1) = c;
+}
+
+/**
+ * Dopisuje ciąg znaków do bufora strumienia. Ciągi dłuższe od bufora są
+ * zapisywane bezpośrednio, po opróżnieniu bufora, chyba że wątek
+ * przechwytuje wyjście.
+ * @param[in] stream : strumień wyjścia
+ * @param[in] chars : znaki
+ * @param[in] count : liczba znaków
+ */
+static void WriteChars(const OutputStream stream, const char *chars,
+                       const size_t count) {
+  if (count > BUFFER_SIZE && capture == NULL) {
+    OutputBuffer *buffer = Reserve(stream, BUFFER_SIZE);
+
+    FlushBuffer(buffer);
+    WriteAll(buffer->fd, chars, count);
+    return;
+  }
+
+  memcpy(Claim(stream, count), chars, count);
+}
+
+void WriteString(OutputStream stream, const char *text) {
+  assert(text != NULL);
+
+  WriteChars(stream, text, strlen(text));
+}
+
+/**
+ * Dopisuje do bufora zapis dziesiętny liczby bez znaku, poprzedzony
+ * opcjonalnie znakiem minus.
+ * @param[in] stream : strumień wyjścia
+ * @param[in] value : wartość bezwzględna liczby
+ * @param[in] negative : czy liczba jest ujemna
+ *
+ * @details
+ * Cyfry są wyznaczane od końca, po dwie na raz, w tymczasowej tablicy,
+ * a następnie kopiowane do bufora razem z minusem.
+ */
+static void WriteDecimal(const OutputStream stream, uint64_t value,
+                         const bool negative) {
+  // Cyfry liczby zapisane od końca tablicy, poprzedzone być może minusem
+  char digits[MAX_DIGITS + 1];
+  size_t pos = MAX_DIGITS + 1;
+
+  while (value >= 100) {
+    const unsigned pair = (unsigned) (value % 100);
+
+    value /= 100;
+    pos -= 2;
+    memcpy(digits + pos, DIGIT_PAIRS + 2 * pair, 2);
+  }
+
+  if (value >= 10) {
+    pos -= 2;
+    memcpy(digits + pos, DIGIT_PAIRS + 2 * value, 2);
+  }
+  else {
+    digits[--pos] = (char) ('0' + value);
+  }
+
+  if (negative) {
+    digits[--pos] = '-';
+  }
+
+  const size_t count = MAX_DIGITS + 1 - pos;
+
+  memcpy(Claim(stream, count), digits + pos, count);
+}
+
+/**
+ * Wartość bezwzględna liczby ujemnej jest liczona w arytmetyce bez znaku,
+ * dzięki czemu poprawnie wypisywana jest także wartość @p LONG_MIN.
+ */
+void WriteLong(OutputStream stream, long value) {
+  if (value < 0) {
+    WriteDecimal(stream, -(uint64_t) value, true);
+  }
+  else {
+    WriteDecimal(stream, (uint64_t) value, false);
+  }
+}
+
+void WriteSize(OutputStream stream, size_t value) {
+  WriteDecimal(stream, (uint64_t) value, false);
+}
+
+/**
+ * Bufor strumienia jest zapisywany przy przejściu do innego strumienia,
+ * więc niepusty może być tylko bufor ostatnio używanego strumienia.
+ * Wątek przechwytujący wyjście nie ma czego zapisywać.
+ */
+void FlushOutput(void) {
+  if (capture == NULL) {
+    FlushBuffer(&buffers[lastStream]);
+  }
+}
+
+OutputCapture CreateCapture(void) {
+  return (OutputCapture) {
+    .chars = NULL,
+    .length = 0,
+    .size = 0,
+    .segments = NULL,
+    .numOfSegments = 0,
+    .segmentsSize = 0
+  };
+}
+
+void StartCapture(OutputCapture *output) {
+  assert(output != NULL && capture == NULL);
+
+  capture = output;
+}
+
+void StopCapture(void) {
+  capture = NULL;
+}
+
+/**
+ * Fragmenty są dopisywane kolejno do buforów swoich strumieni, więc
+ * zachowują kolejność względem siebie i względem wcześniej wypisanych
+ * znaków.
+ */
+void WriteCaptured(const OutputCapture *output) {
+  assert(output != NULL && capture == NULL);
+
+  const char *chars = output->chars;
+
+  for (size_t i = 0; i < output->numOfSegments; i++) {
+    WriteChars(output->segments[i].stream, chars, output->segments[i].length);
+    chars += output->segments[i].length;
+  }
+}
+
+void DestroyCapture(OutputCapture *output) {
+  assert(output != NULL);
+
+  free(output->chars);
+  free(output->segments);
+  *output = CreateCapture();
+}
@@ -0,0 +1,115 @@
+/** @file
+  Buffered output library interface
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#ifndef __OUTPUT__
+#define __OUTPUT__
+
+#include <stddef.h>
+
+/** Type representing an output stream */
+typedef enum {
+  StandardOutput, ///< standard output stream
+  ErrorOutput ///< standard error stream
+} OutputStream;
+
+/**
+ * Struct representing a run of characters written to one stream
+ * while output was captured.
+ */
+typedef struct {
+  OutputStream stream; ///< stream the characters were written to
+  size_t length; ///< number of characters
+} CapturedSegment;
+
+/**
+ * Struct representing output captured by a thread instead of being
+ * written to the streams: the characters written, in order, divided into
+ * runs written to the same stream.
+ */
+typedef struct {
+  char *chars; ///< captured characters
+  size_t length; ///< number of captured characters
+  size_t size; ///< size of the array of characters
+  CapturedSegment *segments; ///< consecutive runs of characters
+  size_t numOfSegments; ///< number of runs
+  size_t segmentsSize; ///< size of the array of runs
+} OutputCapture;
+
+/**
+ * Appends a character to the buffer of a stream.
+ * @param[in] stream : output stream
+ * @param[in] c : character
+ */
+void WriteChar(OutputStream stream, char c);
+
+/**
+ * Appends a null-terminated sequence of characters to the buffer
+ * of a stream.
+ * @param[in] stream : output stream
+ * @param[in] text : sequence of characters
+ */
+void WriteString(OutputStream stream, const char *text);
+
+/**
+ * Appends the decimal representation of a signed number to the buffer
+ * of a stream.
+ * @param[in] stream : output stream
+ * @param[in] value : number
+ */
+void WriteLong(OutputStream stream, long value);
+
+/**
+ * Appends the decimal representation of an unsigned number to the buffer
+ * of a stream.
+ * @param[in] stream : output stream
+ * @param[in] value : number
+ */
+void WriteSize(OutputStream stream, size_t value);
+
+/**
+ * Writes the contents of the buffers of all streams to their files.
+ * Buffers are also flushed when they fill up and before characters
+ * are appended to another stream, so the order of messages written
+ * to different streams is preserved.
+ */
+void FlushOutput(void);
+
+/**
+ * Creates an empty captured output and returns it.
+ * @return empty captured output
+ */
+OutputCapture CreateCapture(void);
+
+/**
+ * Makes the calling thread append everything it writes to the given
+ * captured output instead of the buffers of the streams, until
+ * `StopCapture` is called. Threads capturing their output may write
+ * concurrently with each other; the buffers of the streams may only be
+ * used by one thread at a time.
+ * @param[in] output : pointer to a captured output
+ */
+void StartCapture(OutputCapture *output);
+
+/**
+ * Makes the calling thread write to the buffers of the streams again.
+ */
+void StopCapture(void);
+
+/**
+ * Appends captured output to the buffers of the streams, preserving
+ * the order of all its characters.
+ * @param[in] output : pointer to a captured output
+ */
+void WriteCaptured(const OutputCapture *output);
+
+/**
+ * Frees the memory used by a captured output and makes it empty.
+ * @param[in] output : pointer to a captured output
+ */
+void DestroyCapture(OutputCapture *output);
+
+#endif
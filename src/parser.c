@@ -0,0 +1,496 @@
+/** @file
+  Implementacja parsera wielomianów przedstawionych w postaci sumy jednomianów
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parser.h"
+
+
+/** Funkcja sprawdzająca, czy wskaźnik @p p jest równy @p NULL.
+ * Jeśli jest -- awaryjnie kończy działanie programu kodem @p 1.
+ * W przeciwnym wypadku nie robi nic.
+ * @param[in] p : wskaźnik
+ */
+#define CHECK_PTR(p)  \
+  do {                \
+    if (p == NULL) {  \
+      exit(1);        \
+    }                 \
+  } while (0)
+
+/** Liczba cyfr przetwarzanych jednocześnie */
+#define CHUNK_DIGITS 8
+
+/** Liczba 64-bitowa, której każdy bajt jest równy @p b */
+#define REPEAT_BYTE(b) (0x0101010101010101ULL * (uint8_t) (b))
+
+/** Kolejne potęgi dziesiątki, od @f$10^0@f$ do @f$10^8@f$ */
+static const uint64_t POWERS_OF_TEN[CHUNK_DIGITS + 1] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+
+//////////////////////////////////////////
+//                                      //
+//          Konwersja liczb             //
+//                                      //
+//////////////////////////////////////////
+
+
+/**
+ * Sprawdza, czy znak kończy linię. Linie wczytane do stringa kończą się
+ * znakiem @p '\\0', a linie czytane wprost z odwzorowanego w pamięci pliku
+ * -- znakiem nowej linii.
+ * @param[in] c : znak
+ * @return @p true, jeśli znak kończy linię; @p false w przeciwnym razie
+ */
+static inline bool IsLineEnd(const char c) {
+  return c == '\0' || c == '\n';
+}
+
+/**
+ * Wczytuje osiem kolejnych znaków jako liczbę 64-bitową, w której
+ * pierwszy znak zajmuje najmłodszy bajt.
+ * @param[in] chars : znaki
+ * @return blok ośmiu znaków
+ */
+static inline uint64_t LoadChunk(const char *chars) {
+  uint64_t chunk;
+
+  memcpy(&chunk, chars, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  chunk = __builtin_bswap64(chunk);
+#endif
+
+  return chunk;
+}
+
+/**
+ * Zwraca liczbę początkowych znaków bloku, które są cyframi.
+ * @param[in] chunk : blok ośmiu znaków
+ * @return liczba początkowych cyfr bloku
+ *
+ * @details
+ * Wszystkie bajty bloku są sprawdzane jednocześnie. Po operacji XOR
+ * z @p '0' cyfry przyjmują wartości @p 0..9. Dodanie @p 0x76 do siedmiu
+ * najmłodszych bitów bajtu ustawia jego najstarszy bit dokładnie wtedy,
+ * gdy wartość przekracza @p 9, i nie przenosi się do sąsiedniego bajtu.
+ */
+static inline unsigned CountDigits(const uint64_t chunk) {
+  const uint64_t bytes = chunk ^ REPEAT_BYTE('0');
+  const uint64_t nonDigits =
+    (((bytes & REPEAT_BYTE(0x7F)) + REPEAT_BYTE(0x76)) | bytes) &
+    REPEAT_BYTE(0x80);
+
+  if (nonDigits == 0) {
+    return CHUNK_DIGITS;
+  }
+
+  return (unsigned) __builtin_ctzll(nonDigits) / 8;
+}
+
+/**
+ * Zwraca wartość liczby zapisanej @p count początkowymi znakami bloku.
+ * @param[in] chunk : blok ośmiu znaków
+ * @param[in] count : liczba cyfr, od @p 1 do @p 8
+ * @return wartość liczby
+ *
+ * @details
+ * Cyfry są przesuwane do najstarszych bajtów bloku, a zwolnione bajty
+ * -- zera -- pełnią rolę zer wiodących. Pożyczki przy odejmowaniu @p '0'
+ * od znaków za cyframi przenoszą się tylko do starszych bajtów, które
+ * zostają wysunięte. Następnie sąsiednie cyfry są łączone w pary, a pary
+ * w liczby ośmiocyfrowe trzema mnożeniami.
+ */
+static inline uint64_t ChunkValue(uint64_t chunk, const unsigned count) {
+  assert(0 < count && count <= CHUNK_DIGITS);
+
+  chunk = (chunk - REPEAT_BYTE('0')) << (8 * (CHUNK_DIGITS - count));
+  chunk = chunk * 10 + (chunk >> 8);
+
+  return (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+          (((chunk >> 16) & 0x000000FF000000FFULL) *
+           (1 + (10000ULL << 32)))) >> 32;
+}
+
+/**
+ * Konwertuje maksymalny ciąg cyfr dziesiętnych na początku @p *ptr na
+ * liczbę nie większą od @p limit i ustawia @p *ptr na pierwszy znak po
+ * nim. Przekroczenie ograniczenia jest wykrywane dokładnie, przed
+ * dopisaniem każdego bloku cyfr.
+ * @param[in,out] ptr : wskaźnik na ciąg znaków
+ * @param[in] end : wskaźnik na znak kończący linię; znaki przed nim
+ * można odczytywać blokami
+ * @param[in] limit : największa dopuszczalna wartość
+ * @param[out] value : wartość liczby
+ * @return @p true w przypadku sukcesu; @p false, jeśli ciąg nie zaczyna się
+ * cyfrą lub liczba przekracza @p limit
+ *
+ * @details
+ * Dopóki przed końcem linii mieści się osiem znaków, cyfry są
+ * przetwarzane blokami po osiem (SWAR); pozostałe -- pojedynczo.
+ */
+static inline bool ParseDigits(char **ptr, const char *end,
+                               const uint64_t limit, uint64_t *value) {
+  char *chars = *ptr;
+  uint64_t val = 0;
+  // Liczba cyfr ostatniego bloku; mniej niż osiem kończy liczbę
+  unsigned count = CHUNK_DIGITS;
+
+  while (count == CHUNK_DIGITS && end - chars >= CHUNK_DIGITS) {
+    const uint64_t chunk = LoadChunk(chars);
+
+    count = CountDigits(chunk);
+
+    if (count > 0) {
+      const uint64_t digits = ChunkValue(chunk, count);
+
+      if (val > (limit - digits) / POWERS_OF_TEN[count]) {
+        return false;
+      }
+
+      val = val * POWERS_OF_TEN[count] + digits;
+      chars += count;
+    }
+  }
+
+  // Ostatnie cyfry przed końcem linii
+  if (count == CHUNK_DIGITS) {
+    while ((unsigned char) (*chars - '0') < 10) {
+      const uint64_t digit = (uint64_t) (*chars - '0');
+
+      if (val > (limit - digit) / 10) {
+        return false;
+      }
+
+      val = val * 10 + digit;
+      chars++;
+    }
+  }
+
+  // Nie wczytano żadnej cyfry -- błąd
+  if (chars == *ptr) {
+    return false;
+  }
+
+  *ptr = chars;
+  *value = val;
+  return true;
+}
+
+/**
+ * Wartość bezwzględna liczby ujemnej może być o jeden większa od
+ * @p LONG_MAX; przy zmianie znaku jest więc pomniejszana o jeden, aby
+ * uniknąć przepełnienia.
+ */
+bool ParseCoeff(char **input, const char *end, poly_coeff_t *value) {
+  char *ptr = *input;
+  const bool negative = *ptr == '-';
+  uint64_t magnitude;
+
+  if (negative) {
+    ptr++;
+  }
+
+  if (!ParseDigits(&ptr, end, (uint64_t) LONG_MAX + negative, &magnitude)) {
+    return false;
+  }
+
+  if (negative) {
+    *value = magnitude > 0 ? -(poly_coeff_t) (magnitude - 1) - 1 : 0;
+  }
+  else {
+    *value = (poly_coeff_t) magnitude;
+  }
+
+  *input = ptr;
+  return true;
+}
+
+/**
+ * Konwertuje liczbę w zapisie dziesiętnym (być może poprzedzoną znakiem
+ * minus) na początku ciągu znaków do wielomianu stałego, przypisuje go do
+ * odpowiadającej wskaźnikowi zmiennej i ustawia wskaźnik oryginalnego
+ * ciągu znaków na pierwszy nieprzetworzony znak. Funkcja zakłada, że
+ * przekazane wskaźniki wskazują na istniejące i poprawne struktury danych.
+ * @param[in] number : adres tablicy znaków
+ * @param[in] end : koniec linii
+ * @param[in] p : wielomian, do którego zostanie przypisany wynik
+ * @return @p true, jeśli konwersja zakończyła się sukcesem; @p false,
+ * jeśli napotkano błędy
+ */
+static inline bool ConvertToPolyCoeffT(char **number, const char *end,
+                                       Poly *p) {
+  poly_coeff_t val;
+
+  // Liczba wykracza poza zakres typu `poly_coeff_t` lub nie zaczyna się
+  // cyfrą ani znakiem minus -- błąd
+  if (!ParseCoeff(number, end, &val)) {
+    return false;
+  }
+
+  *p = PolyFromCoeff(val);
+  return true;
+}
+
+/**
+ * Konwertuje maksymalny ciąg cyfr na początku przekazanego ciągu znaków
+ * do liczby typu @p poly_exp_t. Przypisuje jej wartość do zmiennej
+ * odpowiadającej przekazanemu wskaźnikowi @p val. Jeśli ciąg nie zaczyna
+ * się cyfrą (w szczególności zaczyna się znakiem) lub liczba wykracza poza
+ * zakres tego typu, zwraca @p false. W przypadku sukcesu zwraca @p true
+ * i ustawia wskaźnik odpowiadający oryginalnej tablicy znaków na pierwszy
+ * nieprzetworzony znak.
+ * @param[in] exp : adres tablicy znaków
+ * @param[in] end : koniec linii
+ * @param[in] val : wskaźnik na zmienną, do której powinna zostać przypisana
+ * obliczona wartość
+ * @return @p true, jeśli konwersja zakończyła się sukcesem; @p false,
+ * jeśli napotkano błędy
+ */
+static inline bool ConvertToPolyExpT(char **exp, const char *end,
+                                     poly_exp_t *val) {
+  uint64_t num;
+
+  if (!ParseDigits(exp, end, INT_MAX, &num)) {
+    return false;
+  }
+
+  *val = (poly_exp_t) num;
+  return true;
+}
+
+
+//////////////////////////////////////////
+//                                      //
+//         Pula tablic jednomianów      //
+//                                      //
+//////////////////////////////////////////
+
+
+PolyParser CreateParser(void) {
+  return (PolyParser) {.levels = NULL, .numOfLevels = 0};
+}
+
+/**
+ * Zwraca pusty poziom zagnieżdżenia o numerze @p level, w razie potrzeby
+ * dwukrotnie powiększając pulę tablic parsera. Tablice z puli zachowują
+ * pamięć przydzieloną przy poprzednich wywołaniach.
+ * @param[in] parser : parser
+ * @param[in] level : numer poziomu zagnieżdżenia
+ * @return poziom zagnieżdżenia o numerze @p level
+ */
+static ParserLevel *OpenLevel(PolyParser *parser, const size_t level) {
+  if (level >= parser->numOfLevels) {
+    const size_t newNumOfLevels = parser->numOfLevels > 0 ?
+                                  2 * parser->numOfLevels : 4;
+    ParserLevel *levels = realloc(parser->levels,
+                                  newNumOfLevels * sizeof(ParserLevel));
+
+    CHECK_PTR(levels);
+
+    for (size_t i = parser->numOfLevels; i < newNumOfLevels; i++) {
+      levels[i].monos = CreateMonoVector();
+    }
+
+    parser->levels = levels;
+    parser->numOfLevels = newNumOfLevels;
+  }
+
+  ParserLevel *opened = &parser->levels[level];
+
+  assert(VectorLength(&opened->monos) == 0);
+  opened->ascending = true;
+  return opened;
+}
+
+/**
+ * Dopisuje niezerowy jednomian do tablicy poziomu zagnieżdżenia
+ * i sprawdza, czy jego wykładnik jest większy od wykładnika jednomianu
+ * dopisanego wcześniej.
+ * @param[in] opened : poziom zagnieżdżenia
+ * @param[in] mono : niezerowy jednomian
+ */
+static inline void AddToLevel(ParserLevel *opened, Mono mono) {
+  const size_t length = VectorLength(&opened->monos);
+
+  if (length > 0 &&
+      MonoGetExp(&opened->monos.monos[length - 1]) >= MonoGetExp(&mono)) {
+    opened->ascending = false;
+  }
+
+  AppendMono(&opened->monos, mono);
+}
+
+/**
+ * Sumuje jednomiany wczytane na poziomie @p level w wielomian i opróżnia
+ * tablicę tego poziomu, nie zwalniając jej pamięci. Pusta tablica daje
+ * wielomian zerowy. Jeśli wykładniki jednomianów były ściśle rosnące,
+ * wielomian jest budowany wprost z tablicy, bez sortowania i sumowania
+ * jednomianów.
+ * @param[in] parser : parser
+ * @param[in] level : numer poziomu zagnieżdżenia
+ * @return suma jednomianów poziomu
+ */
+static Poly CloseLevel(PolyParser *parser, const size_t level) {
+  ParserLevel *closed = &parser->levels[level];
+  const size_t length = VectorLength(&closed->monos);
+  Poly p = PolyZero();
+
+  if (length > 0 && closed->ascending) {
+    p = PolyAddSortedMonos(length, ConvertToArr(&closed->monos));
+  }
+  else if (length > 0) {
+    p = PolyAddMonos(length, ConvertToArr(&closed->monos));
+  }
+
+  ClearVector(&closed->monos);
+  return p;
+}
+
+/**
+ * Usuwa jednomiany wczytane na poziomach od @p 0 do @p level włącznie
+ * i opróżnia ich tablice.
+ * @param[in] parser : parser
+ * @param[in] level : numer najgłębszego otwartego poziomu
+ * @return @p false
+ */
+static bool AbortParse(PolyParser *parser, const size_t level) {
+  for (size_t i = 0; i <= level; i++) {
+    DestroyMonos(&parser->levels[i].monos);
+    ClearVector(&parser->levels[i].monos);
+  }
+
+  return false;
+}
+
+void DestroyParser(PolyParser *parser) {
+  assert(parser != NULL);
+
+  for (size_t i = 0; i < parser->numOfLevels; i++) {
+    DestroyVector(&parser->levels[i].monos);
+  }
+
+  free(parser->levels);
+  *parser = CreateParser();
+}
+
+
+//////////////////////////////////////////
+//                                      //
+//        Parsowanie wielomianów        //
+//                                      //
+//////////////////////////////////////////
+
+
+/**
+ * Zamiast rekurencji parser przechowuje jawny stos poziomów zagnieżdżenia
+ * -- na każdym poziomie tablicę z puli, w której gromadzone są jednomiany
+ * współczynnika otwartego jednomianu poziomu wyżej.
+ *
+ * Nawias otwierający za nawiasem rozpoczynającym jednomian otwiera nowy
+ * poziom. Po wczytaniu współczynnika (liczby lub zamkniętego poziomu)
+ * funkcja kończy jednomian: wczytuje przecinek, wykładnik i nawias
+ * zamykający, a niezerowy jednomian dopisuje do tablicy bieżącego poziomu,
+ * śledząc przy tym, czy wykładniki poziomu są ściśle rosnące.
+ * Znak @p + rozpoczyna kolejny jednomian tego samego poziomu, przecinek
+ * zamyka poziom -- suma jego jednomianów staje się współczynnikiem
+ * jednomianu poziomu wyżej, który jest kończony w ten sam sposób -- a koniec
+ * linii kończy wielomian, o ile wszystkie poziomy zostały zamknięte.
+ * W razie błędu usuwane są jednomiany wszystkich otwartych poziomów.
+ */
+bool ParseMonos(PolyParser *parser, char **input, const char *end,
+                Poly *p) {
+  assert(parser != NULL && input != NULL && p != NULL);
+
+  char *ptr = *input;
+  // Numer najgłębszego otwartego poziomu
+  size_t level = 0;
+
+  OpenLevel(parser, 0);
+
+  while (true) {
+    // Jednomian musi zaczynać się nawiasem
+    if (*ptr != '(') {
+      return AbortParse(parser, level);
+    }
+
+    ptr++;
+
+    // Współczynnik jest wielomianem złożonym z jednomianów -- nowy poziom
+    if (*ptr == '(') {
+      OpenLevel(parser, ++level);
+      continue;
+    }
+
+    // Współczynnik jednomianu kończonego w pętli poniżej
+    Poly coeff;
+
+    // Współczynnik jest stały
+    if (!ConvertToPolyCoeffT(&ptr, end, &coeff)) {
+      return AbortParse(parser, level);
+    }
+
+    // Kończenie jednomianów: po każdym przecinku kolejny poziom zostaje
+    // zamknięty i kończony jest jednomian poziomu wyżej
+    while (true) {
+      // Wykładnik jednomianu
+      poly_exp_t exp;
+
+      // Wielomian musi być oddzielony od wykładnika pojedynczym przecinkiem
+      if (*ptr != ',') {
+        PolyDestroy(&coeff);
+        return AbortParse(parser, level);
+      }
+
+      ptr++;
+
+      // Wykładnik jest nieujemny i nie może zawierać znaków '+'/'-'
+      if (!ConvertToPolyExpT(&ptr, end, &exp)) {
+        PolyDestroy(&coeff);
+        return AbortParse(parser, level);
+      }
+
+      // Jeśli wielomian jest zerowy, jednomian nie jest dodawany do tablicy
+      if (!PolyIsZero(&coeff)) {
+        AddToLevel(&parser->levels[level], MonoFromPoly(&coeff, exp));
+      }
+
+      // Jednomian musi kończyć się nawiasem
+      if (*ptr != ')') {
+        return AbortParse(parser, level);
+      }
+
+      ptr++;
+
+      // Kolejny jednomian tego samego poziomu
+      if (*ptr == '+') {
+        ptr++;
+        break;
+      }
+      // Zamknięcie poziomu -- jego suma jest współczynnikiem jednomianu
+      // poziomu wyżej
+      else if (*ptr == ',' && level > 0) {
+        coeff = CloseLevel(parser, level--);
+      }
+      // Koniec linii po zamknięciu wszystkich poziomów -- sukces
+      else if (IsLineEnd(*ptr) && level == 0) {
+        *p = CloseLevel(parser, 0);
+        *input = ptr;
+        return true;
+      }
+      // Niedozwolony znak -- błąd
+      else {
+        return AbortParse(parser, level);
+      }
+    }
+  }
+}
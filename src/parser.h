@@ -0,0 +1,81 @@
+/** @file
+  Interface of the parser of polynomials given as sums of monomials
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#ifndef __PARSER__
+#define __PARSER__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "monovector.h"
+#include "poly.h"
+
+/**
+ * Struct representing a level of nesting being parsed.
+ */
+typedef struct {
+  MonoVector monos; ///< monomials read at the level so far
+  bool ascending; ///< whether their exponents are strictly ascending
+} ParserLevel;
+
+/**
+ * Struct representing a parser of polynomials. It keeps a pool of arrays
+ * of monomials, one for every level of nesting met so far, which is reused
+ * by consecutive calls, so parsing does not allocate memory for them
+ * on every line.
+ */
+typedef struct {
+  ParserLevel *levels; ///< arrays of monomials of consecutive levels
+  size_t numOfLevels; ///< number of arrays in the pool
+} PolyParser;
+
+/**
+ * Creates a new parser with an empty pool of arrays and returns it.
+ * @return new parser
+ */
+PolyParser CreateParser(void);
+
+/**
+ * Converts the decimal representation of a coefficient -- digits,
+ * optionally preceded by a minus sign -- at the beginning of a sequence
+ * of characters into a number. Overflow is detected exactly.
+ * @param[in] input : pointer to a sequence of characters, set to the first
+ * unprocessed character on success
+ * @param[in] end : pointer to the character ending the line; all
+ * characters before it may be read
+ * @param[out] value : pointer to the resulting number, not modified
+ * on failure
+ * @return @p true on success; @p false if the sequence does not start with
+ * a number or the number is out of the range of @p poly_coeff_t
+ */
+bool ParseCoeff(char **input, const char *end, poly_coeff_t *value);
+
+/**
+ * Converts a sequence of characters representing a sum of monomials
+ * into a polynomial. The sequence must end with a null character or with
+ * a new line character. Parsing is iterative, so its stack usage does not
+ * depend on the depth of nesting of the polynomial.
+ * @param[in] parser : pointer to a parser
+ * @param[in] input : pointer to a sequence of characters, set to the first
+ * unprocessed character on success
+ * @param[in] end : pointer to the character ending the line; all
+ * characters before it may be read
+ * @param[out] p : pointer to the resulting polynomial, not modified
+ * on failure
+ * @return @p true on success; @p false if the sequence does not represent
+ * a correct polynomial
+ */
+bool ParseMonos(PolyParser *parser, char **input, const char *end,
+                Poly *p);
+
+/**
+ * Removes a parser from memory together with its pool of arrays.
+ * @param[in] parser : pointer to a parser
+ */
+void DestroyParser(PolyParser *parser);
+
+#endif
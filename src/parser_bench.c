@@ -0,0 +1,274 @@
+/** @file
+  Program mierzący szybkość parsowania wielomianów
+
+  Generuje linie przedstawiające wielomiany o różnej liczbie jednomianów,
+  głębokości i kolejności wykładników, a następnie mierzy, ile megabajtów
+  tekstu na sekundę przetwarza parser kalkulatora, i wypisuje wyniki
+  na standardowe wyjście. Porównuje także konwersję współczynników funkcją
+  @p ParseCoeff z konwersją funkcją @p strtol.
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#include "parser.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Liczba powtórzeń każdego pomiaru; wynikiem jest najkrótszy czas */
+#define REPEATS 5
+
+/** Liczba mierzonych kształtów linii */
+#define NUM_OF_WORKLOADS (sizeof(Workloads) / sizeof(Workloads[0]))
+
+/** Liczba współczynników w ciągach mierzących konwersję liczb */
+#define NUM_OF_NUMBERS 2000000
+
+/** Kształt linii przedstawiających wielomiany */
+typedef struct {
+  const char *name; ///< nazwa kształtu
+  size_t lines; ///< liczba linii
+  size_t size; ///< liczba jednomianów na każdym poziomie
+  int depth; ///< liczba poziomów poniżej najwyższego
+  bool sorted; ///< czy wykładniki są rosnące
+  bool chain; ///< czy wielomian ma jeden jednomian na każdym poziomie
+} Workload;
+
+/** Zestaw mierzonych kształtów */
+static const Workload Workloads[] = {
+  { .name = "flat sorted",     .lines = 20,    .size = 50000, .depth = 0,
+    .sorted = true },
+  { .name = "flat unsorted",   .lines = 20,    .size = 50000, .depth = 0,
+    .sorted = false },
+  { .name = "short lines",     .lines = 50000, .size = 8,     .depth = 0,
+    .sorted = false },
+  { .name = "nested sorted",   .lines = 200,   .size = 8,     .depth = 3,
+    .sorted = true },
+  { .name = "nested unsorted", .lines = 200,   .size = 8,     .depth = 3,
+    .sorted = false },
+  { .name = "chain",           .lines = 20,    .size = 1,     .depth = 20000,
+    .sorted = true, .chain = true }
+};
+
+/**
+ * Tekst dopisywany na koniec dynamicznie powiększanej tablicy.
+ */
+typedef struct {
+  char *chars; ///< znaki
+  size_t length; ///< liczba znaków
+  size_t size; ///< rozmiar tablicy
+} Text;
+
+/**
+ * Dopisuje znaki na koniec tekstu.
+ * @param[in] text : tekst
+ * @param[in] chars : dopisywane znaki
+ */
+static void Append(Text *text, const char *chars) {
+  const size_t count = strlen(chars);
+
+  if (text->length + count + 1 > text->size) {
+    text->size = 2 * (text->length + count + 1);
+    text->chars = realloc(text->chars, text->size);
+
+    if (text->chars == NULL) {
+      exit(1);
+    }
+  }
+
+  memcpy(text->chars + text->length, chars, count + 1);
+  text->length += count;
+}
+
+/**
+ * Dopisuje do tekstu losowy wielomian o danym kształcie.
+ * @param[in] text : tekst
+ * @param[in] w : kształt wielomianu
+ * @param[in] depth : liczba poziomów poniżej bieżącego
+ */
+static void AppendPoly(Text *text, const Workload *w, int depth) {
+  char number[32];
+  poly_exp_t exp = 0;
+
+  for (size_t i = 0; i < w->size; i++) {
+    Append(text, i > 0 ? "+(" : "(");
+
+    if (depth > 0) {
+      AppendPoly(text, w, depth - 1);
+    }
+    else {
+      sprintf(number, "%d", rand() % 2000001 - 1000000);
+      Append(text, number);
+    }
+
+    exp = w->sorted ? exp + 1 + rand() % 4 : rand() % 1000000;
+    sprintf(number, ",%d)", exp);
+    Append(text, number);
+  }
+}
+
+/**
+ * Dopisuje do tekstu wielomian złożony z jednego jednomianu na każdym
+ * z poziomów, bez rekurencji.
+ * @param[in] text : tekst
+ * @param[in] depth : liczba poziomów poniżej najwyższego
+ */
+static void AppendChain(Text *text, int depth) {
+  for (int i = 0; i <= depth; i++) {
+    Append(text, "(");
+  }
+
+  Append(text, "1,0)");
+
+  for (int i = 0; i < depth; i++) {
+    Append(text, ",1)");
+  }
+}
+
+/**
+ * Mierzy szybkość parsowania linii danego kształtu.
+ * @param[in] parser : parser
+ * @param[in] w : kształt linii
+ * @return szybkość w megabajtach na sekundę
+ */
+static double Measure(PolyParser *parser, const Workload *w) {
+  Text text = {.chars = NULL, .length = 0, .size = 0};
+
+  for (size_t i = 0; i < w->lines; i++) {
+    if (w->chain) {
+      AppendChain(&text, w->depth);
+    }
+    else {
+      AppendPoly(&text, w, w->depth);
+    }
+
+    Append(&text, "\n");
+  }
+
+  double best = -1;
+
+  for (int r = 0; r < REPEATS; r++) {
+    char *line = text.chars;
+    clock_t start = clock();
+
+    while (*line != '\0') {
+      Poly p;
+
+      if (!ParseMonos(parser, &line, text.chars + text.length, &p)) {
+        fprintf(stderr, "%s: parsing failed\n", w->name);
+        exit(1);
+      }
+
+      PolyDestroy(&p);
+      line++;
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (best < 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  free(text.chars);
+  return (double) text.length / (1 << 20) / best;
+}
+
+/**
+ * Mierzy szybkość konwersji ciągu współczynników rozdzielonych przecinkami.
+ * @param[in] maxDigits : największa liczba cyfr współczynnika
+ * @param[in] useStrtol : czy współczynniki są konwertowane funkcją
+ * @p strtol ze sprawdzeniem @p errno, a nie funkcją @p ParseCoeff
+ * @return szybkość w megabajtach na sekundę
+ */
+static double MeasureNumbers(int maxDigits, bool useStrtol) {
+  Text text = {.chars = NULL, .length = 0, .size = 0};
+  char number[32];
+
+  for (size_t i = 0; i < NUM_OF_NUMBERS; i++) {
+    int digits = 1 + rand() % maxDigits;
+    size_t pos = 0;
+
+    if (rand() % 2 == 0) {
+      number[pos++] = '-';
+    }
+
+    number[pos++] = (char) ('1' + rand() % 9);
+
+    while (--digits > 0) {
+      number[pos++] = (char) ('0' + rand() % 10);
+    }
+
+    number[pos++] = ',';
+    number[pos] = '\0';
+    Append(&text, number);
+  }
+
+  double best = -1;
+  // Suma współczynników -- zapobiega pominięciu konwersji przez kompilator
+  volatile poly_coeff_t sum = 0;
+
+  for (int r = 0; r < REPEATS; r++) {
+    char *ptr = text.chars;
+    const char *end = text.chars + text.length;
+    clock_t start = clock();
+
+    while (ptr != end) {
+      poly_coeff_t value;
+
+      if (useStrtol) {
+        char *next;
+
+        errno = 0;
+        value = strtol(ptr, &next, 10);
+
+        if (errno == ERANGE || next == ptr) {
+          exit(1);
+        }
+
+        ptr = next;
+      }
+      else if (!ParseCoeff(&ptr, end, &value)) {
+        exit(1);
+      }
+
+      sum += value;
+      ptr++;
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (best < 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  free(text.chars);
+  return (double) text.length / (1 << 20) / best;
+}
+
+/**
+ * Mierzy szybkość parsowania linii wszystkich kształtów oraz konwersji
+ * współczynników i wypisuje wyniki.
+ */
+int main(void) {
+  PolyParser parser = CreateParser();
+
+  srand(2021);
+
+  for (size_t i = 0; i < NUM_OF_WORKLOADS; i++) {
+    printf("%-16s %8.1f MB/s\n", Workloads[i].name,
+           Measure(&parser, &Workloads[i]));
+  }
+
+  printf("%-16s %8.1f MB/s (strtol: %.1f MB/s)\n", "coeffs 1-6",
+         MeasureNumbers(6, false), MeasureNumbers(6, true));
+  printf("%-16s %8.1f MB/s (strtol: %.1f MB/s)\n", "coeffs 1-18",
+         MeasureNumbers(18, false), MeasureNumbers(18, true));
+
+  DestroyParser(&parser);
+  return 0;
+}
@@ -5,7 +5,20 @@
   @date 2021
 */
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "poly.h"
 
@@ -27,6 +40,454 @@
     }                 \
   } while (0)
 
+//////////////////////////////
+//                          //
+//        Metadane          //
+//                          //
+//////////////////////////////
+
+/**
+ * Nagłówek przechowywany w pamięci bezpośrednio przed tablicą jednomianów
+ * każdego niestałego wielomianu. Zawiera dane o strukturze wielomianu
+ * obliczane przy jego tworzeniu na podstawie nagłówków jego współczynników,
+ * dzięki czemu zapytania o stopień nie wymagają przechodzenia całego drzewa.
+ * Ponieważ nagłówek jest częścią tej samej alokacji co tablica, wszystkie
+ * płytkie kopie struktury @p Poly (np. te zwracane przez stos wielomianów)
+ * współdzielą te same metadane. Nagłówek węzła zamrożonego obrazu zamiast
+ * wskaźnika na stopnie względem zmiennych przechowuje opis węzła.
+ */
+typedef struct {
+  size_t terms; ///< liczba wyrazów wielomianu po pełnym rozwinięciu
+  uint64_t hash; ///< skrót struktury wielomianu
+  union {
+    poly_exp_t *degBy; ///< stopnie względem kolejnych zmiennych lub @p NULL
+    uintptr_t frozen; ///< opis węzła obrazu (ze znacznikiem @p FROZEN_NODE)
+  };
+  poly_exp_t deg; ///< stopień wielomianu
+  poly_exp_t depth; ///< liczba zmiennych, czyli głębokość drzewa
+} PolyMeta;
+
+/**
+ * Zwraca nagłówek niestałego wielomianu.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @return wskaźnik na nagłówek tablicy jednomianów wielomianu @p p
+ */
+static inline PolyMeta *Meta(const Poly *p) {
+  return (PolyMeta *) p->arr - 1;
+}
+
+/**
+ * Alokuje tablicę jednomianów o danym rozmiarze wraz z poprzedzającym ją
+ * nagłówkiem. Jeśli nie uda się przydzielić pamięci, program kończy się
+ * awaryjnie kodem @p 1.
+ * @param[in] count : rozmiar tablicy
+ * @return wskaźnik na pierwszy element tablicy jednomianów
+ */
+static inline Mono *AllocMonos(const size_t count) {
+  PolyMeta *meta = malloc(sizeof(PolyMeta) + count * sizeof(Mono));
+
+  CHECK_PTR(meta);
+
+  meta->degBy = NULL;
+
+  return (Mono *) (meta + 1);
+}
+
+/**
+ * Zmienia rozmiar tablicy jednomianów zaalokowanej funkcją @p AllocMonos,
+ * zachowując zawartość nagłówka.
+ * @param[in] monos : tablica jednomianów
+ * @param[in] count : nowy rozmiar tablicy
+ * @return wskaźnik na pierwszy element tablicy (być może przeniesionej)
+ */
+static inline Mono *ResizeMonos(Mono *monos, const size_t count) {
+  PolyMeta *meta = realloc((PolyMeta *) monos - 1,
+                           sizeof(PolyMeta) + count * sizeof(Mono));
+
+  CHECK_PTR(meta);
+
+  return (Mono *) (meta + 1);
+}
+
+/**
+ * Zwalnia tablicę jednomianów zaalokowaną funkcją @p AllocMonos wraz
+ * z nagłówkiem. Nie usuwa jednomianów znajdujących się w tablicy.
+ * @param[in] monos : tablica jednomianów
+ */
+static inline void FreeMonos(Mono *monos) {
+  PolyMeta *meta = (PolyMeta *) monos - 1;
+
+  free(meta->degBy);
+  free(meta);
+}
+
+/**
+ * Przenosi tablicę jednomianów zaalokowaną przez użytkownika do bloku
+ * pamięci z nagłówkiem. Zwykle realizowane jest to jednym wywołaniem
+ * funkcji @p realloc i przesunięciem zawartości tablicy.
+ * @param[in] count : liczba jednomianów w tablicy
+ * @param[in] monos : tablica jednomianów zaalokowana funkcją @p malloc
+ * @return tablica jednomianów z nagłówkiem
+ */
+static inline Mono *AdoptMonos(const size_t count, Mono *monos) {
+  PolyMeta *meta = realloc(monos, sizeof(PolyMeta) + count * sizeof(Mono));
+
+  CHECK_PTR(meta);
+
+  memmove(meta + 1, meta, count * sizeof(Mono));
+  meta->degBy = NULL;
+
+  return (Mono *) (meta + 1);
+}
+
+/**
+ * Zwraca liczbę wyrazów wielomianu po pełnym rozwinięciu.
+ * @param[in] p : wielomian
+ * @return liczba wyrazów wielomianu @p p
+ */
+static inline size_t PolyTerms(const Poly *p) {
+  if (PolyIsCoeff(p)) {
+    return PolyIsZero(p) ? 0 : 1;
+  }
+
+  return Meta(p)->terms;
+}
+
+/**
+ * Zwraca liczbę zmiennych, od których formalnie zależy wielomian
+ * (głębokość drzewa, którym jest reprezentowany).
+ * @param[in] p : wielomian
+ * @return @p 0 dla wielomianu stałego; w przeciwnym razie głębokość
+ * wielomianu @p p
+ */
+static inline poly_exp_t PolyDepth(const Poly *p) {
+  return PolyIsCoeff(p) ? 0 : Meta(p)->depth;
+}
+
+/**
+ * Miesza bity 64-bitowej liczby (funkcja kończąca generatora splitmix64).
+ * @param[in] x : liczba
+ * @return wymieszane bity liczby @p x
+ */
+static inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+
+  return x;
+}
+
+/**
+ * Zwraca skrót jednomianu zależny od jego wykładnika i skrótu jego
+ * współczynnika.
+ * @param[in] m : jednomian
+ * @return skrót jednomianu @p m
+ */
+static inline uint64_t MonoHash(const Mono *m) {
+  return Mix64(PolyHash(&m->p) +
+               Mix64((uint64_t) MonoGetExp(m) + 0x9e3779b97f4a7c15ULL));
+}
+
+/**
+ * Uwzględnia jednomian w metadanych wielomianu, do którego został dodany.
+ * @param[in,out] meta : nagłówek wielomianu
+ * @param[in] m : niezerowy jednomian
+ */
+static inline void MetaAddMono(PolyMeta *meta, const Mono *m) {
+  const poly_exp_t deg = PolyDeg(&m->p) + MonoGetExp(m);
+  const poly_exp_t depth = PolyDepth(&m->p) + 1;
+
+  meta->terms += PolyTerms(&m->p);
+  meta->hash += MonoHash(m);
+
+  if (deg > meta->deg) {
+    meta->deg = deg;
+  }
+
+  if (depth > meta->depth) {
+    meta->depth = depth;
+  }
+}
+
+/**
+ * Usuwa jednomian z metadanych wielomianu, z którego został usunięty lub
+ * który zostanie zmodyfikowany. Jeśli jednomian mógł wyznaczać stopień
+ * lub głębokość wielomianu, ustawia @p *exact na @p false -- metadane trzeba
+ * wówczas obliczyć od nowa.
+ * @param[in,out] meta : nagłówek wielomianu
+ * @param[in] m : jednomian
+ * @param[out] exact : czy metadane pozostają dokładne
+ */
+static inline void MetaRemoveMono(PolyMeta *meta, const Mono *m,
+                                  bool *exact) {
+  meta->terms -= PolyTerms(&m->p);
+  meta->hash -= MonoHash(m);
+
+  if (PolyDeg(&m->p) + MonoGetExp(m) == meta->deg ||
+      PolyDepth(&m->p) + 1 == meta->depth) {
+    *exact = false;
+  }
+}
+
+/**
+ * Oblicza od nowa metadane wielomianu na podstawie metadanych jego
+ * współczynników i unieważnia zapamiętane stopnie względem zmiennych.
+ * @param[in] monos : niepusta tablica jednomianów z nagłówkiem
+ * @param[in] size : liczba jednomianów w tablicy
+ */
+static inline void ComputeMeta(Mono *monos, const size_t size) {
+  PolyMeta *meta = (PolyMeta *) monos - 1;
+
+  meta->terms = 0;
+  meta->hash = 0;
+  meta->deg = -1;
+  meta->depth = 0;
+
+  for (size_t i = 0; i < size; i++) {
+    MetaAddMono(meta, &monos[i]);
+  }
+
+  free(meta->degBy);
+  meta->degBy = NULL;
+}
+
+/**
+ * Tworzy wielomian z tablicy jednomianów spełniającej wszystkie niezmienniki
+ * wielomianu niestałego i uzupełnia jego nagłówek.
+ * @param[in] monos : tablica jednomianów z nagłówkiem
+ * @param[in] size : liczba jednomianów w tablicy
+ * @return wielomian złożony z jednomianów z tablicy @p monos
+ */
+static inline Poly PolyFromMonoArr(Mono *monos, const size_t size) {
+  ComputeMeta(monos, size);
+
+  return (Poly) {.size = size, .arr = monos};
+}
+
+//////////////////////////////
+//                          //
+//    Obrazy zamrożone      //
+//                          //
+//////////////////////////////
+
+/**
+ * Znacznik węzła obrazu. Jest ustawiony w polu @p frozen nagłówka każdego
+ * węzła oraz w polu @p arr każdego niestałego współczynnika zapisanego
+ * w obrazie, które zamiast wskaźnika przechowuje przesunięcie. Wskaźniki
+ * na tablice jednomianów i stopni są wyrównane, więc znacznik nigdy
+ * nie występuje w wielomianach na stercie.
+ */
+#define FROZEN_NODE ((uintptr_t) 1)
+
+/** Znacznik korzenia obrazu w polu @p frozen nagłówka węzła */
+#define FROZEN_ROOT ((uintptr_t) 2)
+
+/** Liczba bitów pola @p frozen zajmowanych przez znaczniki; pozostałe
+    bity przechowują odległość tablicy jednomianów węzła od końca obrazu */
+#define FROZEN_TAG_BITS 2
+
+/** Wyrównanie węzłów obrazu (nagłówków i tablic jednomianów) */
+#define FROZEN_ALIGN 8
+
+/**
+ * Nagłówek obrazu zamrożonego wielomianu. Węzeł wielomianu zapisanego
+ * w obrazie znajduje się bezpośrednio za nim.
+ */
+typedef struct {
+  char magic[8]; ///< sygnatura @p FROZEN_MAGIC
+  uint32_t version; ///< wersja formatu (@p POLY_FROZEN_VERSION)
+  uint32_t layout; ///< rozmiary typów (@p FROZEN_LAYOUT)
+  uint64_t size; ///< rozmiar obrazu
+  Poly root; ///< wielomian zapisany w obrazie (przesunięcie zamiast wskaźnika)
+} FrozenHeader;
+
+/**
+ * Zaokrągla rozmiar w górę do wielokrotności @p FROZEN_ALIGN.
+ * @param[in] size : rozmiar
+ * @return zaokrąglony rozmiar
+ */
+static inline size_t FrozenAlign(const size_t size) {
+  return (size + FROZEN_ALIGN - 1) / FROZEN_ALIGN * FROZEN_ALIGN;
+}
+
+/**
+ * Zwraca rozmiar węzła obrazu odpowiadającego niestałemu wielomianowi:
+ * nagłówka, tablicy jednomianów i tablicy stopni względem zmiennych.
+ * @param[in] size : liczba jednomianów
+ * @param[in] depth : głębokość wielomianu
+ * @return rozmiar węzła
+ */
+static inline size_t FrozenNodeSize(const size_t size, const poly_exp_t depth) {
+  return FrozenAlign(sizeof(PolyMeta) + size * sizeof(Mono) +
+                     (size_t) depth * sizeof(poly_exp_t));
+}
+
+/**
+ * Sprawdza, czy wielomian jest węzłem odwzorowanego obrazu. Wymaga jedynie
+ * odczytu nagłówka wielomianu.
+ * @param[in] p : wielomian
+ * @return czy wielomian @p p jest zamrożony
+ */
+static inline bool IsFrozen(const Poly *p) {
+  return !PolyIsCoeff(p) && (Meta(p)->frozen & FROZEN_NODE) != 0;
+}
+
+/**
+ * Zwraca odległość tablicy jednomianów węzła obrazu od końca obrazu.
+ * @param[in] p : węzeł obrazu
+ * @return liczba bajtów od początku tablicy jednomianów do końca obrazu
+ */
+static inline size_t FrozenRemaining(const Poly *p) {
+  return Meta(p)->frozen >> FROZEN_TAG_BITS;
+}
+
+/**
+ * Wyznacza niestały współczynnik zapisany w obrazie jako przesunięcie
+ * względem tablicy jednomianów węzła, do którego należy. Współczynnik musi
+ * zaczynać się za węzłem rodzica, mieścić się w obrazie i mieć mniejszą
+ * głębokość, a jego nagłówek musi być zgodny z jego położeniem -- dlatego
+ * uszkodzony obraz nie może wskazywać poza odwzorowanie ani zawierać cykli.
+ * Współczynnik, który nie spełnia tych warunków, jest traktowany jak zero.
+ * @param[in] p : węzeł obrazu
+ * @param[in] coeff : niestały współczynnik jednomianu węzła @p p
+ * @return współczynnik ze wskaźnikiem na jego tablicę jednomianów
+ */
+static Poly ResolveFrozen(const Poly *p, const Poly *coeff) {
+  const size_t offset = (uintptr_t) coeff->arr - FROZEN_NODE;
+  const size_t remaining = FrozenRemaining(p);
+
+  if (((uintptr_t) coeff->arr & (FROZEN_ALIGN - 1)) != FROZEN_NODE ||
+      offset < FrozenNodeSize(p->size, Meta(p)->depth) || offset > remaining) {
+    return PolyZero();
+  }
+
+  const Poly child = {.size = coeff->size,
+                      .arr = (Mono *) ((char *) p->arr + offset)};
+  const PolyMeta *meta = Meta(&child);
+  // Odległość tablicy jednomianów współczynnika od końca obrazu
+  const size_t left = remaining - offset;
+
+  if (meta->frozen != (left << FROZEN_TAG_BITS | FROZEN_NODE) ||
+      child.size == 0 || child.size > left / sizeof(Mono) ||
+      meta->depth <= 0 || meta->depth >= Meta(p)->depth ||
+      FrozenNodeSize(child.size, meta->depth) > left + sizeof(PolyMeta)) {
+    return PolyZero();
+  }
+
+  return child;
+}
+
+/**
+ * Zwraca współczynnik jednomianu wielomianu. Niestały współczynnik węzła
+ * obrazu jest wyznaczany z przesunięcia funkcją @p ResolveFrozen; pozostałe
+ * są zwracane bez zmian. Funkcje tylko do odczytu obsługujące zamrożone
+ * wielomiany odczytują nią wszystkie współczynniki.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] i : indeks jednomianu
+ * @return współczynnik @p i-tego jednomianu wielomianu @p p
+ */
+static inline Poly ResolveCoeff(const Poly *p, const size_t i) {
+  const Poly *coeff = &p->arr[i].p;
+
+  if (PolyIsCoeff(coeff) || !IsFrozen(p)) {
+    return *coeff;
+  }
+
+  return ResolveFrozen(p, coeff);
+}
+
+/**
+ * Zastępuje zamrożony wielomian jego kopią na stercie, aby można było
+ * modyfikować go w miejscu lub przenieść do innego wielomianu. Jeśli był
+ * to wielomian otrzymany z funkcji @p PolyLoadFrozen, usuwa odwzorowanie
+ * obrazu. Pozostałe wielomiany pozostawia bez zmian.
+ * @param[in,out] p : wielomian
+ */
+static inline void ThawFrozen(Poly *p) {
+  if (IsFrozen(p)) {
+    Poly copy = PolyClone(p);
+
+    PolyDestroy(p);
+    *p = copy;
+  }
+}
+
+/**
+ * Zwraca wielomian, na którym mogą działać funkcje nieobsługujące
+ * zamrożonych wielomianów: kopię zamrożonego wielomianu na stercie albo
+ * sam wielomian. Kopię należy usunąć funkcją @p PolyDestroy.
+ * @param[in] p : wielomian
+ * @param[out] copy : kopia wielomianu @p p lub wielomian zerowy
+ * @return @p copy, jeśli wielomian @p p jest zamrożony; w przeciwnym razie
+ * @p p
+ */
+static inline const Poly *Thawed(const Poly *p, Poly *copy) {
+  *copy = PolyZero();
+
+  if (IsFrozen(p)) {
+    *copy = PolyClone(p);
+    return copy;
+  }
+
+  return p;
+}
+
+/**
+ * Zwraca tablicę wielomianów, na której mogą działać funkcje nieobsługujące
+ * zamrożonych wielomianów. Jeśli któryś z wielomianów jest zamrożony,
+ * tworzy tablicę, w której zamrożone wielomiany są zastąpione kopiami,
+ * a pozostałe -- płytkimi kopiami; należy ją zwolnić funkcją
+ * @p FreeThawedArr.
+ * @param[in] n : liczba wielomianów
+ * @param[in] ps : tablica wielomianów
+ * @return nowa tablica lub @p ps, jeśli żaden wielomian nie jest zamrożony
+ */
+static const Poly *ThawedArr(const size_t n, const Poly ps[]) {
+  size_t i = 0;
+
+  while (i < n && !IsFrozen(&ps[i])) {
+    i++;
+  }
+
+  if (i == n) {
+    return ps;
+  }
+
+  Poly *copies = malloc(n * sizeof(Poly));
+
+  CHECK_PTR(copies);
+
+  for (i = 0; i < n; i++) {
+    copies[i] = IsFrozen(&ps[i]) ? PolyClone(&ps[i]) : ps[i];
+  }
+
+  return copies;
+}
+
+/**
+ * Zwalnia tablicę utworzoną funkcją @p ThawedArr wraz z kopiami zamrożonych
+ * wielomianów.
+ * @param[in] n : liczba wielomianów
+ * @param[in] ps : tablica przekazana funkcji @p ThawedArr
+ * @param[in] thawed : tablica zwrócona przez funkcję @p ThawedArr
+ */
+static void FreeThawedArr(const size_t n, const Poly ps[],
+                          const Poly thawed[]) {
+  if (thawed == ps) {
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (IsFrozen(&ps[i])) {
+      PolyDestroy((Poly *) &thawed[i]);
+    }
+  }
+
+  free((Poly *) thawed);
+}
+
 //////////////////////////////
 //                          //
 //       PolyDestroy        //
@@ -38,16 +499,26 @@
  * zaalokowana żadna pamięć. W przeciwnym wypadku, wielomian ten ma
  * niepustą tablicę jednomianów; każdy z nich zostaje usunięty z pamięci
  * za pomocą funkcji @p MonoDestroy. Następnie zostaje zwolniona pamięć
- * zaalokowana na tablicę jednomianów
+ * zaalokowana na tablicę jednomianów. Węzeł zamrożonego obrazu nie jest
+ * zwalniany -- jeśli jest to korzeń obrazu otrzymany z funkcji
+ * @p PolyLoadFrozen, usuwane jest odwzorowanie całego obrazu, które
+ * zaczyna się od nagłówka @p FrozenHeader poprzedzającego węzeł korzenia.
  */
 void PolyDestroy(Poly *p) {
   if (p != NULL) {
-    if (!PolyIsCoeff(p)) {
+    if (IsFrozen(p)) {
+      if (Meta(p)->frozen & FROZEN_ROOT) {
+        char *image = (char *) Meta(p) - FrozenAlign(sizeof(FrozenHeader));
+
+        munmap(image, (size_t) ((char *) p->arr + FrozenRemaining(p) - image));
+      }
+    }
+    else if (!PolyIsCoeff(p)) {
       for (size_t i = 0; i < p->size; i++) {
         MonoDestroy(&p->arr[i]);
       }
 
-      free(p->arr);
+      FreeMonos(p->arr);
     }
   }
 }
@@ -58,6 +529,29 @@ void PolyDestroy(Poly *p) {
 //                        //
 ////////////////////////////
 
+static Poly OwnMonos(size_t count, Mono *monos);
+
+/**
+ * Tworzy kopię węzła obrazu na stercie. Jednomiany są sumowane funkcją
+ * @p OwnMonos, a jednomiany o ujemnych wykładnikach pomijane, więc kopia
+ * spełnia niezmienniki wielomianu nawet wtedy, gdy obraz jest uszkodzony.
+ * @param[in] p : węzeł obrazu
+ * @return kopia wielomianu @p p
+ */
+static Poly CloneFrozen(const Poly *p) {
+  Mono *monos = AllocMonos(p->size);
+
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly coeff = ResolveCoeff(p, i);
+    const poly_exp_t exp = MonoGetExp(&p->arr[i]);
+
+    monos[i] = (Mono) {.p = exp < 0 ? PolyZero() : PolyClone(&coeff),
+                       .exp = exp};
+  }
+
+  return OwnMonos(p->size, monos);
+}
+
 /**
  * Jeżeli wielomian jest stały, to zwraca taki sam wielomian
  * wygenerowany funkcją @p PolyFromCoeff. W przeciwnym wypadku wielomian
@@ -67,7 +561,8 @@ void PolyDestroy(Poly *p) {
  * się awaryjnie kodem @p 1. Inaczej każdy z jednomianów, z których
  * składał się oryginalny wielomian, jest kopiowany do nowo stworzonej
  * tablicy za pomocą funkcji @p MonoClone. Funkcja zwraca wówczas wielomian
- * złożony z tej tablicy oraz jej rozmiaru.
+ * złożony z tej tablicy oraz jej rozmiaru. Zamrożony wielomian jest
+ * kopiowany funkcją @p CloneFrozen.
  */
 Poly PolyClone(const Poly *p) {
   assert(p != NULL);
@@ -75,19 +570,27 @@ Poly PolyClone(const Poly *p) {
   if (PolyIsCoeff(p)) {
     return PolyFromCoeff(p->coeff);
   }
+  else if (IsFrozen(p)) {
+    return CloneFrozen(p);
+  }
   else {
     const size_t numOfMono = p->size;
 
     // Tablica jednomianów wielomianu wyjściowego
-    Mono *newArr = malloc(numOfMono * sizeof(Mono));
-
-    CHECK_PTR(newArr);
+    Mono *newArr = AllocMonos(numOfMono);
 
     // Uzupełnienie tablicy kopiami jednomianów z oryginalnego wielomianu
     for (size_t i = 0; i < numOfMono; i++) {
       newArr[i] = MonoClone(&p->arr[i]);
     }
 
+    // Kopia ma taką samą strukturę -- metadane są przepisywane
+    PolyMeta *meta = (PolyMeta *) newArr - 1;
+    meta->terms = Meta(p)->terms;
+    meta->hash = Meta(p)->hash;
+    meta->deg = Meta(p)->deg;
+    meta->depth = Meta(p)->depth;
+
     return (Poly) {.size = numOfMono, .arr = newArr};
   }
 }
@@ -175,23 +678,19 @@ static inline Poly SumConstPoly0(const Poly *p, const Poly *q) {
     MonoDestroy(&tmpMono);
 
     // Wyjściowy wielomian nie ma wyrazu wolnego
-    newArr = malloc((q->size - 1) * sizeof(Mono));
-
-    CHECK_PTR(newArr);
+    newArr = AllocMonos(q->size - 1);
 
     for (size_t i = 1; i < q->size; i++) {
       newArr[i - 1] = MonoClone(&q->arr[i]);
     }
 
-    return (Poly) {.size = q->size - 1, .arr = newArr};
+    return PolyFromMonoArr(newArr, q->size - 1);
   }
   // Nowy wyraz wolny jest niezerowy
   else {
     // Wyjściowy wielomian składa się z takiej samej liczby
     // jednomianów co oryginalny
-    newArr = malloc(q->size * sizeof(Mono));
-
-    CHECK_PTR(newArr);
+    newArr = AllocMonos(q->size);
 
     // Wyraz wolny
     newArr[0] = tmpMono;
@@ -200,7 +699,7 @@ static inline Poly SumConstPoly0(const Poly *p, const Poly *q) {
       newArr[i] = MonoClone(&q->arr[i]);
     }
 
-    return (Poly) {.size = q->size, .arr = newArr};
+    return PolyFromMonoArr(newArr, q->size);
   }
 }
 
@@ -225,9 +724,7 @@ static inline Poly SumConstPoly(const Poly *p, const Poly *q) {
     // Tablica jednomianów wyjściowego wielomianu.
     // Będzie mieć o jeden jednomian więcej
     // -- będzie on wyrazem wolnym
-    Mono *newArr = malloc((1 + q->size) * sizeof(Mono));
-
-    CHECK_PTR(newArr);
+    Mono *newArr = AllocMonos(1 + q->size);
 
     // Wyraz wolny wyjściowego wielomianu
     newArr[0] = (Mono) {.p = PolyFromCoeff(p->coeff), .exp = 0};
@@ -236,7 +733,7 @@ static inline Poly SumConstPoly(const Poly *p, const Poly *q) {
       newArr[i] = MonoClone(&q->arr[i - 1]);
     }
 
-    return (Poly) {.size = 1 + q->size, .arr = newArr};
+    return PolyFromMonoArr(newArr, 1 + q->size);
   }
   // Wielomian q posiada wyraz wolny
   else {
@@ -309,45 +806,39 @@ static inline Mono NextMonoAdd(const Poly *p, const Poly *q,
 }
 
 /**
- * Zwraca wielomian składający się z jednomianów znajdujących się
- * w tablicy jednomianów. Modyfikuje zawartość otrzymanej tablicy, jak
- * również ją samą (być może zwalnia przydzieloną na nią pamięć).
- * Zakłada, że wskaźnik na tablicę jednomianów nie jest pusty oraz że jest
- * spełniona nierówność: @p liczba @p jednomianów @p w @p tablicy @f$\le@f$
- * @p rozmiar @p tablicy. Zakłada także, że jednomiany w tablicy są
- * uporządkowane rosnąco ze względu na odpowiadające im wykładniki
- * (w szczególności żaden wykładnik nie może się powtórzyć). Nie ma również
- * "pustych" miejsc w tablicy jednomianów na indeksach mniejszych od liczby
- * jednomianów w tej tablicy, tzn. pod każdym z indeksów @p 0..numOfMonos
- * znajduje się jakiś jednomian.
+ * Zwraca wielomian składający się z jednomianów znajdujących się w tablicy
+ * jednomianów z nagłówkiem. Zakłada to samo, co funkcja
+ * @p BuildPolyFromMonos.
  * @param[in] monos : tablica jednomianów
  * @param[in] numOfMonos : liczba jednomianów w tablicy @p monos
  * @param[in] sizeOfArr : rozmiar tablicy @p monos
+ * @param[in] metaValid : czy nagłówek tablicy zawiera już dokładne metadane
+ * wielomianu złożonego z jednomianów z tablicy @p monos
  * @return wielomian złożony z jednomianów znajdujących się w tablicy @p monos
- * 
+ *
  * @details
  * Jeśli liczba jednomianów jest równa zeru, zwraca wielomian zerowy.
  * Jeśli liczba jednomianów jest równa jeden, sprawdza, czy wyjściowy
  * wielomian nie będzie wielomianem stałym. Jeśli tak, zwalnia całą
  * przydzieloną na jednomiany i tablicę pamięć, a następnie zwraca odpowiedni
  * wielomian stały. W przeciwnym wypadku (jeśli jest taka potrzeba) modyfikuje
- * ilość pamięci przydzieloną na tablicę i zwraca wielomian składający się
- * z niej.
+ * ilość pamięci przydzieloną na tablicę, oblicza metadane wielomianu (chyba
+ * że są one już aktualne) i zwraca wielomian składający się z niej.
  */
-static inline Poly BuildPolyFromMonos(Mono *monos, const size_t numOfMonos,
-                                      const size_t sizeOfArr) {
+static inline Poly FinishPoly(Mono *monos, const size_t numOfMonos,
+                              const size_t sizeOfArr, const bool metaValid) {
   // Brak jednomianów -- wielomian jest zerowy
   if (numOfMonos == 0) {
-    free(monos);
+    FreeMonos(monos);
     return PolyZero();
   }
   // W tablicy monos znajduje się dokładnie jeden jednomian.
-  // Sprawdza, czy nie jest on tożsamościowy z pewna funkcją stałą
+  // Sprawdza, czy nie jest on tożsamościowy z pewna funkcją stałą
   else if (numOfMonos == 1 && PolyIsCoeff(&monos[0].p) &&
            MonoGetExp(&monos[0]) == 0) {
     const poly_coeff_t polyCoeff = monos[0].p.coeff;
     MonoDestroy(&monos[0]);
-    free(monos);
+    FreeMonos(monos);
 
     return PolyFromCoeff(polyCoeff);
   }
@@ -356,15 +847,49 @@ static inline Poly BuildPolyFromMonos(Mono *monos, const size_t numOfMonos,
   else {
     // Zmiana rozmiaru tablicy monos, jeśli jest taka potrzeba
     if (numOfMonos != sizeOfArr) {
-      monos = realloc(monos, numOfMonos * sizeof(Mono));
+      monos = ResizeMonos(monos, numOfMonos);
+    }
 
-      assert(monos != NULL);
+    if (!metaValid) {
+      return PolyFromMonoArr(monos, numOfMonos);
     }
 
+    // Zawartość tablicy się zmieniła -- zapamiętane stopnie
+    // względem zmiennych są nieaktualne
+    PolyMeta *meta = (PolyMeta *) monos - 1;
+    free(meta->degBy);
+    meta->degBy = NULL;
+
     return (Poly) {.size = numOfMonos, .arr = monos};
   }
 }
 
+/**
+ * Zwraca wielomian składający się z jednomianów znajdujących się
+ * w tablicy jednomianów. Modyfikuje zawartość otrzymanej tablicy, jak
+ * również ją samą (być może zwalnia przydzieloną na nią pamięć).
+ * Zakłada, że wskaźnik na tablicę jednomianów nie jest pusty oraz że jest
+ * spełniona nierówność: @p liczba @p jednomianów @p w @p tablicy @f$\le@f$
+ * @p rozmiar @p tablicy. Zakłada także, że jednomiany w tablicy są
+ * uporządkowane rosnąco ze względu na odpowiadające im wykładniki
+ * (w szczególności żaden wykładnik nie może się powtórzyć). Nie ma również
+ * "pustych" miejsc w tablicy jednomianów na indeksach mniejszych od liczby
+ * jednomianów w tej tablicy, tzn. pod każdym z indeksów @p 0..numOfMonos
+ * znajduje się jakiś jednomian.
+ * @param[in] monos : tablica jednomianów
+ * @param[in] numOfMonos : liczba jednomianów w tablicy @p monos
+ * @param[in] sizeOfArr : rozmiar tablicy @p monos
+ * @return wielomian złożony z jednomianów znajdujących się w tablicy @p monos
+ * 
+ * @details
+ * Metadane wielomianu są obliczane od nowa.
+ * @sa FinishPoly
+ */
+static inline Poly BuildPolyFromMonos(Mono *monos, const size_t numOfMonos,
+                                      const size_t sizeOfArr) {
+  return FinishPoly(monos, numOfMonos, sizeOfArr, false);
+}
+
 /**
  * Sumuje dwa wielomiany nie będące wielomianami stałymi. Zakłada, że
  * przekazane wskaźniki na wielomiany nie są puste.
@@ -391,7 +916,7 @@ static inline Poly SumPolyPoly(const Poly *p, const Poly *q) {
   const size_t newSize = NumOfUniqueExps(p, q);
 
   // Tablica jednomianów wyjściowego wielomianu
-  Mono *newArr = malloc(newSize * sizeof(Mono));
+  Mono *newArr = AllocMonos(newSize);
 
   // Indeksy rozważanych aktualnie jednomianów
   // -- odpowiednio w tablicy wielomianu p i q
@@ -426,35 +951,437 @@ static inline Poly SumPolyPoly(const Poly *p, const Poly *q) {
 }
 
 /**
- * Jeśli @f$p@f$ i @f$q@f$ są wielomianami stałymi, to zwraca wielomian
- * stale równy sumie współczynników tych wielomianów stworzony przy pomocy
- * funkcji @p PolyFromCoeff.
- * Jeśli dokładnie jeden z tych wielomianów jest wielomianem stałym,
- * to ich sumę oblicza i zwraca funkcja pomocnicza @p SumConstPoly.
- * Jeżeli zaś żaden z tych wielomianów nie jest wielomianem stałym,
- * sumę @f$p + q@f$ oblicza funkcja @p SumPolyPoly, a następnie zwraca wynik.
- * @sa PolyFromCoeff, SumConstPoly, SumPolyPoly
+ * Minimalny stosunek liczby jednomianów większego wielomianu do liczby
+ * jednomianów mniejszego, od którego przy sumowaniu opłaca się szukać
+ * kolejnych pozycji wyszukiwaniem wykładniczym zamiast scalać tablice
+ * element po elemencie.
  */
-Poly PolyAdd(const Poly *p, const Poly *q) {
-  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-    return PolyFromCoeff(p->coeff + q->coeff);
-  }
-  else if (PolyIsCoeff(p)) {
-    if (PolyIsZero(p)) {
-      return PolyClone(q);
-    }
+#define GALLOP_RATIO 8
 
-    return SumConstPoly(p, q);
-  }
-  else if (PolyIsCoeff(q)) {
+/**
+ * Sprawdza, czy wielomian @p big ma wielokrotnie więcej jednomianów
+ * od wielomianu @p small. Zakłada, że żaden z nich nie jest stały.
+ * @param[in] big : wielomian nie będący wielomianem stałym
+ * @param[in] small : wielomian nie będący wielomianem stałym
+ * @return @p true, jeśli @p big ma co najmniej @p GALLOP_RATIO razy więcej
+ * jednomianów od @p small; @p false w przeciwnym razie
+ */
+static inline bool IsMuchBigger(const Poly *big, const Poly *small) {
+  return big->size / GALLOP_RATIO >= small->size;
+}
+
+/**
+ * Zwraca najmniejszy indeks z przedziału @p [from,to) tablicy jednomianów,
+ * pod którym znajduje się jednomian o wykładniku nie mniejszym od @p exp
+ * (lub @p to, jeśli takiego nie ma). Zakłada, że jednomiany są uporządkowane
+ * rosnąco ze względu na wykładniki.
+ * @param[in] monos : tablica jednomianów
+ * @param[in] from : początek przeszukiwanego przedziału
+ * @param[in] to : koniec przeszukiwanego przedziału
+ * @param[in] exp : szukany wykładnik
+ * @return indeks pierwszego jednomianu o wykładniku @f$\ge@f$ @p exp
+ *
+ * @details
+ * Sprawdza kolejno indeksy odległe od @p from o @p 1, @p 2, @p 4, ...
+ * aż do przekroczenia szukanego wykładnika, a następnie wyszukuje binarnie
+ * w ostatnim przedziale. Koszt jest więc logarytmiczny względem odległości
+ * od @p from, a nie względem rozmiaru całej tablicy.
+ */
+static inline size_t GallopExp(const Mono *monos, const size_t from,
+                               const size_t to, const poly_exp_t exp) {
+  // Wszystkie jednomiany na indeksach mniejszych od `low` mają mniejsze
+  // wykładniki; szukany indeks leży w przedziale [low, high]
+  size_t low = from, high = from;
+  // Długość kolejnego kroku
+  size_t step = 1;
+
+  while (high < to && MonoGetExp(&monos[high]) < exp) {
+    low = high + 1;
+    high = (to - high > step) ? high + step : to;
+    step *= 2;
+  }
+
+  while (low < high) {
+    const size_t mid = low + (high - low) / 2;
+
+    if (MonoGetExp(&monos[mid]) < exp) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * Kopiuje spójny fragment tablicy jednomianów. Jednomiany są najpierw
+ * kopiowane w całości funkcją @p memcpy -- dla współczynników stałych
+ * jest to już pełna kopia -- a następnie współczynniki niestałe są
+ * zastępowane swoimi kopiami.
+ * @param[out] dst : tablica docelowa
+ * @param[in] src : kopiowany fragment tablicy
+ * @param[in] count : liczba kopiowanych jednomianów
+ */
+static inline void CopyMonoRun(Mono *dst, const Mono *src,
+                               const size_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  memcpy(dst, src, count * sizeof(Mono));
+
+  for (size_t i = 0; i < count; i++) {
+    if (!PolyIsCoeff(&src[i].p)) {
+      dst[i].p = PolyClone(&src[i].p);
+    }
+  }
+}
+
+/**
+ * Sumuje dwa wielomiany nie będące wielomianami stałymi, z których
+ * @p big ma wielokrotnie więcej jednomianów od @p small.
+ * @param[in] big : wielomian nie będący wielomianem stałym
+ * @param[in] small : wielomian nie będący wielomianem stałym
+ * @return @f$big + small@f$
+ *
+ * @details
+ * Dla każdego jednomianu z @p small wyszukuje wykładniczo jego pozycję
+ * w tablicy @p big, kopiuje w całości poprzedzający ją fragment tablicy
+ * @p big funkcją @p CopyMonoRun, a następnie dopisuje jednomian z @p small
+ * (lub sumę jednomianów, jeśli wykładniki są równe). Liczba porównań
+ * wykładników wynosi więc @f$O(k \log n)@f$ zamiast @f$O(n + k)@f$.
+ * @sa GallopExp, CopyMonoRun, BuildPolyFromMonos
+ */
+static inline Poly GallopSumPolyPoly(const Poly *big, const Poly *small) {
+  // Górne ograniczenie liczby jednomianów wielomianu wyjściowego
+  const size_t maxSize = big->size + small->size;
+  // Tablica jednomianów wyjściowego wielomianu
+  Mono *newArr = AllocMonos(maxSize);
+
+  // Indeks pierwszego nieprzepisanego jednomianu z tablicy `big`
+  size_t i = 0;
+  // Indeks, pod którym są zapisywane kolejne jednomiany w tablicy newArr
+  size_t index = 0;
+
+  for (size_t j = 0; j < small->size; j++) {
+    const poly_exp_t exp = MonoGetExp(&small->arr[j]);
+    const size_t pos = GallopExp(big->arr, i, big->size, exp);
+
+    // Przepisanie jednomianów o mniejszych wykładnikach
+    CopyMonoRun(&newArr[index], &big->arr[i], pos - i);
+    index += pos - i;
+    i = pos;
+
+    if (i < big->size && MonoGetExp(&big->arr[i]) == exp) {
+      Poly sum = PolyAdd(&big->arr[i].p, &small->arr[j].p);
+
+      if (!PolyIsZero(&sum)) {
+        newArr[index] = (Mono) {.p = sum, .exp = exp};
+        index++;
+      }
+
+      i++;
+    }
+    else {
+      newArr[index] = MonoClone(&small->arr[j]);
+      index++;
+    }
+  }
+
+  // Przepisanie pozostałych jednomianów z tablicy `big`
+  CopyMonoRun(&newArr[index], &big->arr[i], big->size - i);
+  index += big->size - i;
+
+  return BuildPolyFromMonos(newArr, index, maxSize);
+}
+
+/**
+ * Jeśli @f$p@f$ i @f$q@f$ są wielomianami stałymi, to zwraca wielomian
+ * stale równy sumie współczynników tych wielomianów stworzony przy pomocy
+ * funkcji @p PolyFromCoeff.
+ * Jeśli dokładnie jeden z tych wielomianów jest wielomianem stałym,
+ * to ich sumę oblicza i zwraca funkcja pomocnicza @p SumConstPoly.
+ * Jeżeli zaś żaden z tych wielomianów nie jest wielomianem stałym,
+ * sumę @f$p + q@f$ oblicza funkcja @p SumPolyPoly, a następnie zwraca wynik.
+ * @sa PolyFromCoeff, SumConstPoly, SumPolyPoly
+ */
+Poly PolyAdd(const Poly *p, const Poly *q) {
+  // Zamrożone wielomiany są zastępowane kopiami
+  if (IsFrozen(p) || IsFrozen(q)) {
+    Poly copies[2];
+    Poly result = PolyAdd(Thawed(p, &copies[0]), Thawed(q, &copies[1]));
+
+    PolyDestroy(&copies[0]);
+    PolyDestroy(&copies[1]);
+    return result;
+  }
+
+  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+    return PolyFromCoeff(p->coeff + q->coeff);
+  }
+  else if (PolyIsCoeff(p)) {
+    if (PolyIsZero(p)) {
+      return PolyClone(q);
+    }
+
+    return SumConstPoly(p, q);
+  }
+  else if (PolyIsCoeff(q)) {
     return PolyAdd(q, p);
   }
+  else if (IsMuchBigger(p, q)) {
+    return GallopSumPolyPoly(p, q);
+  }
+  else if (IsMuchBigger(q, p)) {
+    return GallopSumPolyPoly(q, p);
+  }
   else {
-
     return SumPolyPoly(p, q);
   }
 }
 
+/**
+ * Sumuje wielomian nie będący wielomianem stałym z wielomianem stałym,
+ * przejmując oba na własność. Tablica jednomianów wielomianu @p p jest
+ * modyfikowana w miejscu.
+ * @param[in,out] p : wielomian nie będący wielomianem stałym
+ * @param[in,out] c : wielomian stały
+ * @return @f$p + c@f$
+ */
+static inline Poly AddCoeffOwn(Poly *p, Poly *c) {
+  if (PolyIsZero(c)) {
+    return *p;
+  }
+
+  Mono *arr = p->arr;
+  const size_t size = p->size;
+  // Czy metadane aktualizowane przyrostowo pozostają dokładne
+  bool exact = true;
+
+  // Wielomian `p` ma wyraz wolny -- jest on modyfikowany w miejscu
+  if (MonoGetExp(&arr[0]) == 0) {
+    MetaRemoveMono(Meta(p), &arr[0], &exact);
+    arr[0].p = PolyAddOwn(&arr[0].p, c);
+
+    // Wyraz wolny się wyzerował -- usunięcie go z tablicy
+    if (PolyIsZero(&arr[0].p)) {
+      memmove(arr, arr + 1, (size - 1) * sizeof(Mono));
+      return FinishPoly(arr, size - 1, size, exact);
+    }
+
+    MetaAddMono(Meta(p), &arr[0]);
+
+    return FinishPoly(arr, size, size, exact);
+  }
+  // Wielomian `p` nie ma wyrazu wolnego -- zostaje on wstawiony na początek
+  else {
+    arr = ResizeMonos(arr, size + 1);
+
+    memmove(arr + 1, arr, size * sizeof(Mono));
+    arr[0] = (Mono) {.p = *c, .exp = 0};
+    MetaAddMono((PolyMeta *) arr - 1, &arr[0]);
+
+    return FinishPoly(arr, size + 1, size + 1, true);
+  }
+}
+
+/**
+ * Sumuje dwa wielomiany nie będące wielomianami stałymi o zbliżonej liczbie
+ * jednomianów, przejmując oba na własność. Jednomiany są przenoszone
+ * do nowej tablicy bez kopiowania ich współczynników, a tablice
+ * wielomianów @p p i @p q są zwalniane.
+ * @param[in,out] p : wielomian nie będący wielomianem stałym
+ * @param[in,out] q : wielomian nie będący wielomianem stałym
+ * @return @f$p + q@f$
+ */
+static inline Poly MergePolysOwn(Poly *p, Poly *q) {
+  // Górne ograniczenie liczby jednomianów wielomianu wyjściowego
+  const size_t maxSize = p->size + q->size;
+  // Tablica jednomianów wyjściowego wielomianu
+  Mono *newArr = AllocMonos(maxSize);
+
+  size_t i = 0, j = 0, index = 0;
+
+  while (i < p->size && j < q->size) {
+    if (MonoGetExp(&p->arr[i]) < MonoGetExp(&q->arr[j])) {
+      newArr[index++] = p->arr[i++];
+    }
+    else if (MonoGetExp(&p->arr[i]) > MonoGetExp(&q->arr[j])) {
+      newArr[index++] = q->arr[j++];
+    }
+    else {
+      Poly sum = PolyAddOwn(&p->arr[i].p, &q->arr[j].p);
+
+      if (!PolyIsZero(&sum)) {
+        newArr[index++] = (Mono) {.p = sum, .exp = MonoGetExp(&p->arr[i])};
+      }
+
+      i++;
+      j++;
+    }
+  }
+
+  // Przeniesienie pozostałych jednomianów
+  memcpy(&newArr[index], &p->arr[i], (p->size - i) * sizeof(Mono));
+  index += p->size - i;
+  memcpy(&newArr[index], &q->arr[j], (q->size - j) * sizeof(Mono));
+  index += q->size - j;
+
+  FreeMonos(p->arr);
+  FreeMonos(q->arr);
+
+  return BuildPolyFromMonos(newArr, index, maxSize);
+}
+
+/**
+ * Sumuje dwa wielomiany nie będące wielomianami stałymi, z których
+ * @p big ma wielokrotnie więcej jednomianów od @p small, przejmując oba
+ * na własność. Tablica wielomianu @p big jest modyfikowana w miejscu.
+ * @param[in,out] big : wielomian nie będący wielomianem stałym
+ * @param[in,out] small : wielomian nie będący wielomianem stałym
+ * @return @f$big + small@f$
+ *
+ * @details
+ * W pierwszym przebiegu wyszukuje wykładniczo pozycję każdego jednomianu
+ * z @p small w tablicy @p big. Jednomiany o wspólnych wykładnikach są
+ * sumowane w miejscu, a dla pozostałych zapamiętywana jest pozycja
+ * wstawienia. Następnie powiększa tablicę @p big i, idąc od jej końca,
+ * przesuwa funkcją @p memmove całe fragmenty leżące pomiędzy kolejnymi
+ * pozycjami wstawienia. Tylko jeśli któraś z sum się wyzerowała, tablica
+ * jest na końcu jednokrotnie zagęszczana.
+ * @sa GallopExp, BuildPolyFromMonos
+ */
+static inline Poly GallopMergeOwn(Poly *big, Poly *small) {
+  const size_t n = big->size, k = small->size;
+  Mono *arr = big->arr;
+  // Pozycje wstawienia jednomianów z `small` w tablicy `big`;
+  // SIZE_MAX oznacza jednomian dodany już do jednomianu z `big`
+  size_t *pos = malloc(k * sizeof(size_t));
+
+  CHECK_PTR(pos);
+
+  // Liczba jednomianów, które trzeba wstawić do tablicy `big`
+  size_t inserts = 0;
+  // Czy któraś z sum jednomianów jest równa zeru
+  bool zeros = false;
+  // Początek przeszukiwanego fragmentu tablicy `big`
+  size_t from = 0;
+  // Nagłówek wielomianu `big`, aktualizowany przyrostowo
+  PolyMeta *meta = Meta(big);
+  // Czy metadane aktualizowane przyrostowo pozostają dokładne
+  bool exact = true;
+
+  for (size_t j = 0; j < k; j++) {
+    Mono *m = &small->arr[j];
+
+    from = GallopExp(arr, from, n, MonoGetExp(m));
+
+    if (from < n && MonoGetExp(&arr[from]) == MonoGetExp(m)) {
+      MetaRemoveMono(meta, &arr[from], &exact);
+      arr[from].p = PolyAddOwn(&arr[from].p, &m->p);
+
+      if (PolyIsZero(&arr[from].p)) {
+        zeros = true;
+      }
+      else {
+        MetaAddMono(meta, &arr[from]);
+      }
+
+      pos[j] = SIZE_MAX;
+      from++;
+    }
+    else {
+      MetaAddMono(meta, m);
+      pos[j] = from;
+      inserts++;
+    }
+  }
+
+  if (inserts > 0) {
+    arr = ResizeMonos(arr, n + inserts);
+
+    // Miejsce, przed którym zostanie zapisany kolejny przesuwany fragment,
+    // oraz koniec jeszcze nieprzesuniętej części tablicy
+    size_t write = n + inserts, read = n;
+
+    for (size_t j = k; j-- > 0;) {
+      if (pos[j] == SIZE_MAX) {
+        continue;
+      }
+
+      write -= read - pos[j];
+      memmove(&arr[write], &arr[pos[j]], (read - pos[j]) * sizeof(Mono));
+      read = pos[j];
+      write--;
+      arr[write] = small->arr[j];
+    }
+  }
+
+  // Liczba jednomianów w tablicy
+  size_t size = n + inserts;
+
+  if (zeros) {
+    size_t index = 0;
+
+    for (size_t i = 0; i < n + inserts; i++) {
+      if (!PolyIsZero(&arr[i].p)) {
+        arr[index++] = arr[i];
+      }
+    }
+
+    size = index;
+  }
+
+  free(pos);
+  FreeMonos(small->arr);
+
+  return FinishPoly(arr, size, n + inserts, exact);
+}
+
+/**
+ * Jeśli któryś z wielomianów jest stały, dodaje go do drugiego w miejscu
+ * za pomocą funkcji @p AddCoeffOwn. Jeśli żaden nie jest stały, to
+ * w zależności od stosunku liczby ich jednomianów scala je funkcją
+ * @p GallopMergeOwn lub @p MergePolysOwn. Na koniec ustawia oba argumenty
+ * na wielomian zerowy.
+ * @sa AddCoeffOwn, GallopMergeOwn, MergePolysOwn
+ */
+Poly PolyAddOwn(Poly *p, Poly *q) {
+  assert(p != NULL && q != NULL && p != q);
+
+  // Zamrożone wielomiany nie mogą być modyfikowane w miejscu
+  ThawFrozen(p);
+  ThawFrozen(q);
+
+  Poly result;
+
+  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+    result = PolyFromCoeff(p->coeff + q->coeff);
+  }
+  else if (PolyIsCoeff(p)) {
+    result = AddCoeffOwn(q, p);
+  }
+  else if (PolyIsCoeff(q)) {
+    result = AddCoeffOwn(p, q);
+  }
+  else if (IsMuchBigger(p, q)) {
+    result = GallopMergeOwn(p, q);
+  }
+  else if (IsMuchBigger(q, p)) {
+    result = GallopMergeOwn(q, p);
+  }
+  else {
+    result = MergePolysOwn(p, q);
+  }
+
+  *p = PolyZero();
+  *q = PolyZero();
+
+  return result;
+}
+
 ///////////////////////////////
 //                           //
 //       PolyAddMonos        //
@@ -474,15 +1401,17 @@ Poly PolyAdd(const Poly *p, const Poly *q) {
  * 
  * @details
  * Alokuje pamięć dla tablicy jednomianów o tym samym rozmiarze,
- * kopiuje jej elementy, a następnie zwraca wynik.
+ * kopiuje jej elementy, a następnie zwraca wynik. Zamrożone współczynniki
+ * są zastępowane kopiami funkcją @p ThawFrozen, gdyż węzły obrazu nie mogą
+ * należeć do wielomianów na stercie.
  */
 static inline Mono *CopyMonoArr(const size_t size, const Mono monos[]) {
-  Mono *monosCopy = malloc(size * sizeof(Mono));
-  CHECK_PTR(monosCopy);
+  Mono *monosCopy = AllocMonos(size);
 
   // Kopiuje tablicę
   for (size_t i = 0; i < size; i++) {
     monosCopy[i] = monos[i];
+    ThawFrozen(&monosCopy[i].p);
   }
 
   return monosCopy;
@@ -490,9 +1419,9 @@ static inline Mono *CopyMonoArr(const size_t size, const Mono monos[]) {
 
 /**
  * Jeśli @p count jest równy zeru lub @p monos jest równy @p NULL, zwraca
- * wielomian zerowy. W przeciwnym razie tworzy posortowaną kopię tablicy
- * jednomianów i wywołuje na niej funkcję @p PolyOwnMonos, której wynik zwraca.
- * @sa CopyMonoArr, PolyOwnMonos
+ * wielomian zerowy. W przeciwnym razie tworzy kopię tablicy jednomianów
+ * i wywołuje na niej funkcję @p OwnMonos, której wynik zwraca.
+ * @sa CopyMonoArr, OwnMonos
  */
 Poly PolyAddMonos(size_t count, const Mono monos[]) {
   if (count == 0 || monos == NULL) { return PolyZero(); }
@@ -501,7 +1430,26 @@ Poly PolyAddMonos(size_t count, const Mono monos[]) {
   Mono *monosCopy = CopyMonoArr(count, monos);
 
   // Sumuje jednomiany i zwraca wielomian wynikowy
-  return PolyOwnMonos(count, monosCopy);
+  return OwnMonos(count, monosCopy);
+}
+
+/**
+ * Jeśli @p count jest równy zeru lub @p monos jest równy @p NULL, zwraca
+ * wielomian zerowy. W przeciwnym razie sprawdza (tylko w trybie
+ * debugowania), czy jednomiany spełniają niezmienniki wielomianu, tworzy
+ * kopię tablicy jednomianów i buduje z niej wielomian funkcją
+ * @p BuildPolyFromMonos -- bez sortowania i sumowania jednomianów.
+ * @sa CopyMonoArr, BuildPolyFromMonos
+ */
+Poly PolyAddSortedMonos(size_t count, const Mono monos[]) {
+  if (count == 0 || monos == NULL) { return PolyZero(); }
+
+  for (size_t i = 0; i < count; i++) {
+    assert(!PolyIsZero(&monos[i].p));
+    assert(i == 0 || MonoGetExp(&monos[i - 1]) < MonoGetExp(&monos[i]));
+  }
+
+  return BuildPolyFromMonos(CopyMonoArr(count, monos), count, count);
 }
 
 
@@ -513,113 +1461,434 @@ Poly PolyAddMonos(size_t count, const Mono monos[]) {
 
 
 /**
- * Funkcja porównawcza dla jednomianów.
- * Porównuje wykładniki dwóch jednomianów.
- * Zakłada, że @p p i @p q nie są pustymi wskaźnikami.
- * @param[in] p : jednomian
- * @param[in] q : jednomian
- * @return
- * jeśli @p MonoGetExp(p) > @p MonoGetExp(q) -- zwraca @p 1;
- * jeśli @p MonoGetExp(p) > @p MonoGetExp(q) -- zwraca @p -1;
- * w przeciwnym razie zwraca @p 0.
+ * Największy rozmiar tablicy jednomianów sortowanej przez wstawianie.
  */
-static int MonoCmp(const void *p, const void *q) {
-  if (MonoGetExp(p) > MonoGetExp(q))      { return  1; }
-  else if (MonoGetExp(p) < MonoGetExp(q)) { return -1; }
-  else                                    { return  0; }
-}
+#define INSERTION_SORT_MAX 16
 
 /**
- * Sortuje jednomiany w danej tablicy.
- * Posortowana tablica jest uporządkowana względem wykładników jednomianów
- * w porządku niemalejącym.
- * Zakłada, że @p size > 0, @p monos != @p NULL.
- * @param[in] size : rozmiar tablicy
- * @param[in] monos : tablica jednomianów
+ * Największy rozmiar tablicy jednomianów sortowanej przez scalanie
+ * z porównywaniem wykładników; od tego rozmiaru sortowanie pozycyjne
+ * jest szybsze.
  */
-static inline void SortMonos(const size_t size, Mono *monos) {
-  qsort(monos, size, sizeof(Mono), MonoCmp);
+#define COMPARISON_SORT_MAX 64
+
+/**
+ * Najmniejsza średnia długość posortowanych fragmentów tablicy, przy której
+ * fragmenty te są scalane zamiast sortowania pozycyjnego całej tablicy.
+ */
+#define MIN_AVG_RUN_LENGTH 8
+
+/** Największa liczba bitów klucza przetwarzanych w jednym przebiegu
+    sortowania pozycyjnego */
+#define RADIX_BITS 11
+
+/** Największa liczba kubełków w jednym przebiegu sortowania pozycyjnego */
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+/**
+ * Zwraca klucz sortowania jednomianu: wykładnik z odwróconym bitem znaku,
+ * dzięki czemu porządek kluczy bez znaku jest zgodny z porządkiem
+ * wykładników.
+ * @param[in] m : jednomian
+ * @return klucz jednomianu @p m
+ */
+static inline uint32_t MonoKey(const Mono *m) {
+  return (uint32_t) MonoGetExp(m) ^ 0x80000000u;
 }
 
 /**
- * Jeśli @p count jest równy zeru lub @p monos jest równy @p NULL, zwraca
- * wielomian zerowy. W przeciwnym razie sortuje tablicę jednomianów,
- * a następnie sumuje jednomiany i zwraca wynik przy pomocy
- * funkcji @p BuildPolyFromMonos.
- * @sa SortMonos, BuildPolyFromMonos
+ * Sortuje przez wstawianie tablicę jednomianów względem ich wykładników.
+ * Sortowanie jest stabilne.
+ * @param[in] size : rozmiar tablicy
+ * @param[in,out] monos : tablica jednomianów
  */
-Poly PolyOwnMonos(size_t count, Mono *monos) {
-  if (count == 0 || monos == NULL) { return PolyZero(); }
+static inline void InsertionSortMonos(const size_t size, Mono *monos) {
+  for (size_t i = 1; i < size; i++) {
+    const Mono m = monos[i];
+    size_t j = i;
 
-  // Sortowanie jednomianów ze względu na ich wykładniki
-  SortMonos(count, monos);
+    for (; j > 0 && MonoGetExp(&monos[j - 1]) > MonoGetExp(&m); j--) {
+      monos[j] = monos[j - 1];
+    }
 
-  // Indeks, pod którym będą zapisywane kolejne jednomiany
-  // w tablicy monos
-  size_t index = 0;
-  // Tymczasowa zmienna dla obliczanego wielomianu
-  Poly tmpPoly;
+    monos[j] = m;
+  }
+}
 
-  for (size_t i = 1; i < count; i++) {
-    // Sumuje jednomiany o tym samym wykładniku
-    if (MonoGetExp(&monos[index]) == MonoGetExp(&monos[i])) {
-      tmpPoly = PolyAdd(&monos[index].p, &monos[i].p);
-      PolyDestroy(&monos[index].p);
-      MonoDestroy(&monos[i]);
+/**
+ * Scala dwa posortowane ciągi jednomianów w jeden. Przy równych
+ * wykładnikach pierwszeństwo ma jednomian z ciągu @p a.
+ * @param[in] a : posortowany ciąg jednomianów
+ * @param[in] na : długość ciągu @p a
+ * @param[in] b : posortowany ciąg jednomianów
+ * @param[in] nb : długość ciągu @p b
+ * @param[out] out : tablica wynikowa o rozmiarze co najmniej @p na + @p nb
+ */
+static inline void MergeMonoRuns(const Mono *a, const size_t na,
+                                 const Mono *b, const size_t nb, Mono *out) {
+  size_t i = 0, j = 0;
 
-      // Modyfikuje wartość wielomianu; wykładnik pozostaje bez zmian
-      monos[index].p = tmpPoly;
+  while (i < na && j < nb) {
+    if (MonoGetExp(&b[j]) < MonoGetExp(&a[i])) {
+      *out++ = b[j++];
     }
-    // Znaleziono nowy wykładnik
     else {
-      // Jeśli ostatni jednomian nie jest zerem, przesuwa indeks,
-      // aby nowy jednomian zapisać na kolejnej pozycji
-      if (!PolyIsZero(&monos[index].p)) {
-        index++;
-      }
-      // W przeciwnym razie usuwa ostatni jednomian;
-      // nowy jednomian będzie zapisany w tym samym miejscu
-      else {
-        MonoDestroy(&monos[index]);
-      }
-
-      monos[index] = monos[i];
+      *out++ = a[i++];
     }
   }
 
-  // W tym momencie zmienna `index` zaznacza ostatnie miejsce w tablicy
-  // monos, na którym zapisano jednomian
+  memcpy(out, a + i, (na - i) * sizeof(Mono));
+  memcpy(out + (na - i), b + j, (nb - j) * sizeof(Mono));
+}
 
-  // Jeśli jest to jednomian zerowy, usuwa go
-  if (PolyIsZero(&monos[index].p)) {
-    MonoDestroy(&monos[index]);
-  }
-  // W przeciwnym razie zwiększa zmienną `index` o 1 tak, aby
-  // jej wartość była równa liczbie jednomianów w tablicy monos
-  else {
-    index++;
+/**
+ * Sortuje przez scalanie małą tablicę jednomianów względem ich wykładników.
+ * Sortowanie jest stabilne. Zakłada, że @p size <= @p COMPARISON_SORT_MAX.
+ * @param[in] size : rozmiar tablicy
+ * @param[in,out] monos : tablica jednomianów
+ *
+ * @details
+ * Fragmenty długości @p INSERTION_SORT_MAX są sortowane przez wstawianie,
+ * a następnie scalane parami funkcją @p MergeMonoRuns, na przemian
+ * w tablicy @p monos i w tablicy pomocniczej na stosie -- bez alokacji
+ * pamięci.
+ * @sa InsertionSortMonos, MergeMonoRuns
+ */
+static void SmallSortMonos(const size_t size, Mono *monos) {
+  assert(size <= COMPARISON_SORT_MAX);
+
+  // Tablica pomocnicza
+  Mono buf[COMPARISON_SORT_MAX];
+
+  for (size_t i = 0; i < size; i += INSERTION_SORT_MAX) {
+    const size_t rest = size - i;
+
+    InsertionSortMonos(rest < INSERTION_SORT_MAX ? rest : INSERTION_SORT_MAX,
+                       monos + i);
   }
 
-  // W tym momencie zmienna `index` jest równa liczbie jednomianów
-  // w tablicy monos
+  // Tablica, z której odczytywane są fragmenty, i tablica, do której
+  // są zapisywane scalone fragmenty
+  Mono *src = monos, *dst = buf;
 
-  // Zwraca wielomian zbudowany z jednomianów w tablicy monos
-  return BuildPolyFromMonos(monos, index, count);
-}
+  for (size_t width = INSERTION_SORT_MAX; width < size; width *= 2) {
+    for (size_t i = 0; i < size; i += 2 * width) {
+      const size_t mid = i + width < size ? i + width : size;
+      const size_t end = mid + width < size ? mid + width : size;
 
+      MergeMonoRuns(src + i, mid - i, src + mid, end - mid, dst + i);
+    }
 
-//////////////////////////
-//                      //
-//    PolyCloneMonos    //
-//                      //
-//////////////////////////
+    Mono *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
 
+  if (src != monos) {
+    memcpy(monos, src, size * sizeof(Mono));
+  }
+}
 
 /**
- * Tworzy kopię tablicy jednomianów złożoną z pełnych kopii jednomianów,
- * z których składa się oryginalna tablica. Funkcja zakłada, że @p size jest
- * wartością większą od zera, a @p monos nie jest równy @p NULL.
- * @param[in] size : liczba jednomianów w tablicy
+ * Sortuje tablicę jednomianów złożoną z posortowanych fragmentów, scalając
+ * je parami aż do otrzymania jednego fragmentu.
+ * @param[in] size : rozmiar tablicy
+ * @param[in,out] monos : tablica jednomianów
+ * @param[in] runs : liczba posortowanych fragmentów tablicy
+ *
+ * @details
+ * Wyznacza granice fragmentów, a następnie w każdej rundzie scala sąsiednie
+ * pary fragmentów, przepisując je na przemian między tablicą @p monos
+ * a tablicą pomocniczą. Koszt wynosi @f$O(n \log r)@f$, gdzie @f$r@f$ jest
+ * liczbą fragmentów.
+ * @sa MergeMonoRuns
+ */
+static void MergeSortedRuns(const size_t size, Mono *monos, size_t runs) {
+  // Początki kolejnych fragmentów; ostatni element to rozmiar tablicy
+  size_t *bounds = malloc((runs + 1) * sizeof(size_t));
+  // Tablica pomocnicza
+  Mono *buf = malloc(size * sizeof(Mono));
+
+  CHECK_PTR(bounds);
+  CHECK_PTR(buf);
+
+  bounds[0] = 0;
+
+  for (size_t i = 1, r = 1; i < size; i++) {
+    if (MonoGetExp(&monos[i]) < MonoGetExp(&monos[i - 1])) {
+      bounds[r++] = i;
+    }
+  }
+
+  bounds[runs] = size;
+
+  // Tablica, z której odczytywane są fragmenty, i tablica, do której
+  // są zapisywane scalone fragmenty
+  Mono *src = monos, *dst = buf;
+
+  while (runs > 1) {
+    size_t newRuns = 0;
+
+    for (size_t r = 0; r < runs; r += 2) {
+      if (r + 1 < runs) {
+        MergeMonoRuns(src + bounds[r], bounds[r + 1] - bounds[r],
+                      src + bounds[r + 1], bounds[r + 2] - bounds[r + 1],
+                      dst + bounds[r]);
+      }
+      else {
+        memcpy(dst + bounds[r], src + bounds[r],
+               (bounds[r + 1] - bounds[r]) * sizeof(Mono));
+      }
+
+      bounds[newRuns++] = bounds[r];
+    }
+
+    bounds[newRuns] = size;
+    runs = newRuns;
+
+    Mono *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != monos) {
+    memcpy(monos, src, size * sizeof(Mono));
+  }
+
+  free(bounds);
+  free(buf);
+}
+
+/**
+ * Sortuje pozycyjnie (od najmniej znaczących cyfr) tablicę jednomianów
+ * względem kluczy @p MonoKey. Sortowanie jest stabilne.
+ * @param[in] size : rozmiar tablicy
+ * @param[in,out] monos : tablica jednomianów
+ *
+ * @details
+ * Cyfry są wyznaczane z różnic kluczy i najmniejszego klucza, a ich
+ * szerokość z rozpiętości kluczy: liczba przebiegów jest najmniejsza,
+ * przy której cyfra ma co najwyżej @p RADIX_BITS bitów, a bity są
+ * rozdzielane po równo między przebiegi. Wąski zakres wykładników daje
+ * więc jeden przebieg o niewielkiej liczbie kubełków. Liczniki kubełków
+ * są przechowywane na stosie.
+ * @sa MonoKey
+ */
+static void RadixSortMonos(const size_t size, Mono *monos) {
+  // Najmniejszy i największy klucz
+  uint32_t minKey = MonoKey(&monos[0]), maxKey = minKey;
+
+  for (size_t i = 1; i < size; i++) {
+    const uint32_t key = MonoKey(&monos[i]);
+
+    minKey = key < minKey ? key : minKey;
+    maxKey = key > maxKey ? key : maxKey;
+  }
+
+  // Liczba bitów różnicy kluczy
+  unsigned bits = 0;
+
+  while (bits < 32 && (maxKey - minKey) >> bits != 0) {
+    bits++;
+  }
+
+  const unsigned passes = (bits + RADIX_BITS - 1) / RADIX_BITS;
+
+  if (passes == 0) {
+    return;
+  }
+
+  // Szerokość cyfry
+  const unsigned width = (bits + passes - 1) / passes;
+  const uint32_t mask = ((uint32_t) 1 << width) - 1;
+  // Liczności cyfr w bieżącym przebiegu
+  size_t count[RADIX_BUCKETS];
+  // Tablica pomocnicza
+  Mono *buf = malloc(size * sizeof(Mono));
+
+  CHECK_PTR(buf);
+
+  // Tablica, z której odczytywane są jednomiany, i tablica, do której
+  // są zapisywane
+  Mono *src = monos, *dst = buf;
+
+  for (unsigned pass = 0; pass < passes; pass++) {
+    const unsigned shift = pass * width;
+
+    memset(count, 0, (mask + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < size; i++) {
+      count[((MonoKey(&src[i]) - minKey) >> shift) & mask]++;
+    }
+
+    // Zamiana liczności na pozycje początkowe kubełków
+    size_t offset = 0;
+
+    for (size_t d = 0; d <= mask; d++) {
+      const size_t c = count[d];
+      count[d] = offset;
+      offset += c;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+      dst[count[((MonoKey(&src[i]) - minKey) >> shift) & mask]++] = src[i];
+    }
+
+    Mono *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != monos) {
+    memcpy(monos, src, size * sizeof(Mono));
+  }
+
+  free(buf);
+}
+
+/**
+ * Sortuje jednomiany w danej tablicy.
+ * Posortowana tablica jest uporządkowana względem wykładników jednomianów
+ * w porządku niemalejącym.
+ * Zakłada, że @p size > 0, @p monos != @p NULL.
+ * @param[in] size : rozmiar tablicy
+ * @param[in] monos : tablica jednomianów
+ *
+ * @details
+ * Najpierw zlicza niemalejące fragmenty tablicy; posortowana tablica nie
+ * jest dalej przetwarzana. Małe tablice są sortowane przez wstawianie,
+ * a tablice o rozmiarze do @p COMPARISON_SORT_MAX -- przez scalanie
+ * funkcją @p SmallSortMonos, bez alokacji pamięci. Większe tablice
+ * złożone z długich posortowanych fragmentów (np. wynik mnożenia
+ * wielomianów, w którym każdy wiersz iloczynów jest posortowany) są
+ * scalane funkcją @p MergeSortedRuns, a pozostałe sortowane pozycyjnie
+ * funkcją @p RadixSortMonos.
+ * @sa InsertionSortMonos, SmallSortMonos, MergeSortedRuns, RadixSortMonos
+ */
+static inline void SortMonos(const size_t size, Mono *monos) {
+  // Liczba niemalejących fragmentów tablicy
+  size_t runs = 1;
+
+  for (size_t i = 1; i < size; i++) {
+    if (MonoGetExp(&monos[i]) < MonoGetExp(&monos[i - 1])) {
+      runs++;
+    }
+  }
+
+  if (runs == 1) {
+    return;
+  }
+  else if (size <= INSERTION_SORT_MAX) {
+    InsertionSortMonos(size, monos);
+  }
+  else if (size <= COMPARISON_SORT_MAX) {
+    SmallSortMonos(size, monos);
+  }
+  else if (size / runs >= MIN_AVG_RUN_LENGTH) {
+    MergeSortedRuns(size, monos, runs);
+  }
+  else {
+    RadixSortMonos(size, monos);
+  }
+}
+
+/**
+ * Tworzy wielomian z tablicy jednomianów zaalokowanej funkcją
+ * @p AllocMonos, przejmując na własność jej zawartość i ją samą. Zakłada,
+ * że @p count > 0 i @p monos != @p NULL.
+ * @param[in] count : liczba jednomianów
+ * @param[in] monos : tablica jednomianów z nagłówkiem
+ * @return wielomian będący sumą jednomianów
+ *
+ * @details
+ * Sortuje tablicę jednomianów funkcją @p SortMonos, a następnie sumuje
+ * jednomiany i zwraca wynik przy pomocy funkcji @p BuildPolyFromMonos.
+ * @sa SortMonos, BuildPolyFromMonos
+ */
+static Poly OwnMonos(size_t count, Mono *monos) {
+  // Sortowanie jednomianów ze względu na ich wykładniki
+  SortMonos(count, monos);
+
+  // Indeks, pod którym będą zapisywane kolejne jednomiany
+  // w tablicy monos
+  size_t index = 0;
+
+  for (size_t i = 1; i < count; i++) {
+    // Sumuje jednomiany o tym samym wykładniku
+    if (MonoGetExp(&monos[index]) == MonoGetExp(&monos[i])) {
+      // Modyfikuje wartość wielomianu; wykładnik pozostaje bez zmian
+      monos[index].p = PolyAddOwn(&monos[index].p, &monos[i].p);
+    }
+    // Znaleziono nowy wykładnik
+    else {
+      // Jeśli ostatni jednomian nie jest zerem, przesuwa indeks,
+      // aby nowy jednomian zapisać na kolejnej pozycji
+      if (!PolyIsZero(&monos[index].p)) {
+        index++;
+      }
+      // W przeciwnym razie usuwa ostatni jednomian;
+      // nowy jednomian będzie zapisany w tym samym miejscu
+      else {
+        MonoDestroy(&monos[index]);
+      }
+
+      monos[index] = monos[i];
+    }
+  }
+
+  // W tym momencie zmienna `index` zaznacza ostatnie miejsce w tablicy
+  // monos, na którym zapisano jednomian
+
+  // Jeśli jest to jednomian zerowy, usuwa go
+  if (PolyIsZero(&monos[index].p)) {
+    MonoDestroy(&monos[index]);
+  }
+  // W przeciwnym razie zwiększa zmienną `index` o 1 tak, aby
+  // jej wartość była równa liczbie jednomianów w tablicy monos
+  else {
+    index++;
+  }
+
+  // W tym momencie zmienna `index` jest równa liczbie jednomianów
+  // w tablicy monos
+
+  // Zwraca wielomian zbudowany z jednomianów w tablicy monos
+  return BuildPolyFromMonos(monos, index, count);
+}
+
+/**
+ * Jeśli @p count jest równy zeru lub @p monos jest równy @p NULL, zwraca
+ * wielomian zerowy. W przeciwnym razie przenosi tablicę jednomianów do bloku
+ * pamięci z nagłówkiem funkcją @p AdoptMonos, zastępuje zamrożone
+ * współczynniki kopiami funkcją @p ThawFrozen i sumuje jednomiany przy
+ * użyciu funkcji @p OwnMonos.
+ * @sa AdoptMonos, OwnMonos
+ */
+Poly PolyOwnMonos(size_t count, Mono *monos) {
+  if (count == 0 || monos == NULL) { return PolyZero(); }
+
+  monos = AdoptMonos(count, monos);
+
+  for (size_t i = 0; i < count; i++) {
+    ThawFrozen(&monos[i].p);
+  }
+
+  return OwnMonos(count, monos);
+}
+
+
+//////////////////////////
+//                      //
+//    PolyCloneMonos    //
+//                      //
+//////////////////////////
+
+
+/**
+ * Tworzy kopię tablicy jednomianów złożoną z pełnych kopii jednomianów,
+ * z których składa się oryginalna tablica. Funkcja zakłada, że @p size jest
+ * wartością większą od zera, a @p monos nie jest równy @p NULL.
+ * @param[in] size : liczba jednomianów w tablicy
  * @param[in] monos : tablica jednomianów
  * @return pełna kopia tablicy @p monos
  */
@@ -628,9 +1897,7 @@ static inline Mono *CloneMonoArr(const size_t size, const Mono monos[]) {
   assert(size > 0 && monos != NULL);
 
   // Tworzenie nowej tablicy
-  Mono *monosArr = malloc(size * sizeof(Mono));
-  // Sprawdzenie, czy zaalokowano poprawnie pamięć na tablicę
-  CHECK_PTR(monosArr);
+  Mono *monosArr = AllocMonos(size);
 
   // Kopiowanie jednomianów
   for (size_t i = 0; i < size; i++) {
@@ -643,15 +1910,128 @@ static inline Mono *CloneMonoArr(const size_t size, const Mono monos[]) {
 /**
  * Jeśli @p count jest równy zeru lub @p monos równy @p NULL, zwraca
  * wielomian zerowy. W przeciwnym razie wykonuje pełną kopię tablicy @p monos
- * i sumuje jednomiany przy użyciu funkcji @p PolyOwnMonos.
- * @sa CloneMonoArr, PolyOwnMonos
+ * i sumuje jednomiany przy użyciu funkcji @p OwnMonos.
+ * @sa CloneMonoArr, OwnMonos
  */
 Poly PolyCloneMonos(size_t count, const Mono monos[]) {
   if (count == 0 || monos == NULL) { return PolyZero(); }
 
   Mono *monosArr = CloneMonoArr(count, monos);
 
-  return PolyOwnMonos(count, monosArr);
+  return OwnMonos(count, monosArr);
+}
+
+
+//////////////////////////
+//                      //
+//  Drzewo przegranych  //
+//                      //
+//////////////////////////
+
+/**
+ * Zwraca tablicę jednomianów wielomianu. Wielomian stały jest traktowany
+ * jak jednomian o wykładniku zero, zapisywany w @p single; wielomian zerowy
+ * nie ma jednomianów.
+ * @param[in] p : wielomian
+ * @param[out] single : miejsce na jednomian wielomianu stałego
+ * @param[out] size : liczba jednomianów
+ * @return tablica jednomianów wielomianu @p p
+ */
+static inline Mono *MonosOf(const Poly *p, Mono *single, size_t *size) {
+  if (!PolyIsCoeff(p)) {
+    *size = p->size;
+    return p->arr;
+  }
+
+  *single = (Mono) {.p = *p, .exp = 0};
+  *size = PolyIsZero(p) ? 0 : 1;
+
+  return single;
+}
+
+/**
+ * Posortowany ciąg jednomianów scalany z innymi takimi ciągami, np. jeden
+ * ze składników sumy lub jeden z wierszy iloczynu. Wykładniki ciągu są
+ * wykładnikami jednomianów tablicy przesuniętymi o stałą.
+ */
+typedef struct MergeSource {
+  const Mono *monos; ///< tablica jednomianów ciągu
+  size_t size; ///< liczba jednomianów
+  size_t pos; ///< indeks pierwszego nieprzetworzonego jednomianu
+  poly_exp_t shift; ///< przesunięcie wykładników jednomianów tablicy
+} MergeSource;
+
+/**
+ * Zwraca klucz ciągu jednomianów w drzewie przegranych: przesunięty
+ * wykładnik pierwszego nieprzetworzonego jednomianu lub @p INT64_MAX,
+ * jeśli ciąg został wyczerpany.
+ * @param[in] src : ciąg jednomianów
+ * @return klucz ciągu
+ */
+static inline int64_t SourceKey(const MergeSource *src) {
+  if (src->pos == src->size) {
+    return INT64_MAX;
+  }
+
+  return (int64_t) MonoGetExp(&src->monos[src->pos]) + src->shift;
+}
+
+/**
+ * Buduje drzewo przegranych dla @p k ciągów jednomianów. Liście drzewa
+ * odpowiadają indeksom @p k..2k-1, węzeł @p t ma synów @p 2t i @p 2t+1;
+ * w węźle wewnętrznym zapisywany jest przegrany rozgrywki, a w @p tree[0]
+ * -- zwycięzca całego turnieju, czyli ciąg o najmniejszym kluczu.
+ * @param[in] src : tablica ciągów jednomianów
+ * @param[in] k : liczba ciągów
+ * @param[out] tree : drzewo przegranych (@p k elementów)
+ */
+static void BuildLoserTree(const MergeSource src[], const size_t k,
+                           size_t tree[]) {
+  // Zwycięzcy rozgrywek w kolejnych węzłach
+  size_t *winners = malloc(2 * k * sizeof(size_t));
+
+  CHECK_PTR(winners);
+
+  for (size_t i = 0; i < k; i++) {
+    winners[k + i] = i;
+  }
+
+  for (size_t t = k - 1; t > 0; t--) {
+    const size_t l = winners[2 * t], r = winners[2 * t + 1];
+
+    if (SourceKey(&src[l]) <= SourceKey(&src[r])) {
+      winners[t] = l;
+      tree[t] = r;
+    }
+    else {
+      winners[t] = r;
+      tree[t] = l;
+    }
+  }
+
+  tree[0] = winners[1];
+  free(winners);
+}
+
+/**
+ * Rozgrywa ponownie mecze na ścieżce od liścia ciągu @p s do korzenia
+ * drzewa przegranych, po zmianie klucza tego ciągu.
+ * @param[in] src : tablica ciągów jednomianów
+ * @param[in] k : liczba ciągów
+ * @param[in,out] tree : drzewo przegranych
+ * @param[in] s : indeks ciągu, którego klucz się zmienił
+ */
+static inline void ReplayLoserTree(const MergeSource src[], const size_t k,
+                                   size_t tree[], size_t s) {
+  for (size_t t = (s + k) / 2; t > 0; t /= 2) {
+    if (SourceKey(&src[tree[t]]) < SourceKey(&src[s])) {
+      const size_t tmp = tree[t];
+      tree[t] = s;
+      s = tmp;
+    }
+  }
+
+  tree[0] = s;
 }
 
 
@@ -680,9 +2060,7 @@ Poly PolyCloneMonos(size_t count, const Mono monos[]) {
  */
 static inline Poly MulCoeffPoly(const Poly *p, const Poly *q) {
   // Tablica jednomianów wielomianu wyjściowego
-  Mono *newArr = malloc(q->size * sizeof(Mono));
-
-  CHECK_PTR(newArr);
+  Mono *newArr = AllocMonos(q->size);
 
   // Wielomian tymczasowy
   Poly tmp;
@@ -718,883 +2096,3250 @@ static inline Poly MulCoeffPoly(const Poly *p, const Poly *q) {
   return BuildPolyFromMonos(newArr, index, q->size);
 }
 
+/** Domyślna najmniejsza liczba iloczynów par jednomianów, od której
+    rozważane jest sumowanie iloczynów w tablicy z haszowaniem */
+#define DEFAULT_HASH_MIN_TERMS 64
+
+/** Domyślny względny koszt wstawienia jednego iloczynu do tablicy
+    z haszowaniem */
+#define DEFAULT_HASH_PROBE_COST 2
+
+/** Domyślny względny koszt obsłużenia jednego różnego wykładnika w tablicy
+    z haszowaniem: chybienia w pamięci podręcznej przy pierwszym wstawieniu,
+    przeniesienia jednomianu i posortowania go pozycyjnie */
+#define DEFAULT_HASH_DISTINCT_COST 12
+
+/** Domyślny najmniejszy stosunek liczb jednomianów czynników, od którego
+    wiersze iloczynu są scalane bez zapisywania wszystkich iloczynów */
+#define DEFAULT_UNBALANCED_MIN_RATIO 16
+
+/** Progi modelu kosztu mnożenia */
+static PolyMulConfig mulConfig = {
+  .hash_min_terms = DEFAULT_HASH_MIN_TERMS,
+  .hash_probe_cost = DEFAULT_HASH_PROBE_COST,
+  .hash_distinct_cost = DEFAULT_HASH_DISTINCT_COST,
+  .unbalanced_min_ratio = DEFAULT_UNBALANCED_MIN_RATIO
+};
+
+/** Jednokrotne uwzględnienie zmiennej środowiskowej w progach */
+static pthread_once_t mulConfigOnce = PTHREAD_ONCE_INIT;
+
 /**
- * Sprawdza, czy żaden ze wskaźników na wielomiany nie jest
- * pustym wskaźnikiem. Następnie dopasowuje wielomiany do odpowiedniego
- * przypadku; każdy z nich jest bowiem albo wielomianem stałym, albo nie.
- * Następnie zwraca wynik obliczony za pomocą odpowiedniej funkcji pomocniczej
- * lub (w przypadku, gdy oba wielomiany nie są stałe) mnoży każdy jednomian
- * wielomianu @p p z każdym jednomianem wielomianu @p q i poszczególne wyniki
- * cząstkowe zapisuje do tablicy. Następnie sumuje je za pomocą funkcji
- * @p PolyOwnMonos, zwalnia stworzoną wcześniej tablicę i zwraca wynik.
- * @sa PolyOwnMonos, MulCoeffPoly
+ * Uwzględnia w progach modelu kosztu mnożenia zmienną środowiskową
+ * @p POLY_MUL_CONFIG_ENV; jeśli jest ona niepoprawna, pozostają progi
+ * domyślne.
  */
-Poly PolyMul(const Poly *p, const Poly *q) {
-  assert(p != NULL && q != NULL);
+static void LoadMulConfig(void) {
+  const char *env = getenv(POLY_MUL_CONFIG_ENV);
 
-  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-    return PolyFromCoeff(p->coeff * q->coeff);
+  if (env != NULL) {
+    PolyMulConfigParse(env, &mulConfig);
   }
-  else if (PolyIsCoeff(p)) {
-    if (p->coeff == 0) {
-      return PolyZero();
-    }
+}
 
-    return MulCoeffPoly(p, q);
-  }
-  else if (PolyIsCoeff(q)) {
-    return PolyMul(q, p);
-  }
-  else {
-    Mono *newArr = malloc((p->size * q->size) * sizeof(Mono));
+/**
+ * Zwraca progi modelu kosztu mnożenia. Przy pierwszym wywołaniu
+ * w programie, w dowolnym wątku, uwzględnia zmienną środowiskową
+ * @p POLY_MUL_CONFIG_ENV -- funkcja @p pthread_once gwarantuje, że wątki
+ * mnożące równocześnie zobaczą progi już po jej odczytaniu.
+ * @return progi modelu kosztu mnożenia
+ */
+static inline const PolyMulConfig *MulConfig(void) {
+  pthread_once(&mulConfigOnce, LoadMulConfig);
 
-    CHECK_PTR(newArr);
+  return &mulConfig;
+}
 
-    // Mnoży każdy jednomian z każdym
-    for (size_t i = 0; i < p->size; i++) {
-      for (size_t j = 0; j < q->size; j++) {
-        newArr[q->size * i + j] = (Mono) {
-          .exp = p->arr[i].exp + q->arr[j].exp,
-          .p = PolyMul(&p->arr[i].p, &q->arr[j].p)
-        };
-      }
-    }
+/**
+ * Kopiuje aktualne progi.
+ */
+void PolyMulConfigGet(PolyMulConfig *config) {
+  assert(config != NULL);
 
-    // Sumuje obliczone jednomiany i tworzy z nich wielomian
-    return PolyOwnMonos(p->size * q->size, newArr);
-  }
+  *config = *MulConfig();
 }
 
-//////////////////////////
-//                      //
-//       PolyNeg        //
-//                      //
-//////////////////////////
+/**
+ * Zastępuje aktualne progi. Zmienna środowiskowa jest uwzględniana
+ * wcześniej, aby późniejsze mnożenie nie nadpisało ustawionych progów.
+ */
+void PolyMulConfigSet(const PolyMulConfig *config) {
+  assert(config != NULL);
+
+  pthread_once(&mulConfigOnce, LoadMulConfig);
+  mulConfig = *config;
+}
 
 /**
- * Tworzy wielomian stale równy @p -1, a następnie zwraca jego
- * iloczyn z oryginalnym wielomianem. Wielomian tożsamościowo
- * równy @p -1 jest usuwany.
+ * Przetwarza kolejne pary @p nazwa=wartość na kopii progów i dopiero
+ * po sprawdzeniu całego napisu zapisuje wynik. Wartości są liczbami
+ * dziesiętnymi bez znaku.
  */
-Poly PolyNeg(const Poly *p) {
-  Poly tmp = PolyFromCoeff(-1);
-  Poly result = PolyMul(p, &tmp);
+bool PolyMulConfigParse(const char *str, PolyMulConfig *config) {
+  assert(str != NULL && config != NULL);
 
-  PolyDestroy(&tmp);
+  PolyMulConfig result = *config;
 
-  return result;
-}
+  while (*str != '\0') {
+    // Długość nazwy progu
+    const size_t nameLength = strcspn(str, "=,");
 
-//////////////////////////
-//                      //
-//       PolySub        //
-//                      //
-//////////////////////////
+    if (str[nameLength] != '=' ||
+        !isdigit((unsigned char) str[nameLength + 1])) {
+      return false;
+    }
+
+    char *end = NULL;
+    errno = 0;
+    const unsigned long long value = strtoull(str + nameLength + 1, &end, 10);
+
+    if (errno == ERANGE || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+
+    if (nameLength == strlen("hash_min_terms") &&
+        strncmp(str, "hash_min_terms", nameLength) == 0 &&
+        value <= SIZE_MAX) {
+      result.hash_min_terms = (size_t) value;
+    }
+    else if (nameLength == strlen("hash_probe_cost") &&
+             strncmp(str, "hash_probe_cost", nameLength) == 0 &&
+             value <= UINT_MAX) {
+      result.hash_probe_cost = (unsigned) value;
+    }
+    else if (nameLength == strlen("hash_distinct_cost") &&
+             strncmp(str, "hash_distinct_cost", nameLength) == 0 &&
+             value <= UINT_MAX) {
+      result.hash_distinct_cost = (unsigned) value;
+    }
+    else if (nameLength == strlen("unbalanced_min_ratio") &&
+             strncmp(str, "unbalanced_min_ratio", nameLength) == 0 &&
+             value <= SIZE_MAX) {
+      result.unbalanced_min_ratio = (size_t) value;
+    }
+    else {
+      return false;
+    }
+
+    str = *end == ',' ? end + 1 : end;
+  }
+
+  *config = result;
+
+  return true;
+}
 
 /**
- * Zwraca różnicę wielomianu stałego i wielomianu nie będącego wielomianem
- * stałym, który posiada niezerowy wyraz wolny. Zakłada, że wskaźniki
- * na wielomiany nie są puste.
- * @param[in] p : wielomian stały
- * @param[in] q : wielomian nie będący wielomianem stałym mający wyraz wolny
- * @return @f$p - q@f$
- * 
- * @details
- * Oblicza wyraz wolny (jednomian o wykładniku równym zeru) wielomianu
- * wyjściowego. Jeśli jest tożsamościowo równy zeru, usuwa go, a następnie
- * alokuje tablicę jednomianów o rozmiarze mniejszym o 1 od oryginalnej.
- * Przypisuje do niej jednomiany przeciwne do oryginalnych (z pominięciem
- * wyrazu wolnego) i zwraca wynik. Jeśli zaś wyraz wolny wielomianu
- * wyjściowego jest różny od zera, tablica jednomianów ma ten sam rozmiar.
- * Pozostałe czynności są analogiczne. Należy zwrócić uwagę, że wynikiem
- * tej funkcji nie może być wielomian stały.
+ * Algorytmy mnożenia dwóch wielomianów nie będących wielomianami stałymi,
+ * spośród których model kosztu wybiera na każdym poziomie rekurencji.
  */
-static inline Poly SubConstPoly0(const Poly *p, const Poly *q) {
-  // Tablica jednomianów nowego wielomianu
-  Mono *newArr;
-  // Obliczanie jednomianu o zerowym wykładniku
-  Mono zeroMono = (Mono) {.p = PolySub(p, &q->arr[0].p), .exp = 0};
+typedef enum MulKernel {
+  MUL_KERNEL_MERGE, ///< posortowanie i scalenie wszystkich iloczynów
+  MUL_KERNEL_HASH, ///< sumowanie iloczynów w tablicy z haszowaniem
+  MUL_KERNEL_UNBALANCED ///< scalanie wierszy iloczynu w miarę ich obliczania
+} MulKernel;
 
-  // Wyraz wolny w nowym wielomianie jest równy 0
-  if (PolyIsZero(&zeroMono.p)) {
-    MonoDestroy(&zeroMono);
+/**
+ * Zwraca sufit z logarytmu dwójkowego liczby dodatniej.
+ * @param[in] n : liczba dodatnia
+ * @return @f$\lceil \log_2 n \rceil@f$
+ */
+static inline size_t Log2Ceil(const size_t n) {
+  size_t log = 0;
 
-    // Tablica o rozmiarze o 1 mniejszym od oryginalnej (brak wyrazu
-    // wolnego). Jeśli zeroMono.p == 0, to wyraz wolny wielomianu q musiał
-    // być funkcją stałą. Jeśli jednak q nie jest wielomianem stałym,
-    // to q->size > 1 (istnieje co najmniej jeden jednomian nie będący
-    // tożsamościowo równy żadnej funkcji stałej)
-    newArr = malloc((q->size - 1) * sizeof(Mono));
+  while (((size_t) 1 << log) < n) {
+    log++;
+  }
 
-    CHECK_PTR(newArr);
+  return log;
+}
 
-    // Uzupełnianie tablicy jednomianów jednomianami przeciwnymi
-    // do oryginalnych
-    for (size_t i = 0; i < q->size - 1; i++) {
-      newArr[i] = (Mono) {
-        .p = PolyNeg(&q->arr[i + 1].p),
-        .exp = MonoGetExp(&q->arr[i + 1])
-      };
-    }
+/**
+ * Zwraca liczbę możliwych wykładników iloczynu dwóch wielomianów nie
+ * będących wielomianami stałymi, czyli długość przedziału od sumy ich
+ * najmniejszych do sumy ich największych wykładników.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @return liczba możliwych wykładników iloczynu
+ */
+static inline uint64_t ProductExpRange(const Poly *p, const Poly *q) {
+  return (uint64_t) ((int64_t) MonoGetExp(&p->arr[p->size - 1]) +
+                     MonoGetExp(&q->arr[q->size - 1]) -
+                     MonoGetExp(&p->arr[0]) - MonoGetExp(&q->arr[0])) + 1;
+}
+
+/**
+ * Szacuje liczbę różnych wykładników wśród iloczynów jednomianów dwóch
+ * wielomianów nie będących wielomianami stałymi.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @return oczekiwana liczba różnych wykładników iloczynu
+ *
+ * @details
+ * Jeśli @f$N@f$ iloczynów trafia losowo w @f$R@f$ możliwych wykładników,
+ * to oczekiwana liczba różnych wykładników wynosi
+ * @f$R(1 - e^{-N/R})@f$. Funkcja korzysta z przybliżenia @f$NR / (N + R)@f$,
+ * które ma te same granice dla @f$N \ll R@f$ i @f$N \gg R@f$.
+ */
+static inline size_t ExpectedDistinctExps(const Poly *p, const Poly *q) {
+  const uint64_t n = (uint64_t) p->size * q->size;
+  // Liczba możliwych wykładników iloczynu
+  const uint64_t range = ProductExpRange(p, q);
+
+  return (size_t) ((double) n * (double) range / (double) (n + range));
+}
+
+/**
+ * Wybiera algorytm mnożenia dwóch wielomianów nie będących wielomianami
+ * stałymi na podstawie liczby ich jednomianów, rozpiętości wykładników
+ * i głębokości, korzystając z progów z @p MulConfig.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @return algorytm o najmniejszym szacowanym koszcie
+ *
+ * @details
+ * Wiersze iloczynów (jednomian @p p razy kolejne jednomiany @p q) są
+ * posortowane, więc ich scalenie kosztuje @f$N \lceil \log_2 n \rceil@f$
+ * kroków, gdzie @f$n@f$ to liczba wierszy; dodatkowo każda z @f$C@f$
+ * oczekiwanych kolizji wykładników wymaga dodania tymczasowego
+ * współczynnika, którego rozmiar dla wielomianów głębszych niż jeden
+ * poziom jest szacowany iloczynem średnich liczb wyrazów współczynników.
+ * Tablica z haszowaniem kosztuje wstawienie każdego z @f$N@f$ iloczynów
+ * i obsłużenie @f$N - C@f$ różnych wykładników, a współczynniki przy
+ * kolizjach są dodawane bez tworzenia wielomianów tymczasowych.
+ * Jeśli jeden z czynników ma co najmniej @p unbalanced_min_ratio razy
+ * więcej jednomianów od drugiego, zamiast scalania wszystkich iloczynów
+ * rozważane jest scalanie wierszy w miarę ich obliczania: kosztuje ono
+ * @f$N \lceil \log_2 k \rceil@f$ kroków dla @f$k@f$ jednomianów mniejszego
+ * czynnika, a kolizje również nie tworzą wielomianów tymczasowych.
+ * @sa ExpectedDistinctExps
+ */
+static inline MulKernel ChooseMulKernel(const Poly *p, const Poly *q) {
+  const PolyMulConfig *config = MulConfig();
+  const size_t n = p->size * q->size;
 
-    return (Poly) {.size = q->size - 1, .arr = newArr};
+  if (n < config->hash_min_terms) {
+    return MUL_KERNEL_MERGE;
   }
-  // Wyraz wolny w nowym wielomianie jest niezerowy
-  else {
-    newArr = malloc(q->size * sizeof(Mono));
 
-    CHECK_PTR(newArr);
+  const size_t distinct = ExpectedDistinctExps(p, q);
+  const size_t collisions = n - distinct;
+  // Szacowany rozmiar iloczynu dwóch współczynników
+  double coeffWeight = 1;
 
-    // Wyraz wolny nowego wielomianu
-    newArr[0] = zeroMono;
+  if (PolyDepth(p) > 1 || PolyDepth(q) > 1) {
+    coeffWeight = (double) PolyTerms(p) / p->size *
+                  ((double) PolyTerms(q) / q->size);
+  }
 
-    // Uzupełnianie tablicy jednomianów jednomianami przeciwnymi
-    // do oryginalnych
-    for (size_t i = 1; i < q->size; i++) {
-      newArr[i] = (Mono) {
-        .p = PolyNeg(&q->arr[i].p),
-        .exp = MonoGetExp(&q->arr[i])
-      };
-    }
+  const double hashCost = (double) n * config->hash_probe_cost +
+                          (double) distinct * config->hash_distinct_cost;
+  const size_t small = p->size < q->size ? p->size : q->size;
+  const size_t big = p->size < q->size ? q->size : p->size;
+
+  if (big / small >= config->unbalanced_min_ratio) {
+    const double unbalancedCost = (double) n * Log2Ceil(small);
 
-    return (Poly) {.size = q->size, .arr = newArr};
+    return hashCost < unbalancedCost ? MUL_KERNEL_HASH : MUL_KERNEL_UNBALANCED;
   }
+
+  const double mergeCost = (double) n * Log2Ceil(p->size) +
+                           (double) collisions * coeffWeight;
+
+  return hashCost < mergeCost ? MUL_KERNEL_HASH : MUL_KERNEL_MERGE;
 }
 
 /**
- * Zwraca różnicę wielomianu stałego i wielomianu nie będącego wielomianem
- * stałym. Zakłada, że wskaźniki na wielomiany nie są puste.
- * @param[in] p : wielomian stały
+ * Mnoży dwa wielomiany nie będące wielomianami stałymi, sumując iloczyny
+ * jednomianów w tablicy z haszowaniem (adresowanie otwarte, próbkowanie
+ * liniowe), której kluczem jest wykładnik.
+ * @param[in] p : wielomian nie będący wielomianem stałym
  * @param[in] q : wielomian nie będący wielomianem stałym
- * @return @f$p - q@f$
- * 
+ * @return @f$p * q@f$
+ *
  * @details
- * Sprawdza, czy wielomian @p q posiada niezerowy wyraz wolny (jednomian
- * o wykładniku równym zeru). Jeśli tak, to zwraca wynik funkcji pomocniczej
- * @p SubConstPoly0 wywołanej dla tych samych argumentów. W przeciwnym razie
- * wielomian @p q nie posiada wyrazu wolnego. Wynika z tego, że tablica
- * jednomianów wielomianu wyjściowego ma rozmiar o 1 większy od oryginalnej.
- * Wyraz wolny jest tożsamościowo równy otrzymanemu wielomianowi stałemu,
- * zaś pozostałe jednomiany są przeciwne do tych, z których składa się
- * wielomian @p q
- * 
- * @sa SubConstPoly0
+ * Rozmiar tablicy jest potęgą dwójki co najmniej dwa razy większą od
+ * liczby możliwych różnych wykładników. Pierwszy iloczyn o danym
+ * wykładniku jest obliczany funkcją @p PolyMul, a kolejne są dodawane
+ * do współczynnika w tablicy funkcją @p PolyFma. Na końcu
+ * niezerowe jednomiany są przenoszone do nowej tablicy i tylko one są
+ * sortowane.
+ * @sa ChooseMulKernel, SortMonos
  */
-static inline Poly SubConstPoly(const Poly *p, const Poly *q) {
-  // Przypadek, gdy wielomian q posiada niezerowy wyraz wolny
-  if (MonoGetExp(&q->arr[0]) == 0) {
-    return SubConstPoly0(p, q);
+static Poly HashMul(const Poly *p, const Poly *q) {
+  const size_t n = p->size * q->size;
+  // Liczba możliwych wykładników iloczynu
+  const uint64_t range = ProductExpRange(p, q);
+  // Górne ograniczenie liczby różnych wykładników
+  const size_t bound = range < n ? (size_t) range : n;
+  // Rozmiar tablicy z haszowaniem
+  const size_t capacity = (size_t) 1 << (Log2Ceil(bound) + 1);
+  const size_t mask = capacity - 1;
+  Mono *slots = malloc(capacity * sizeof(Mono));
+  bool *used = calloc(capacity, sizeof(bool));
+
+  CHECK_PTR(slots);
+  CHECK_PTR(used);
+
+  for (size_t i = 0; i < p->size; i++) {
+    for (size_t j = 0; j < q->size; j++) {
+      const poly_exp_t exp = p->arr[i].exp + q->arr[j].exp;
+      size_t h = Mix64((uint64_t) exp) & mask;
+
+      while (used[h] && slots[h].exp != exp) {
+        h = (h + 1) & mask;
+      }
+
+      // Pierwszy iloczyn o tym wykładniku
+      if (!used[h]) {
+        used[h] = true;
+        slots[h] = (Mono) {
+          .p = PolyMul(&p->arr[i].p, &q->arr[j].p),
+          .exp = exp
+        };
+      }
+      // Kolizja -- iloczyn jest dodawany do współczynnika w miejscu
+      else {
+        PolyFma(&slots[h].p, &p->arr[i].p, &q->arr[j].p);
+      }
+    }
   }
-  // Przypadek, gdy wielomian q nie posiada wyrazu wolnego
-  else {
-    // Tablica jednomianów nowego wielomianu
-    Mono *newArr = malloc((1 + q->size) * sizeof(Mono));
 
-    CHECK_PTR(newArr);
+  // Liczba niezerowych jednomianów
+  size_t count = 0;
 
-    // Wyraz wolny nowego wielomianu
-    newArr[0] = (Mono) {.p = PolyClone(p), .exp = 0};
+  for (size_t h = 0; h < capacity; h++) {
+    if (used[h] && !PolyIsZero(&slots[h].p)) {
+      count++;
+    }
+  }
 
-    // Uzupełnienie tablicy jednomianów nowego wielomianu jednomianami
-    // przeciwnymi do oryginalnych
-    for (size_t i = 1; i <= q->size; i++) {
-      newArr[i] = (Mono) {
-        .p = PolyNeg(&q->arr[i - 1].p),
-        .exp = MonoGetExp(&q->arr[i - 1])
-      };
+  Mono *newArr = AllocMonos(count > 0 ? count : 1);
+  size_t index = 0;
+
+  for (size_t h = 0; h < capacity; h++) {
+    if (used[h] && !PolyIsZero(&slots[h].p)) {
+      newArr[index++] = slots[h];
     }
+  }
 
-    return (Poly) {.size = 1 + q->size, .arr = newArr};
+  free(slots);
+  free(used);
+
+  if (count > 0) {
+    SortMonos(count, newArr);
   }
+
+  return BuildPolyFromMonos(newArr, count, count > 0 ? count : 1);
 }
 
 /**
- * Oblicza i zwraca różnicę wielomianu nie będącego wielomianem stałym, który
- * posiada niezerowy wyraz wolny, oraz wielomianu stałego. Zakłada, że
- * wskaźniki na wielomiany są niepuste.
- * @param[in] p : wielomian nie będący wielomianem stałym, który ma niezerowy
- * wyraz wolny
- * @param[in] q : wielomian stały
- * @return @f$p - q@f$
- * 
+ * Mnoży dwa wielomiany nie będące wielomianami stałymi o bardzo różnych
+ * liczbach jednomianów, scalając wiersze iloczynu bez ich zapisywania.
+ * Jeśli @p acc nie jest równy @p NULL, dodaje do iloczynu akumulator,
+ * przejmując go na własność i ustawiając na wielomian zerowy.
+ * @param[in] big : wielomian nie będący wielomianem stałym
+ * @param[in] small : wielomian nie będący wielomianem stałym
+ * @param[in,out] acc : akumulator lub @p NULL
+ * @return @f$big * small + acc@f$
+ *
  * @details
- * Oblicza wyraz wolny nowego wielomianu. W zależności od tego, czy jest
- * tożsamościowo równy zeru, czy nie, alokuje odpowiednią ilość pamięci
- * na tablicę jednomianów nowego wielomianu. Następnie ją uzupełnia
- * i zwraca wynik.
+ * Wiersz iloczynu dla jednomianu @p small to tablica jednomianów @p big
+ * z wykładnikami przesuniętymi o jego wykładnik, więc jest posortowany
+ * i nie trzeba go tworzyć. Drzewo przegranych o @p small->size liściach
+ * (i jednym dodatkowym dla jednomianów akumulatora) wskazuje kolejne
+ * najmniejsze wykładniki; pierwszy iloczyn o danym wykładniku jest
+ * obliczany funkcją @p PolyMul, a kolejne są dodawane do niego funkcją
+ * @p PolyFma. Współczynniki akumulatora są przenoszone bez kopiowania.
+ * Tablica wyniku jest powiększana dwukrotnie w miarę potrzeby, więc
+ * zajmowana pamięć jest proporcjonalna do rozmiaru wyniku, a nie do liczby
+ * par jednomianów.
+ * @sa ChooseMulKernel, BuildLoserTree, ReplayLoserTree, MonosOf
  */
-static inline Poly SubPolyConst0(const Poly *p, const Poly *q)
-{
-  // Tablica jednomianów wielomianu wyjściowego
-  Mono *newArr;
-  // Wyraz wolny wielomianu wyjściowego
-  Mono zeroMono = (Mono) {.p = PolySub(&p->arr[0].p, q), .exp = 0};
+static Poly UnbalancedMul(const Poly *big, const Poly *small, Poly *acc) {
+  // Indeks ciągu jednomianów akumulatora
+  const size_t accSrc = small->size;
+  const size_t k = small->size + (acc != NULL ? 1 : 0);
+  // Wiersze iloczynu i jednomiany akumulatora
+  MergeSource *src = malloc(k * sizeof(MergeSource));
+  // Drzewo przegranych
+  size_t *tree = malloc(k * sizeof(size_t));
+  // Jednomian akumulatora stałego
+  Mono single;
+
+  CHECK_PTR(src);
+  CHECK_PTR(tree);
+
+  for (size_t i = 0; i < small->size; i++) {
+    src[i] = (MergeSource) {
+      .monos = big->arr,
+      .size = big->size,
+      .pos = 0,
+      .shift = MonoGetExp(&small->arr[i])
+    };
+  }
 
-  // Wyraz wolny jest równy zeru
-  if (PolyIsZero(&zeroMono.p)) {
-    MonoDestroy(&zeroMono);
+  size_t capacity = big->size;
 
-    if (p->size > 1) {
-      // Wielomian wyjściowy ma o jeden jednomian mniej od wielomianu p
-      newArr = malloc((p->size - 1) * sizeof(Mono));
+  if (acc != NULL) {
+    src[accSrc].monos = MonosOf(acc, &single, &src[accSrc].size);
+    src[accSrc].pos = 0;
+    src[accSrc].shift = 0;
+    capacity += src[accSrc].size;
+  }
 
-      CHECK_PTR(newArr);
+  BuildLoserTree(src, k, tree);
 
-      // Pozostałe jednomiany są takie same
-      for (size_t i = 0; i < p->size - 1; i++) {
-        newArr[i] = (Mono) {
-          .p = PolyClone(&p->arr[i + 1].p),
-          .exp = MonoGetExp(&p->arr[i + 1])
-        };
+  Mono *newArr = AllocMonos(capacity);
+  size_t index = 0;
+
+  while (SourceKey(&src[tree[0]]) != INT64_MAX) {
+    const poly_exp_t exp = (poly_exp_t) SourceKey(&src[tree[0]]);
+    size_t s = tree[0];
+    Poly coeff = s == accSrc ? src[s].monos[src[s].pos++].p :
+                 PolyMul(&src[s].monos[src[s].pos++].p, &small->arr[s].p);
+
+    ReplayLoserTree(src, k, tree, s);
+
+    // Pozostałe iloczyny o tym samym wykładniku
+    while (SourceKey(&src[tree[0]]) == exp) {
+      s = tree[0];
+
+      if (s == accSrc) {
+        Poly moved = src[s].monos[src[s].pos++].p;
+
+        coeff = PolyAddOwn(&coeff, &moved);
+      }
+      else {
+        PolyFma(&coeff, &src[s].monos[src[s].pos++].p, &small->arr[s].p);
       }
 
-      return (Poly) {.size = p->size - 1, .arr = newArr};
+      ReplayLoserTree(src, k, tree, s);
     }
-    else {
-      return PolyZero();
+
+    // Współczynnik może się wyzerować wskutek przepełnienia
+    if (PolyIsZero(&coeff)) {
+      continue;
     }
-  }
-  // Wyraz wolny wielomianu wyjściowego jest różny od zera
-  else {
-    // Wielomian wyjściowy ma taką samą liczbę jednomianów co wielomian p
-    newArr = malloc(p->size * sizeof(Mono));
 
-    CHECK_PTR(newArr);
+    if (index == capacity) {
+      capacity *= 2;
+      newArr = ResizeMonos(newArr, capacity);
+    }
 
-    // Wyraz wolny wielomianu wyjściowego
-    newArr[0] = zeroMono;
+    newArr[index++] = (Mono) {.p = coeff, .exp = exp};
+  }
 
-    // Pozostałe jednomiany są takie same
-    for (size_t i = 1; i < p->size; i++) {
-      newArr[i] = (Mono) {
-        .p = PolyClone(&p->arr[i].p),
-        .exp = MonoGetExp(&p->arr[i])
-      };
+  free(src);
+  free(tree);
+
+  if (acc != NULL) {
+    // Współczynniki akumulatora zostały przeniesione do wyniku
+    if (!PolyIsCoeff(acc)) {
+      FreeMonos(acc->arr);
     }
 
-    return (Poly) {.size = p->size, .arr = newArr};
+    *acc = PolyZero();
   }
+
+  return BuildPolyFromMonos(newArr, index, capacity);
 }
 
 /**
- * Oblicza i zwraca różnicę wielomianu nie będącego wielomianem stałym
- * i wielomianu stałego różnego od zera.
+ * Mnoży wielomian nie będący wielomianem stałym przez jednomian o niezerowym
+ * współczynniku jednym przejściem po jego tablicy: wykładniki są
+ * przesuwane, a współczynniki mnożone rekurencyjnie funkcją @p PolyMul.
+ * Kolejność wykładników się nie zmienia, więc wynik nie jest sortowany.
  * @param[in] p : wielomian nie będący wielomianem stałym
- * @param[in] q : wielomian stały różny od zera
- * @return @f$p - q@f$
- * 
- * @details
- * Jeśli wielomian @p p nie ma wyrazu wolnego, to deklaruje tablicę
- * jednomianów o rozmiarze o 1 większej od oryginalnej (wielomianu @p p).
- * Wyraz wolny nowego wielomianu jest tożsamościowo równy wielomanowi @p q.
- * Pozostałe jednomiany pozostają bez zmian.
- * Jeśli @p p posiada niezerowy wyraz wolny, to zwraca wynik obliczony
- * za pomocą funkcji pomocniczej @p SubPolyConst0.
- * @sa SubPolyConst0
+ * @param[in] m : jednomian
+ * @return @f$p \cdot m@f$
  */
-static inline Poly SubPolyConst(const Poly *p, const Poly *q) {
-  // Wielomian p nie ma wyrazu wolnego
-  if (MonoGetExp(&p->arr[0]) != 0) {
-    // Tablica jednomianów wielomianu wyjściowego
-    Mono *newArr;
-    newArr = malloc((1 + p->size) * sizeof(Mono));
-
-    CHECK_PTR(newArr);
+static Poly MulByMono(const Poly *p, const Mono *m) {
+  Mono *newArr = AllocMonos(p->size);
+  size_t index = 0;
 
-    // Wyraz wolny wielomianu wyjściowego
-    newArr[0] = (Mono) {.p = PolyNeg(q), .exp = 0};
+  for (size_t i = 0; i < p->size; i++) {
+    Poly coeff = PolyMul(&p->arr[i].p, &m->p);
 
-    for (size_t i = 1; i <= p->size; i++) {
-      newArr[i] = (Mono) {
-        .p = PolyClone(&p->arr[i - 1].p),
-        .exp = MonoGetExp(&p->arr[i - 1])
+    // Współczynnik może się wyzerować wskutek przepełnienia
+    if (!PolyIsZero(&coeff)) {
+      newArr[index++] = (Mono) {
+        .p = coeff,
+        .exp = MonoGetExp(&p->arr[i]) + MonoGetExp(m)
       };
     }
-
-    return (Poly) {.size = 1 + p->size, .arr = newArr};
-  }
-  // Wielomian p posiada niezerowy wyraz wolny
-  else {
-    return SubPolyConst0(p, q);
   }
+
+  return BuildPolyFromMonos(newArr, index, p->size);
 }
 
 /**
- * Rozważa dwa jednomiany znajdujące się na wskazanych pozycjach w tablicach
- * dwóch niestałych wielomianów. Wybiera ten, który ma mniejszy wykładnik
- * i zwraca jego kopię (w przypadku jednomianu z tablicy wielomianu @p p)
- * lub jednomian do niego przeciwny (w przypadku jednomianu z tablicy
- * wielomianu @p q). Jeśli zaś oba jednomiany mają ten sam wykładnik,
- * oblicza ich różnicę i zwraca ją. Następnie modyfikuje wartość tego indeksu,
- * który odnosi się do zwracanego jednomianu, zwiększając jego wartość
- * o 1 lub, w przypadku, gdy zwracana jest różnica jednomianów, zwiększa
- * wartości obu z nich.
- * Funkcja zakłada, że żaden ze wskaźników nie jest pusty
- * oraz że co najmniej jeden z indeksów mieści się w rozmiarze odowiadającej
- * mu tablicy (nie dotyczy to natomiast obu z nich jednocześnie).
+ * Mnoży dwa wielomiany nie będące wielomianami stałymi: mnoży każdy
+ * jednomian wielomianu @p p z każdym jednomianem wielomianu @p q,
+ * zapisuje wyniki cząstkowe do tablicy, a następnie sumuje je za pomocą
+ * funkcji @p OwnMonos.
  * @param[in] p : wielomian nie będący wielomianem stałym
  * @param[in] q : wielomian nie będący wielomianem stałym
- * @param[in,out] i : indeks odnoszący się do tablicy jednomianów
- * wielomianu @p p
+ * @return @f$p * q@f$
+ * @sa OwnMonos
+ */
+static Poly MergeMul(const Poly *p, const Poly *q) {
+  Mono *newArr = AllocMonos(p->size * q->size);
+
+  // Mnoży każdy jednomian z każdym
+  for (size_t i = 0; i < p->size; i++) {
+    for (size_t j = 0; j < q->size; j++) {
+      newArr[q->size * i + j] = (Mono) {
+        .exp = p->arr[i].exp + q->arr[j].exp,
+        .p = PolyMul(&p->arr[i].p, &q->arr[j].p)
+      };
+    }
+  }
+
+  // Sumuje obliczone jednomiany i tworzy z nich wielomian
+  return OwnMonos(p->size * q->size, newArr);
+}
+
+/**
+ * Sprawdza, czy żaden ze wskaźników na wielomiany nie jest
+ * pustym wskaźnikiem. Następnie dopasowuje wielomiany do odpowiedniego
+ * przypadku; każdy z nich jest bowiem albo wielomianem stałym, albo nie.
+ * Następnie zwraca wynik obliczony za pomocą odpowiedniej funkcji pomocniczej
+ * lub (w przypadku, gdy oba wielomiany nie są stałe) algorytm wybrany
+ * przez model kosztu @p ChooseMulKernel: scalenie wszystkich iloczynów
+ * jednomianów (@p MergeMul), sumowanie ich w tablicy z haszowaniem
+ * (@p HashMul) albo scalanie wierszy iloczynu w miarę ich obliczania
+ * (@p UnbalancedMul). Jeśli jeden z wielomianów składa się
+ * z jednego jednomianu, iloczyn jest obliczany funkcją @p MulByMono bez
+ * sortowania.
+ * @sa MulCoeffPoly, MulByMono, ChooseMulKernel, MergeMul, HashMul,
+ * UnbalancedMul
+ */
+Poly PolyMul(const Poly *p, const Poly *q) {
+  assert(p != NULL && q != NULL);
+
+  // Zamrożone wielomiany są zastępowane kopiami
+  if (IsFrozen(p) || IsFrozen(q)) {
+    Poly copies[2];
+    Poly result = PolyMul(Thawed(p, &copies[0]), Thawed(q, &copies[1]));
+
+    PolyDestroy(&copies[0]);
+    PolyDestroy(&copies[1]);
+    return result;
+  }
+
+  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+    return PolyFromCoeff(p->coeff * q->coeff);
+  }
+  else if (PolyIsCoeff(p)) {
+    if (p->coeff == 0) {
+      return PolyZero();
+    }
+
+    return MulCoeffPoly(p, q);
+  }
+  else if (PolyIsCoeff(q)) {
+    return PolyMul(q, p);
+  }
+  else if (q->size == 1) {
+    return MulByMono(p, &q->arr[0]);
+  }
+  else if (p->size == 1) {
+    return MulByMono(q, &p->arr[0]);
+  }
+  else {
+    switch (ChooseMulKernel(p, q)) {
+      case MUL_KERNEL_HASH:
+        return HashMul(p, q);
+      case MUL_KERNEL_UNBALANCED:
+        return p->size < q->size ? UnbalancedMul(q, p, NULL) :
+                                   UnbalancedMul(p, q, NULL);
+      default:
+        return MergeMul(p, q);
+    }
+  }
+}
+
+//////////////////////////
+//                      //
+//       PolySqr        //
+//                      //
+//////////////////////////
+
+/**
+ * Mnoży wielomian w miejscu przez niezerową stałą. Współczynniki, które
+ * wskutek przepełnienia stały się zerami, są usuwane.
+ * @param[in,out] p : wielomian
+ * @param[in] c : niezerowa stała
+ */
+static void MulCoeffInPlace(Poly *p, const poly_coeff_t c) {
+  if (PolyIsCoeff(p)) {
+    p->coeff *= c;
+    return;
+  }
+
+  // Indeks, pod którym są zapisywane kolejne niezerowe jednomiany
+  size_t index = 0;
+
+  for (size_t i = 0; i < p->size; i++) {
+    MulCoeffInPlace(&p->arr[i].p, c);
+
+    if (!PolyIsZero(&p->arr[i].p)) {
+      p->arr[index++] = p->arr[i];
+    }
+  }
+
+  *p = BuildPolyFromMonos(p->arr, index, p->size);
+}
+
+/**
+ * Jeśli wielomian jest stały, zwraca kwadrat jego współczynnika.
+ * W przeciwnym razie dla wielomianu @f$\sum_i p_i x^{e_i}@f$ tworzy
+ * tablicę @f$n(n + 1) / 2@f$ jednomianów: kwadratów @f$p_i^2 x^{2e_i}@f$,
+ * obliczanych rekurencyjnie tą samą funkcją, oraz podwojonych iloczynów
+ * @f$2 p_i p_j x^{e_i + e_j}@f$ dla @f$i < j@f$. Następnie sumuje je
+ * za pomocą funkcji @p OwnMonos. W porównaniu z @p PolyMul liczba mnożeń
+ * i rozmiar sortowanej tablicy są mniej więcej o połowę mniejsze.
+ * @sa MulCoeffInPlace, OwnMonos
+ */
+Poly PolySqr(const Poly *p) {
+  assert(p != NULL);
+
+  // Zamrożony wielomian jest zastępowany kopią
+  if (IsFrozen(p)) {
+    Poly copy = PolyClone(p);
+    Poly result = PolySqr(&copy);
+
+    PolyDestroy(&copy);
+    return result;
+  }
+
+  if (PolyIsCoeff(p)) {
+    return PolyFromCoeff(p->coeff * p->coeff);
+  }
+
+  const size_t n = p->size;
+  const size_t count = n * (n + 1) / 2;
+  Mono *newArr = AllocMonos(count);
+  // Indeks, pod którym jest zapisywany kolejny jednomian
+  size_t index = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    newArr[index++] = (Mono) {
+      .exp = 2 * p->arr[i].exp,
+      .p = PolySqr(&p->arr[i].p)
+    };
+
+    for (size_t j = i + 1; j < n; j++) {
+      Poly prod = PolyMul(&p->arr[i].p, &p->arr[j].p);
+
+      MulCoeffInPlace(&prod, 2);
+
+      newArr[index++] = (Mono) {
+        .exp = p->arr[i].exp + p->arr[j].exp,
+        .p = prod
+      };
+    }
+  }
+
+  return OwnMonos(count, newArr);
+}
+
+//////////////////////////
+//                      //
+//      PolyMulOwn      //
+//                      //
+//////////////////////////
+
+/**
+ * Mnoży wielomian w miejscu przez inny wielomian. Jeśli mnożnik jest
+ * stały albo składa się z jednego jednomianu @f$c x^e@f$, tablica
+ * wielomianu @p p jest wykorzystywana ponownie: wykładniki są przesuwane
+ * o @f$e@f$, a współczynniki mnożone w miejscu rekurencyjnie przez
+ * @f$c@f$. W przeciwnym razie wielomian @p p jest zastępowany iloczynem
+ * obliczonym funkcją @p PolyMul.
+ * @param[in,out] p : wielomian
+ * @param[in] q : mnożnik
+ */
+static void MulInPlace(Poly *p, const Poly *q) {
+  if (PolyIsCoeff(q)) {
+    if (PolyIsZero(q)) {
+      PolyDestroy(p);
+      *p = PolyZero();
+    }
+    else {
+      MulCoeffInPlace(p, q->coeff);
+    }
+  }
+  else if (PolyIsCoeff(p) || q->size != 1) {
+    Poly tmp = PolyMul(p, q);
+    PolyDestroy(p);
+    *p = tmp;
+  }
+  else {
+    const Mono *m = &q->arr[0];
+    size_t index = 0;
+
+    for (size_t i = 0; i < p->size; i++) {
+      MulInPlace(&p->arr[i].p, &m->p);
+
+      // Współczynnik może się wyzerować wskutek przepełnienia
+      if (!PolyIsZero(&p->arr[i].p)) {
+        p->arr[index] = p->arr[i];
+        p->arr[index].exp += MonoGetExp(m);
+        index++;
+      }
+    }
+
+    *p = BuildPolyFromMonos(p->arr, index, p->size);
+  }
+}
+
+/**
+ * Jeśli jeden z wielomianów jest stały lub składa się z jednego jednomianu,
+ * mnoży przez niego drugi wielomian w miejscu funkcją @p MulInPlace.
+ * W przeciwnym razie oblicza iloczyn funkcją @p PolyMul. Na koniec zwalnia
+ * niewykorzystaną pamięć i ustawia oba argumenty na wielomian zerowy.
+ * @sa MulInPlace, PolyMul
+ */
+Poly PolyMulOwn(Poly *p, Poly *q) {
+  assert(p != NULL && q != NULL && p != q);
+
+  // Zamrożone wielomiany nie mogą być modyfikowane w miejscu
+  ThawFrozen(p);
+  ThawFrozen(q);
+
+  Poly result;
+
+  if (PolyIsCoeff(q) || (!PolyIsCoeff(p) && q->size == 1)) {
+    MulInPlace(p, q);
+    result = *p;
+    PolyDestroy(q);
+  }
+  else if (PolyIsCoeff(p) || p->size == 1) {
+    MulInPlace(q, p);
+    result = *q;
+    PolyDestroy(p);
+  }
+  else {
+    result = PolyMul(p, q);
+    PolyDestroy(p);
+    PolyDestroy(q);
+  }
+
+  *p = PolyZero();
+  *q = PolyZero();
+
+  return result;
+}
+
+//////////////////////////
+//                      //
+//       PolyFma        //
+//                      //
+//////////////////////////
+
+/**
+ * Jeśli któryś z czynników jest zerowy, nie robi nic. Jeśli oba są stałe,
+ * dodaje ich iloczyn do akumulatora.
+ *
+ * @details
+ * Jeśli oba czynniki mają po co najmniej dwa jednomiany, a model kosztu
+ * @p ChooseMulKernel wybiera scalanie wierszy iloczynu, jednomiany
+ * akumulatora są jednym z ciągów scalanych funkcją @p UnbalancedMul:
+ * iloczyn nie jest tworzony jako osobny wielomian, a współczynniki
+ * akumulatora są przenoszone do wyniku. W pozostałych przypadkach
+ * (również gdy akumulator pokrywa się z którymś z czynników) iloczyn
+ * jest obliczany funkcją @p PolyMul, która sama wybiera najtańszy
+ * algorytm, i dodawany do akumulatora funkcją @p PolyAddOwn.
+ * @sa ChooseMulKernel, UnbalancedMul
+ */
+void PolyFma(Poly *acc, const Poly *a, const Poly *b) {
+  assert(acc != NULL && a != NULL && b != NULL);
+
+  // Akumulator jest modyfikowany w miejscu
+  ThawFrozen(acc);
+
+  // Zamrożone czynniki są zastępowane kopiami
+  if (IsFrozen(a) || IsFrozen(b)) {
+    Poly copies[2];
+
+    PolyFma(acc, Thawed(a, &copies[0]), Thawed(b, &copies[1]));
+    PolyDestroy(&copies[0]);
+    PolyDestroy(&copies[1]);
+    return;
+  }
+
+  if (PolyIsZero(a) || PolyIsZero(b)) {
+    return;
+  }
+  else if (PolyIsCoeff(a) && PolyIsCoeff(b)) {
+    if (PolyIsCoeff(acc)) {
+      acc->coeff += a->coeff * b->coeff;
+    }
+    else {
+      Poly tmp = PolyFromCoeff(a->coeff * b->coeff);
+      *acc = PolyAddOwn(acc, &tmp);
+    }
+  }
+  else if (acc != a && acc != b && !PolyIsCoeff(a) && !PolyIsCoeff(b) &&
+           a->size > 1 && b->size > 1 &&
+           ChooseMulKernel(a, b) == MUL_KERNEL_UNBALANCED) {
+    *acc = a->size < b->size ? UnbalancedMul(b, a, acc) :
+                               UnbalancedMul(a, b, acc);
+  }
+  else {
+    Poly tmp = PolyMul(a, b);
+    *acc = PolyAddOwn(acc, &tmp);
+  }
+}
+
+//////////////////////////
+//                      //
+//     PolySumMany      //
+//                      //
+//////////////////////////
+
+/**
+ * Sumuje wielomiany, scalając naraz wszystkie ich tablice jednomianów.
+ * Jeśli @p own jest ustawione, przejmuje składniki na własność: przenosi
+ * ich jednomiany do wyniku zamiast je kopiować, a wywołujący nie może już
+ * z nich korzystać. W przeciwnym razie wynik zawiera kopie współczynników
+ * składników.
+ * @param[in] n : liczba wielomianów
+ * @param[in] ps : tablica wielomianów
+ * @param[in] own : czy składniki są przejmowane na własność
+ * @return suma wielomianów
+ *
+ * @details
+ * Pomija wielomiany zerowe. Jeśli pozostał co najwyżej jeden wielomian,
+ * zwraca go (lub jego kopię, lub wielomian zerowy), a jeśli wszystkie są
+ * stałe -- sumę ich współczynników. W przeciwnym razie traktuje wielomiany
+ * stałe jak jednomiany o wykładniku zero i scala wszystkie tablice
+ * jednomianów naraz, korzystając z drzewa przegranych: każdy krok wyznacza
+ * ciąg o najmniejszym wykładniku w czasie logarytmicznym względem liczby
+ * składników. Współczynniki jednomianów o tym samym wykładniku są zbierane
+ * i sumowane rekurencyjnie tą samą funkcją, a wynik jest budowany w jednej
+ * tablicy o rozmiarze równym łącznej liczbie jednomianów. Przejmowany
+ * jednomian, którego wykładnik występuje tylko w jednym składniku, trafia
+ * do wyniku bez zmian, a tablica składnika jest zwalniana zaraz po jego
+ * wyczerpaniu, więc pamięć zajmuje naraz co najwyżej jedna kopia każdego
+ * jednomianu.
+ * @sa BuildLoserTree, ReplayLoserTree, MonosOf
+ */
+static Poly MergeSum(const size_t n, const Poly ps[], const bool own) {
+  // Ciągi jednomianów niezerowych składników
+  MergeSource *src = malloc((n > 0 ? n : 1) * sizeof(MergeSource));
+  // Jednomiany składników stałych
+  Mono *singles = malloc((n > 0 ? n : 1) * sizeof(Mono));
+  // Przejmowane tablice jednomianów składników niestałych lub NULL
+  Mono **arrays = malloc((n > 0 ? n : 1) * sizeof(Mono *));
+
+  CHECK_PTR(src);
+  CHECK_PTR(singles);
+  CHECK_PTR(arrays);
+
+  // Liczba niezerowych składników i łączna liczba ich jednomianów
+  size_t k = 0, total = 0;
+  // Indeks ostatniego niezerowego składnika
+  size_t last = 0;
+  // Czy wszystkie składniki są stałe
+  bool allCoeffs = true;
+  // Suma składników stałych
+  poly_coeff_t coeffSum = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    if (PolyIsZero(&ps[i])) {
+      continue;
+    }
+
+    if (PolyIsCoeff(&ps[i])) {
+      coeffSum += ps[i].coeff;
+    }
+    else {
+      allCoeffs = false;
+    }
+
+    src[k].monos = MonosOf(&ps[i], &singles[k], &src[k].size);
+    src[k].pos = 0;
+    src[k].shift = 0;
+    arrays[k] = own && !PolyIsCoeff(&ps[i]) ? ps[i].arr : NULL;
+    total += src[k].size;
+    last = i;
+    k++;
+  }
+
+  Poly result;
+
+  if (allCoeffs) {
+    result = PolyFromCoeff(coeffSum);
+  }
+  else if (k == 1) {
+    result = own ? ps[last] : PolyClone(&ps[last]);
+  }
+  else {
+    // Drzewo przegranych
+    size_t *tree = malloc(k * sizeof(size_t));
+    // Współczynniki jednomianów o tym samym wykładniku
+    Poly *coeffs = malloc(k * sizeof(Poly));
+    // Tablica jednomianów wyniku
+    Mono *newArr = AllocMonos(total);
+
+    CHECK_PTR(tree);
+    CHECK_PTR(coeffs);
+
+    BuildLoserTree(src, k, tree);
+
+    size_t index = 0;
+
+    while (SourceKey(&src[tree[0]]) != INT64_MAX) {
+      const poly_exp_t exp = (poly_exp_t) SourceKey(&src[tree[0]]);
+      size_t count = 0;
+
+      // Zebranie wszystkich jednomianów o najmniejszym wykładniku
+      while (SourceKey(&src[tree[0]]) == exp) {
+        const size_t s = tree[0];
+
+        coeffs[count++] = src[s].monos[src[s].pos++].p;
+
+        // Jednomiany wyczerpanego składnika zostały już przeniesione
+        if (src[s].pos == src[s].size && arrays[s] != NULL) {
+          FreeMonos(arrays[s]);
+          arrays[s] = NULL;
+        }
+
+        ReplayLoserTree(src, k, tree, s);
+      }
+
+      Poly sum;
+
+      if (count > 1) {
+        sum = MergeSum(count, coeffs, own);
+      }
+      else {
+        sum = own ? coeffs[0] : PolyClone(&coeffs[0]);
+      }
+
+      if (!PolyIsZero(&sum)) {
+        newArr[index++] = (Mono) {.p = sum, .exp = exp};
+      }
+    }
+
+    free(tree);
+    free(coeffs);
+
+    result = BuildPolyFromMonos(newArr, index, total);
+  }
+
+  free(src);
+  free(singles);
+  free(arrays);
+
+  return result;
+}
+
+/**
+ * Zamrożone składniki zastępuje kopiami, a następnie sumuje wielomiany
+ * funkcją @p MergeSum bez przejmowania ich na własność.
+ * @sa MergeSum
+ */
+Poly PolySumMany(size_t n, const Poly ps[]) {
+  assert(n == 0 || ps != NULL);
+
+  // Zamrożone składniki są zastępowane kopiami
+  const Poly *thawed = ThawedArr(n, ps);
+  Poly result = MergeSum(n, thawed, false);
+
+  FreeThawedArr(n, ps, thawed);
+  return result;
+}
+
+//////////////////////////
+//                      //
+//      PolyAccum       //
+//                      //
+//////////////////////////
+
+/**
+ * Zwraca największą liczbę wyrazów sumy częściowej w danym kubełku
+ * akumulatora: @f$4^{i+1}@f$, a dla ostatniego kubełka -- @p SIZE_MAX.
+ * @param[in] i : indeks kubełka
+ * @return pojemność kubełka
+ */
+static inline size_t BucketCapacity(const size_t i) {
+  if (i + 1 >= POLY_ACCUM_BUCKETS || 2 * (i + 1) >= sizeof(size_t) * 8) {
+    return SIZE_MAX;
+  }
+
+  return (size_t) 1 << (2 * (i + 1));
+}
+
+/**
+ * Ustawia wszystkie kubełki akumulatora na wielomiany zerowe.
+ */
+void PolyAccumInit(PolyAccum *acc) {
+  assert(acc != NULL);
+
+  for (size_t i = 0; i < POLY_ACCUM_BUCKETS; i++) {
+    acc->buckets[i] = PolyZero();
+  }
+}
+
+/**
+ * Wybiera najmniejszy kubełek, którego pojemność nie jest mniejsza od liczby
+ * wyrazów wielomianu, i dodaje do niego ten wielomian funkcją
+ * @p PolyAddOwn. Dopóki suma nie mieści się w kubełku, przenosi ją
+ * do kolejnego kubełka, dodając ją do znajdującej się tam sumy częściowej.
+ * @sa BucketCapacity, PolyAddOwn
+ */
+void PolyAccumAdd(PolyAccum *acc, Poly *p) {
+  assert(acc != NULL && p != NULL);
+
+  if (PolyIsZero(p)) {
+    return;
+  }
+
+  // Węzły obrazu nie mogą trafić do kubełków, które są modyfikowane
+  // w miejscu
+  ThawFrozen(p);
+
+  // Przenoszona suma częściowa
+  Poly sum = *p;
+  // Indeks kubełka, do którego trafi suma
+  size_t i = 0;
+
+  *p = PolyZero();
+
+  while (PolyTerms(&sum) > BucketCapacity(i)) {
+    i++;
+  }
+
+  while (true) {
+    sum = PolyAddOwn(&acc->buckets[i], &sum);
+
+    // Kubełek się przepełnił -- suma jest przenoszona do kolejnego
+    if (PolyTerms(&sum) > BucketCapacity(i)) {
+      i++;
+    }
+    else {
+      acc->buckets[i] = sum;
+      return;
+    }
+  }
+}
+
+/**
+ * Sumuje zawartość wszystkich kubełków jednym scaleniem funkcją
+ * @p MergeSum, która przejmuje je na własność i przenosi ich jednomiany
+ * do wyniku bez kopiowania, a następnie ustawia kubełki na wielomiany
+ * zerowe.
+ * @sa MergeSum
+ */
+Poly PolyAccumFinish(PolyAccum *acc) {
+  assert(acc != NULL);
+
+  Poly result = MergeSum(POLY_ACCUM_BUCKETS, acc->buckets, true);
+
+  PolyAccumInit(acc);
+  return result;
+}
+
+//////////////////////////
+//                      //
+//       PolyNeg        //
+//                      //
+//////////////////////////
+
+/**
+ * Tworzy wielomian stale równy @p -1, a następnie zwraca jego
+ * iloczyn z oryginalnym wielomianem. Wielomian tożsamościowo
+ * równy @p -1 jest usuwany.
+ */
+Poly PolyNeg(const Poly *p) {
+  Poly tmp = PolyFromCoeff(-1);
+  Poly result = PolyMul(p, &tmp);
+
+  PolyDestroy(&tmp);
+
+  return result;
+}
+
+//////////////////////////
+//                      //
+//       PolySub        //
+//                      //
+//////////////////////////
+
+/**
+ * Zwraca różnicę wielomianu stałego i wielomianu nie będącego wielomianem
+ * stałym, który posiada niezerowy wyraz wolny. Zakłada, że wskaźniki
+ * na wielomiany nie są puste.
+ * @param[in] p : wielomian stały
+ * @param[in] q : wielomian nie będący wielomianem stałym mający wyraz wolny
+ * @return @f$p - q@f$
+ * 
+ * @details
+ * Oblicza wyraz wolny (jednomian o wykładniku równym zeru) wielomianu
+ * wyjściowego. Jeśli jest tożsamościowo równy zeru, usuwa go, a następnie
+ * alokuje tablicę jednomianów o rozmiarze mniejszym o 1 od oryginalnej.
+ * Przypisuje do niej jednomiany przeciwne do oryginalnych (z pominięciem
+ * wyrazu wolnego) i zwraca wynik. Jeśli zaś wyraz wolny wielomianu
+ * wyjściowego jest różny od zera, tablica jednomianów ma ten sam rozmiar.
+ * Pozostałe czynności są analogiczne. Należy zwrócić uwagę, że wynikiem
+ * tej funkcji nie może być wielomian stały.
+ */
+static inline Poly SubConstPoly0(const Poly *p, const Poly *q) {
+  // Tablica jednomianów nowego wielomianu
+  Mono *newArr;
+  // Obliczanie jednomianu o zerowym wykładniku
+  Mono zeroMono = (Mono) {.p = PolySub(p, &q->arr[0].p), .exp = 0};
+
+  // Wyraz wolny w nowym wielomianie jest równy 0
+  if (PolyIsZero(&zeroMono.p)) {
+    MonoDestroy(&zeroMono);
+
+    // Tablica o rozmiarze o 1 mniejszym od oryginalnej (brak wyrazu
+    // wolnego). Jeśli zeroMono.p == 0, to wyraz wolny wielomianu q musiał
+    // być funkcją stałą. Jeśli jednak q nie jest wielomianem stałym,
+    // to q->size > 1 (istnieje co najmniej jeden jednomian nie będący
+    // tożsamościowo równy żadnej funkcji stałej)
+    newArr = AllocMonos(q->size - 1);
+
+    // Uzupełnianie tablicy jednomianów jednomianami przeciwnymi
+    // do oryginalnych
+    for (size_t i = 0; i < q->size - 1; i++) {
+      newArr[i] = (Mono) {
+        .p = PolyNeg(&q->arr[i + 1].p),
+        .exp = MonoGetExp(&q->arr[i + 1])
+      };
+    }
+
+    return PolyFromMonoArr(newArr, q->size - 1);
+  }
+  // Wyraz wolny w nowym wielomianie jest niezerowy
+  else {
+    newArr = AllocMonos(q->size);
+
+    // Wyraz wolny nowego wielomianu
+    newArr[0] = zeroMono;
+
+    // Uzupełnianie tablicy jednomianów jednomianami przeciwnymi
+    // do oryginalnych
+    for (size_t i = 1; i < q->size; i++) {
+      newArr[i] = (Mono) {
+        .p = PolyNeg(&q->arr[i].p),
+        .exp = MonoGetExp(&q->arr[i])
+      };
+    }
+
+    return PolyFromMonoArr(newArr, q->size);
+  }
+}
+
+/**
+ * Zwraca różnicę wielomianu stałego i wielomianu nie będącego wielomianem
+ * stałym. Zakłada, że wskaźniki na wielomiany nie są puste.
+ * @param[in] p : wielomian stały
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @return @f$p - q@f$
+ * 
+ * @details
+ * Sprawdza, czy wielomian @p q posiada niezerowy wyraz wolny (jednomian
+ * o wykładniku równym zeru). Jeśli tak, to zwraca wynik funkcji pomocniczej
+ * @p SubConstPoly0 wywołanej dla tych samych argumentów. W przeciwnym razie
+ * wielomian @p q nie posiada wyrazu wolnego. Wynika z tego, że tablica
+ * jednomianów wielomianu wyjściowego ma rozmiar o 1 większy od oryginalnej.
+ * Wyraz wolny jest tożsamościowo równy otrzymanemu wielomianowi stałemu,
+ * zaś pozostałe jednomiany są przeciwne do tych, z których składa się
+ * wielomian @p q
+ * 
+ * @sa SubConstPoly0
+ */
+static inline Poly SubConstPoly(const Poly *p, const Poly *q) {
+  // Przypadek, gdy wielomian q posiada niezerowy wyraz wolny
+  if (MonoGetExp(&q->arr[0]) == 0) {
+    return SubConstPoly0(p, q);
+  }
+  // Przypadek, gdy wielomian q nie posiada wyrazu wolnego
+  else {
+    // Tablica jednomianów nowego wielomianu
+    Mono *newArr = AllocMonos(1 + q->size);
+
+    // Wyraz wolny nowego wielomianu
+    newArr[0] = (Mono) {.p = PolyClone(p), .exp = 0};
+
+    // Uzupełnienie tablicy jednomianów nowego wielomianu jednomianami
+    // przeciwnymi do oryginalnych
+    for (size_t i = 1; i <= q->size; i++) {
+      newArr[i] = (Mono) {
+        .p = PolyNeg(&q->arr[i - 1].p),
+        .exp = MonoGetExp(&q->arr[i - 1])
+      };
+    }
+
+    return PolyFromMonoArr(newArr, 1 + q->size);
+  }
+}
+
+/**
+ * Oblicza i zwraca różnicę wielomianu nie będącego wielomianem stałym, który
+ * posiada niezerowy wyraz wolny, oraz wielomianu stałego. Zakłada, że
+ * wskaźniki na wielomiany są niepuste.
+ * @param[in] p : wielomian nie będący wielomianem stałym, który ma niezerowy
+ * wyraz wolny
+ * @param[in] q : wielomian stały
+ * @return @f$p - q@f$
+ * 
+ * @details
+ * Oblicza wyraz wolny nowego wielomianu. W zależności od tego, czy jest
+ * tożsamościowo równy zeru, czy nie, alokuje odpowiednią ilość pamięci
+ * na tablicę jednomianów nowego wielomianu. Następnie ją uzupełnia
+ * i zwraca wynik.
+ */
+static inline Poly SubPolyConst0(const Poly *p, const Poly *q)
+{
+  // Tablica jednomianów wielomianu wyjściowego
+  Mono *newArr;
+  // Wyraz wolny wielomianu wyjściowego
+  Mono zeroMono = (Mono) {.p = PolySub(&p->arr[0].p, q), .exp = 0};
+
+  // Wyraz wolny jest równy zeru
+  if (PolyIsZero(&zeroMono.p)) {
+    MonoDestroy(&zeroMono);
+
+    if (p->size > 1) {
+      // Wielomian wyjściowy ma o jeden jednomian mniej od wielomianu p
+      newArr = AllocMonos(p->size - 1);
+
+      // Pozostałe jednomiany są takie same
+      for (size_t i = 0; i < p->size - 1; i++) {
+        newArr[i] = (Mono) {
+          .p = PolyClone(&p->arr[i + 1].p),
+          .exp = MonoGetExp(&p->arr[i + 1])
+        };
+      }
+
+      return PolyFromMonoArr(newArr, p->size - 1);
+    }
+    else {
+      return PolyZero();
+    }
+  }
+  // Wyraz wolny wielomianu wyjściowego jest różny od zera
+  else {
+    // Wielomian wyjściowy ma taką samą liczbę jednomianów co wielomian p
+    newArr = AllocMonos(p->size);
+
+    // Wyraz wolny wielomianu wyjściowego
+    newArr[0] = zeroMono;
+
+    // Pozostałe jednomiany są takie same
+    for (size_t i = 1; i < p->size; i++) {
+      newArr[i] = (Mono) {
+        .p = PolyClone(&p->arr[i].p),
+        .exp = MonoGetExp(&p->arr[i])
+      };
+    }
+
+    return PolyFromMonoArr(newArr, p->size);
+  }
+}
+
+/**
+ * Oblicza i zwraca różnicę wielomianu nie będącego wielomianem stałym
+ * i wielomianu stałego różnego od zera.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian stały różny od zera
+ * @return @f$p - q@f$
+ * 
+ * @details
+ * Jeśli wielomian @p p nie ma wyrazu wolnego, to deklaruje tablicę
+ * jednomianów o rozmiarze o 1 większej od oryginalnej (wielomianu @p p).
+ * Wyraz wolny nowego wielomianu jest tożsamościowo równy wielomanowi @p q.
+ * Pozostałe jednomiany pozostają bez zmian.
+ * Jeśli @p p posiada niezerowy wyraz wolny, to zwraca wynik obliczony
+ * za pomocą funkcji pomocniczej @p SubPolyConst0.
+ * @sa SubPolyConst0
+ */
+static inline Poly SubPolyConst(const Poly *p, const Poly *q) {
+  // Wielomian p nie ma wyrazu wolnego
+  if (MonoGetExp(&p->arr[0]) != 0) {
+    // Tablica jednomianów wielomianu wyjściowego
+    Mono *newArr;
+    newArr = AllocMonos(1 + p->size);
+
+    // Wyraz wolny wielomianu wyjściowego
+    newArr[0] = (Mono) {.p = PolyNeg(q), .exp = 0};
+
+    for (size_t i = 1; i <= p->size; i++) {
+      newArr[i] = (Mono) {
+        .p = PolyClone(&p->arr[i - 1].p),
+        .exp = MonoGetExp(&p->arr[i - 1])
+      };
+    }
+
+    return PolyFromMonoArr(newArr, 1 + p->size);
+  }
+  // Wielomian p posiada niezerowy wyraz wolny
+  else {
+    return SubPolyConst0(p, q);
+  }
+}
+
+/**
+ * Rozważa dwa jednomiany znajdujące się na wskazanych pozycjach w tablicach
+ * dwóch niestałych wielomianów. Wybiera ten, który ma mniejszy wykładnik
+ * i zwraca jego kopię (w przypadku jednomianu z tablicy wielomianu @p p)
+ * lub jednomian do niego przeciwny (w przypadku jednomianu z tablicy
+ * wielomianu @p q). Jeśli zaś oba jednomiany mają ten sam wykładnik,
+ * oblicza ich różnicę i zwraca ją. Następnie modyfikuje wartość tego indeksu,
+ * który odnosi się do zwracanego jednomianu, zwiększając jego wartość
+ * o 1 lub, w przypadku, gdy zwracana jest różnica jednomianów, zwiększa
+ * wartości obu z nich.
+ * Funkcja zakłada, że żaden ze wskaźników nie jest pusty
+ * oraz że co najmniej jeden z indeksów mieści się w rozmiarze odowiadającej
+ * mu tablicy (nie dotyczy to natomiast obu z nich jednocześnie).
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @param[in,out] i : indeks odnoszący się do tablicy jednomianów
+ * wielomianu @p p
  * @param[in,out] j : indeks odnoszący się do tablicy jednomianów
  * wielomianu @p q
  * @return ten spośród jednomianów @p p->arr[*i], (-1) * @p q->arr[*j],
  * który ma mniejszy wykładnik (lub ich suma, jeśli są one równe).
  * 
  * @details
- * Rozważa trzy przypadki. Jeśli oba indeksy mieszczą się w zakresie
- * odpowiadających im tablic lub jeśli tylko jeden z nich spełnia ten warunek.
- * Jeśli wykładniki odpowiednich jednomianów są różne, to w przypadku, gdy
- * jednomian z tablicy wielomianu @p p ma mniejszy wykładnik, zwraca jego
- * kopię, zwiększając wcześniej wartość indeksu @p i o 1. W przypadku, gdy
- * jedomian z tablicy wielomianu @p q ma mniejszy wykładnik, zwraca
- * jednomian do niego przeciwny i zwiększa wartość indeksu @p j o 1. Jeżeli
- * zaś oba jednomiany mają ten sam wykładnik, zwraca różnicę jednomianu
- * z tablicy wielomianu @p p i jednomianu z tablicy wielomianu @p q i zwiększa
- * o 1 wartości obu indeksów.
+ * Rozważa trzy przypadki. Jeśli oba indeksy mieszczą się w zakresie
+ * odpowiadających im tablic lub jeśli tylko jeden z nich spełnia ten warunek.
+ * Jeśli wykładniki odpowiednich jednomianów są różne, to w przypadku, gdy
+ * jednomian z tablicy wielomianu @p p ma mniejszy wykładnik, zwraca jego
+ * kopię, zwiększając wcześniej wartość indeksu @p i o 1. W przypadku, gdy
+ * jedomian z tablicy wielomianu @p q ma mniejszy wykładnik, zwraca
+ * jednomian do niego przeciwny i zwiększa wartość indeksu @p j o 1. Jeżeli
+ * zaś oba jednomiany mają ten sam wykładnik, zwraca różnicę jednomianu
+ * z tablicy wielomianu @p p i jednomianu z tablicy wielomianu @p q i zwiększa
+ * o 1 wartości obu indeksów.
+ */
+static inline Mono NextMonoSub(const Poly *p, const Poly *q,
+                               size_t *i, size_t *j) {
+  // Wyjściowy jednomian
+  Mono monomial;
+
+  // Oba indeksy mieszczą się w zakresie odpowiadającym im tablic
+  if (*i < p->size && *j < q->size) {
+    if (MonoGetExp(&p->arr[*i]) < MonoGetExp(&q->arr[*j])) {
+      monomial = MonoClone(&p->arr[*i]);
+      *i = *i + 1;
+    }
+    else if (MonoGetExp(&p->arr[*i]) > MonoGetExp(&q->arr[*j])) {
+      monomial = (Mono) {
+        .p = PolyNeg(&q->arr[*j].p),
+        .exp = MonoGetExp(&q->arr[*j])
+      };
+
+      *j = *j + 1;
+    }
+    else {
+      // Oblicza różnicę jednomianów
+      monomial = (Mono) {
+        .p = PolySub(&p->arr[*i].p, &q->arr[*j].p),
+        .exp = MonoGetExp(&p->arr[*i])
+      };
+
+      *i = *i + 1;
+      *j = *j + 1;
+    }
+  }
+  // Indeks `j` wyszedł poza zakres swojej tablicy
+  else if (*i < p->size) {
+    monomial = MonoClone(&p->arr[*i]);
+    *i = *i + 1;
+  }
+  // Indeks `i` wyszedł poza zakres swojej tablicy
+  else {
+    monomial = (Mono) {
+      .p = PolyNeg(&q->arr[*j].p),
+      .exp = MonoGetExp(&q->arr[*j])
+    };
+    *j = *j + 1;
+  }
+
+  return monomial;
+}
+
+/**
+ * Zwraca różnicę dwóch wielomianów nie będących wielomianami stałymi.
+ * Zakłada, że przekazane wskaźniki na wielomiany nie są puste.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ * @param[in] q : wielomian nie będący wielomianem stałym
+ * @return @f$p - q@f$
+ * 
+ * @details
+ * Oblicza liczbę unikalnych wykładników wśrod jednomianów, z których
+ * składają się wielomiany @p p i @p q, a następnie alokuje tablicę
+ * jednomianów o takim rozmiarze. Rozważa kolejne jednomiany z tablic
+ * jednomianów wielomianów @p p i @p q i zapisuje ich kopie
+ * (lub jednomiany do nich przeciwne) w nowo stworzonej tablicy
+ * jednomianów (jeśli mają te same wykładniki, zapisuje zamiast tego
+ * ich różnicę). Służy do tego funkcja pomocnicza @p NextMonoSub.
+ * Ostatecznie jednomiany w nowej tablicy są uporządkowane w sposób
+ * rosnący ze względu na wykładniki, a wśród nich nie ma żadnego
+ * tożsamościowo równego zeru. Zwraca następnie wielomian złożony
+ * z tych jednomian, stworzny za pomocą funkcji
+ * pomocniczej @p BuildPolyFromMonos.
+ * @sa NextMonoSub, BuildPolyFromMonos, SumPolyPoly
+ */
+static inline Poly SubPolyPoly(const Poly *p, const Poly *q) {
+  // Liczba parami różnych wykładników wśród jednomianów
+  // z tablic jednomianów wielomianów wejściowych
+  const size_t newSize = NumOfUniqueExps(p, q);
+
+  // Tablica jednomianów wyjściowego wielomianu
+  Mono *newArr = AllocMonos(newSize);
+
+  // Indeksy rozważanych aktualnie jednomianów
+  // -- odpowiednio w tablicy wielomianu p i q
+  size_t i = 0, j = 0;
+  // Indeks, pod którym są zapisywane kolejne jednomiany w tablicy newArr
+  size_t index = 0;
+  // Jednomian pomocniczy
+  Mono tmpMonomial;
+
+  while (i < p->size || j < q->size) {
+    // Wybór kolejnego do zapisania w tablicy jednomianu
+    // i modyfikacja indeksów `i` oraz `j`
+    tmpMonomial = NextMonoSub(p, q, &i, &j);
+
+    //Aktualizacja tablicy jednomianów
+    if (!PolyIsZero(&tmpMonomial.p)) {
+      newArr[index] = tmpMonomial;
+      index++;
+    }
+    // Zwolnienie nieużywanej pamięci
+    else {
+      MonoDestroy(&tmpMonomial);
+    }
+  }
+
+  // W tym momencie zmienna `index` jest równa liczbie jednomianów
+  // w tablicy newArr
+
+  // Analizuje newArr i zwraca wielomian składający się z jednomianów
+  // znajdujących się w tablicy newArr
+  return BuildPolyFromMonos(newArr, index, newSize);
+}
+
+/**
+ * Sprawdza za pomocą asercji, czy żaden ze wskaźników na wielomiany
+ * nie jest pustym wskaźnikiem.
+ * Następnie sprawdza rodzaj każdego z wielomianu: wielomian stały / niestały,
+ * i oblicza różnicę @f$p - q@f$ za pomocą jednej z funkcji pomocniczych:
+ * @p PolyFromCoeff, @p SubConstPoly, @p SubPolyConst, @p SubPolyPoly
+ * @sa PolyFromCoeff, SubConstPoly, SubPolyConst, SubPolyPoly
+ */
+Poly PolySub(const Poly *p, const Poly *q) {
+  assert(p != NULL && q != NULL);
+
+  // Zamrożone wielomiany są zastępowane kopiami
+  if (IsFrozen(p) || IsFrozen(q)) {
+    Poly copies[2];
+    Poly result = PolySub(Thawed(p, &copies[0]), Thawed(q, &copies[1]));
+
+    PolyDestroy(&copies[0]);
+    PolyDestroy(&copies[1]);
+    return result;
+  }
+
+  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+    return PolyFromCoeff(p->coeff - q->coeff);
+  }
+  else if (PolyIsCoeff(p)) {
+    if (PolyIsZero(p)) {
+      return PolyNeg(q);
+    }
+
+    return SubConstPoly(p, q);
+  }
+  else if (PolyIsCoeff(q)) {
+    if (PolyIsZero(q)) {
+      return PolyClone(p);
+    }
+
+    return SubPolyConst(p, q);
+  }
+  else if (IsMuchBigger(p, q)) {
+    // Negacja mniejszego wielomianu jest tania, a sumę można wówczas
+    // obliczyć z wyszukiwaniem wykładniczym w tablicy wielomianu `p`
+    Poly negQ = PolyNeg(q);
+    Poly result = PolyIsCoeff(&negQ) ? PolyAdd(p, &negQ)
+                                     : GallopSumPolyPoly(p, &negQ);
+
+    PolyDestroy(&negQ);
+
+    return result;
+  }
+  else {
+    return SubPolyPoly(p, q);
+  }
+}
+
+/**
+ * Neguje wielomian w miejscu, zmieniając znak każdego ze współczynników
+ * stałych, z których się składa.
+ * @param[in,out] p : wielomian
+ */
+static void NegInPlace(Poly *p) {
+  if (PolyIsCoeff(p)) {
+    p->coeff = -p->coeff;
+  }
+  else {
+    PolyMeta *meta = Meta(p);
+
+    meta->hash = 0;
+
+    for (size_t i = 0; i < p->size; i++) {
+      NegInPlace(&p->arr[i].p);
+      meta->hash += MonoHash(&p->arr[i]);
+    }
+  }
+}
+
+/**
+ * Neguje w miejscu wielomian @p q, a następnie sumuje go z wielomianem @p p
+ * za pomocą funkcji @p PolyAddOwn.
+ * @sa NegInPlace, PolyAddOwn
+ */
+Poly PolySubOwn(Poly *p, Poly *q) {
+  assert(p != NULL && q != NULL && p != q);
+
+  // Zamrożony wielomian nie może być modyfikowany w miejscu
+  ThawFrozen(q);
+  NegInPlace(q);
+
+  return PolyAddOwn(p, q);
+}
+
+///////////////////////////
+//                       //
+//       PolyDegBy       //
+//                       //
+///////////////////////////
+
+/**
+ * Oblicza stopnie niestałego wielomianu względem każdej ze zmiennych,
+ * od których zależy, i zapamiętuje je w jego nagłówku. Korzysta przy tym
+ * z zapamiętanych (lub obliczanych w tym celu) stopni jego współczynników.
+ * @param[in] p : wielomian nie będący wielomianem stałym
+ *
+ * @details
+ * Stopień względem zmiennej o indeksie @p 0 jest wykładnikiem ostatniego
+ * jednomianu w tablicy (jednomiany są uporządkowane rosnąco). Stopień
+ * względem zmiennej o indeksie @f$i > 0@f$ jest największym ze stopni
+ * współczynników względem zmiennej o indeksie @f$i - 1@f$; współczynniki
+ * nie zależące od tej zmiennej mają względem niej stopień @p 0.
+ */
+static void ComputeDegBy(const Poly *p) {
+  PolyMeta *meta = Meta(p);
+  poly_exp_t *degBy = malloc(meta->depth * sizeof(poly_exp_t));
+
+  CHECK_PTR(degBy);
+
+  degBy[0] = MonoGetExp(&p->arr[p->size - 1]);
+
+  for (poly_exp_t i = 1; i < meta->depth; i++) {
+    degBy[i] = 0;
+  }
+
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly *coeff = &p->arr[i].p;
+
+    for (poly_exp_t j = 0; j < PolyDepth(coeff); j++) {
+      const poly_exp_t deg = PolyDegBy(coeff, j);
+
+      if (deg > degBy[j + 1]) {
+        degBy[j + 1] = deg;
+      }
+    }
+  }
+
+  meta->degBy = degBy;
+}
+
+/**
+ * Sprawdza, czy wskaźnik na wielomian nie jest pusty za pomocą asercji.
+ * Jeśli wielomian jest stały, to zachodzi jeden z następujących przypadków: 
+ * a) wielomian jest tożsamościowo równy 0 -- wówczas wynikiem jest -1; 
+ * b) w przeciwnym wypadku wynikiem jest 0, bo jest to stopień wielomianu 
+ * stałego nie będącego zerem. 
+ * Jeśli zaś wielomian nie jest wielomianem stałym i nie zależy od zmiennej
+ * o indeksie @p var_idx (indeks jest nie mniejszy od głębokości wielomianu),
+ * to wynikiem jest 0. W przeciwnym razie zwraca stopień zapamiętany
+ * w nagłówku wielomianu, obliczając przy pierwszym zapytaniu stopnie
+ * względem wszystkich zmiennych funkcją @p ComputeDegBy. Węzeł zamrożonego
+ * obrazu przechowuje stopnie obliczone przy zapisie obrazu w tablicy
+ * znajdującej się bezpośrednio za jego tablicą jednomianów.
+ * @sa ComputeDegBy
+ */
+poly_exp_t PolyDegBy(const Poly *p, size_t var_idx) {
+  assert(p != NULL);
+
+  if (PolyIsCoeff(p)) {
+    if (PolyIsZero(p)) { return -1; }
+    else               { return  0; }
+  }
+  else if (var_idx >= (size_t) Meta(p)->depth) {
+    return 0;
+  }
+  else if (IsFrozen(p)) {
+    return ((const poly_exp_t *) (p->arr + p->size))[var_idx];
+  }
+  else {
+    if (Meta(p)->degBy == NULL) {
+      ComputeDegBy(p);
+    }
+
+    return Meta(p)->degBy[var_idx];
+  }
+}
+
+//////////////////////////
+//                      //
+//       PolyDeg        //
+//                      //
+//////////////////////////
+
+/**
+ * Jeśli wielomian jest stały, to zwraca odpowiedni stopień. 
+ * W przypadku wielomianu nie będącego wielomianem stałym zwraca stopień
+ * zapamiętany w jego nagłówku podczas tworzenia wielomianu.
+ */
+poly_exp_t PolyDeg(const Poly *p) {
+  assert(p != NULL);
+
+  if (PolyIsCoeff(p)) {
+    if (PolyIsZero(p)) { return -1; }
+    else               { return  0; }
+  }
+  else {
+    return Meta(p)->deg;
+  }
+}
+
+///////////////////////////
+//                       //
+//       PolyIsEq        //
+//                       //
+///////////////////////////
+
+/**
+ * Sprawdza, czy żaden ze wskaźników na wielomiany
+ * nie jest pustym wskaźnikiem.
+ * Następnie bada rodzaj wielomianów: wielomian stały / niestały.
+ * Jeśli nie są tego samego rodzaju -- nie mogą być równe.
+ * Jeśli oba są wielomianami stałymi -- porównuje ich współczynniki.
+ * Jeśli oba są wielomianami niestałymi -- porównuje najpierw ich metadane,
+ * a jeśli są zgodne, to każdy z ich jednomianów. Współczynniki zamrożonych
+ * wielomianów są odczytywane funkcją @p ResolveCoeff.
+ */
+bool PolyIsEq(const Poly *p, const Poly *q) {
+  assert(p != NULL && q != NULL);
+
+  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
+    return p->coeff == q->coeff;
+  }
+  else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
+    return false;
+  }
+  else {
+    // Jeśli wielomiany nie mają takiej samej liczby jednomianów, wyrazów,
+    // skrótu, stopnia lub głębokości, nie mogą być równe
+    if (p->size != q->size || Meta(p)->terms != Meta(q)->terms ||
+        Meta(p)->hash != Meta(q)->hash || Meta(p)->deg != Meta(q)->deg ||
+        Meta(p)->depth != Meta(q)->depth) {
+      return false;
+    }
+
+    // Porównywanie każdego z jednomianów. Najpierw ich wykładniki,
+    // a potem równość wielomianów, z których są złożone
+    for (size_t i = 0; i < p->size; i++) {
+      if (MonoGetExp(&p->arr[i]) != MonoGetExp(&q->arr[i])) {
+        return false;
+      }
+
+      const Poly pCoeff = ResolveCoeff(p, i);
+      const Poly qCoeff = ResolveCoeff(q, i);
+
+      if (!PolyIsEq(&pCoeff, &qCoeff)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+//////////////////////////
+//                      //
+//       PolyHash       //
+//                      //
+//////////////////////////
+
+/**
+ * Skrót wielomianu stałego jest wymieszaną wartością jego współczynnika.
+ * Skrót wielomianu niestałego jest sumą (modulo @f$2^{64}@f$) skrótów jego
+ * jednomianów, obliczanych z wykładnika i skrótu współczynnika funkcją
+ * @p MonoHash. Suma nie zależy od kolejności jednomianów, więc przy
+ * modyfikacji wielomianu w miejscu skrót jest aktualizowany przyrostowo.
+ * Wartość jest obliczana przy tworzeniu wielomianu i przechowywana w jego
+ * nagłówku.
+ * @sa MonoHash
+ */
+uint64_t PolyHash(const Poly *p) {
+  assert(p != NULL);
+
+  if (PolyIsCoeff(p)) {
+    return Mix64((uint64_t) p->coeff);
+  }
+
+  return Meta(p)->hash;
+}
+
+//////////////////////////////
+//                          //
+//  PolyProbablyEqProduct   //
+//                          //
+//////////////////////////////
+
+/**
+ * Liczba pierwsza Mersenne'a @f$2^{61} - 1@f$, względem której są wyznaczane
+ * wartości wielomianów w funkcji @p PolyProbablyEqProduct. Reszta z dzielenia
+ * przez nią jest obliczana przesunięciem i dodawaniem, bez dzielenia.
+ */
+#define EVAL_PRIME ((1ULL << 61) - 1)
+
+/** Liczba początkowych potęg każdej zmiennej obliczanych raz na próbę */
+#define EVAL_POWERS 16
+
+/**
+ * Zwraca kolejną liczbę pseudolosową generatora splitmix64.
+ * @param[in,out] state : stan generatora
+ * @return liczba pseudolosowa
+ */
+static inline uint64_t NextRandom(uint64_t *state) {
+  *state += 0x9e3779b97f4a7c15ULL;
+
+  return Mix64(*state);
+}
+
+/**
+ * Zwraca resztę z dzielenia liczby przez @p EVAL_PRIME.
+ * @param[in] x : liczba
+ * @return @f$x \bmod (2^{61} - 1)@f$
+ */
+static inline uint64_t ReduceMod(uint64_t x) {
+  // 2^61 przystaje do 1, więc starsze bity dodaje się do młodszych
+  x = (x & EVAL_PRIME) + (x >> 61);
+
+  return x >= EVAL_PRIME ? x - EVAL_PRIME : x;
+}
+
+/**
+ * Dodaje dwie liczby modulo @p EVAL_PRIME.
+ * @param[in] a : liczba mniejsza od @p EVAL_PRIME
+ * @param[in] b : liczba mniejsza od @p EVAL_PRIME
+ * @return @f$a + b \bmod (2^{61} - 1)@f$
+ */
+static inline uint64_t AddMod(uint64_t a, uint64_t b) {
+  const uint64_t sum = a + b;
+
+  return sum >= EVAL_PRIME ? sum - EVAL_PRIME : sum;
+}
+
+/**
+ * Mnoży dwie liczby modulo @p EVAL_PRIME.
+ * @param[in] a : liczba mniejsza od @p EVAL_PRIME
+ * @param[in] b : liczba mniejsza od @p EVAL_PRIME
+ * @return @f$a \cdot b \bmod (2^{61} - 1)@f$
+ */
+static inline uint64_t MulMod(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+  const unsigned __int128 product = (unsigned __int128) a * b;
+
+  return ReduceMod(((uint64_t) product & EVAL_PRIME) +
+                   (uint64_t) (product >> 61));
+#else
+  uint64_t result = 0;
+
+  while (b > 0) {
+    if (b & 1) {
+      result = AddMod(result, a);
+    }
+
+    a = AddMod(a, a);
+    b >>= 1;
+  }
+
+  return result;
+#endif
+}
+
+/**
+ * Zwraca resztę z dzielenia współczynnika przez @p EVAL_PRIME. Współczynnik
+ * jest traktowany jako liczba całkowita ze znakiem.
+ * @param[in] c : współczynnik
+ * @return @f$c \bmod (2^{61} - 1)@f$
+ */
+static inline uint64_t CoeffMod(poly_coeff_t c) {
+  if (c >= 0) {
+    return ReduceMod((uint64_t) c);
+  }
+
+  // Wartość bezwzględna jest obliczana bez przepełnienia
+  const uint64_t rest = ReduceMod((uint64_t) -(c + 1) + 1);
+
+  return rest == 0 ? 0 : EVAL_PRIME - rest;
+}
+
+/**
+ * Podnosi liczbę do potęgi modulo @p EVAL_PRIME algorytmem szybkiego
+ * potęgowania.
+ * @param[in] base : liczba mniejsza od @p EVAL_PRIME
+ * @param[in] exp : wykładnik
+ * @return @f$base^{exp} \bmod (2^{61} - 1)@f$
+ */
+static inline uint64_t PowMod(uint64_t base, poly_exp_t exp) {
+  uint64_t result = 1;
+
+  while (exp > 0) {
+    if (exp & 1) {
+      result = MulMod(result, base);
+    }
+
+    base = MulMod(base, base);
+    exp >>= 1;
+  }
+
+  return result;
+}
+
+/**
+ * Zwraca potęgę wartości zmiennej, korzystając z obliczonych wcześniej
+ * potęg o wykładnikach mniejszych od @p EVAL_POWERS.
+ * @param[in] powers : potęgi wartości zmiennej o wykładnikach
+ * @f$0, 1, \ldots, EVAL\_POWERS - 1@f$
+ * @param[in] exp : wykładnik
+ * @return potęga wartości zmiennej modulo @p EVAL_PRIME
+ */
+static inline uint64_t PowerOf(const uint64_t powers[], poly_exp_t exp) {
+  // Ujemny wykładnik może pochodzić jedynie z uszkodzonego obrazu
+  return exp >= 0 && exp < EVAL_POWERS ? powers[exp]
+                                       : PowMod(powers[1], exp);
+}
+
+/**
+ * Wyznacza wartość wielomianu w punkcie modulo @p EVAL_PRIME schematem
+ * Hornera. Współczynniki są traktowane jako liczby całkowite ze znakiem.
+ * @param[in] p : wielomian
+ * @param[in] powers : kolejne bloki po @p EVAL_POWERS początkowych potęg
+ * wartości kolejnych zmiennych (co najmniej tyle bloków, ile wynosi
+ * głębokość wielomianu @p p)
+ * @return @f$p(point) \bmod (2^{61} - 1)@f$
+ *
+ * @details
+ * Między kolejnymi jednomianami akumulator jest mnożony przez potęgę
+ * wartości zmiennej o wykładniku równym różnicy ich wykładników; małe
+ * różnice, typowe dla gęstych wielomianów, są odczytywane z tablicy.
+ * Współczynniki są odczytywane funkcją @p ResolveCoeff, więc wielomian może
+ * być zamrożony.
+ */
+static uint64_t EvalMod(const Poly *p, const uint64_t powers[]) {
+  if (PolyIsCoeff(p)) {
+    return CoeffMod(p->coeff);
+  }
+
+  // Jednomiany są przetwarzane od najwyższego wykładnika
+  const Poly last = ResolveCoeff(p, p->size - 1);
+  uint64_t acc = EvalMod(&last, powers + EVAL_POWERS);
+
+  for (size_t i = p->size - 1; i > 0; i--) {
+    const poly_exp_t gap = MonoGetExp(&p->arr[i]) - MonoGetExp(&p->arr[i - 1]);
+    const Poly coeff = ResolveCoeff(p, i - 1);
+
+    acc = MulMod(acc, PowerOf(powers, gap));
+    acc = AddMod(acc, PolyIsCoeff(&coeff) ? CoeffMod(coeff.coeff) :
+                      EvalMod(&coeff, powers + EVAL_POWERS));
+  }
+
+  return MulMod(acc, PowerOf(powers, MonoGetExp(&p->arr[0])));
+}
+
+/**
+ * Iloczyn zera czynników i iloczyn jednego czynnika porównuje dokładnie
+ * funkcją @p PolyIsEq. W przeciwnym razie w każdej z @p trials prób losuje
+ * punkt i porównuje wartość wielomianu @p p z iloczynem wartości czynników
+ * w tym punkcie modulo @p EVAL_PRIME (test Schwartza-Zippela). Różne
+ * wartości rozstrzygają, że wielomiany są różne. Koszt próby jest
+ * proporcjonalny do łącznej liczby jednomianów @p p i czynników, a nie do
+ * liczby jednomianów ich iloczynu. Generator liczb pseudolosowych jest
+ * inicjowany skrótem wielomianu @p p, więc wynik jest powtarzalny.
+ *
+ * Jeśli któryś ze współczynników różnicy wielomianów nie jest podzielny
+ * przez @p EVAL_PRIME, szansa pomyłki w jednej próbie nie przekracza
+ * @f$d / (2^{61} - 1)@f$, gdzie @f$d@f$ jest stopniem różnicy.
+ * Współczynniki iloczynu są przy tym dokładnymi liczbami całkowitymi --
+ * jeśli przy jego wymnażaniu funkcją @p PolyMul któryś ze współczynników
+ * by się przepełnił, wynik może różnić się od porównania funkcją
+ * @p PolyIsEq.
+ * @sa EvalMod
+ */
+bool PolyProbablyEqProduct(const Poly *p, size_t count, const Poly factors[],
+                           unsigned trials) {
+  assert(p != NULL && (count == 0 || factors != NULL) && trials > 0);
+
+  if (count == 0) {
+    return PolyIsCoeff(p) && p->coeff == 1;
+  }
+  else if (count == 1) {
+    return PolyIsEq(p, &factors[0]);
+  }
+
+  // Liczba zmiennych, których wartości trzeba wylosować
+  size_t depth = (size_t) PolyDepth(p);
+
+  for (size_t i = 0; i < count; i++) {
+    if ((size_t) PolyDepth(&factors[i]) > depth) {
+      depth = (size_t) PolyDepth(&factors[i]);
+    }
+  }
+
+  // Początkowe potęgi wartości kolejnych zmiennych
+  uint64_t *powers = malloc((depth > 0 ? depth : 1) * EVAL_POWERS *
+                            sizeof(uint64_t));
+
+  CHECK_PTR(powers);
+
+  uint64_t state = PolyHash(p);
+  bool result = true;
+
+  for (unsigned t = 0; t < trials && result; t++) {
+    for (size_t i = 0; i < depth; i++) {
+      uint64_t *row = powers + i * EVAL_POWERS;
+
+      row[0] = 1;
+      row[1] = ReduceMod(NextRandom(&state));
+
+      for (size_t g = 2; g < EVAL_POWERS; g++) {
+        row[g] = MulMod(row[g - 1], row[1]);
+      }
+    }
+
+    // Iloczyn wartości czynników
+    uint64_t product = 1;
+
+    for (size_t i = 0; i < count && product != 0; i++) {
+      product = MulMod(product, EvalMod(&factors[i], powers));
+    }
+
+    result = EvalMod(p, powers) == product;
+  }
+
+  free(powers);
+
+  return result;
+}
+
+//////////////////////////
+//                      //
+//        PolyAt        //
+//                      //
+//////////////////////////
+
+/**
+ * Zwraca wynik potęgowania liczby całkowitej do naturalnej potęgi. 
+ * Zakłada, że @f$0^0 = 1@f$. Korzysta z algortymu szybkiego potęgowania.
+ * @param[in] base : podstawa potęgi
+ * @param[in] exp : wykładnik
+ * @return @f$base ^ { exp }@f$
+ */
+static inline poly_coeff_t FastExp(poly_coeff_t base, poly_exp_t exp) {
+  poly_coeff_t accumulator = 1;
+
+  while (exp > 0) {
+    if (exp % 2 != 0) {
+      accumulator *= base;
+    }
+
+    base *= base;
+    exp /= 2;
+  }
+
+  return accumulator;
+}
+
+/**
+ * Na początku sprawdza, czy wskaźnik na wielomian nie jest pusty.
+ * Jeśli wielomian jest stały, to zwraca jego kopię (w każdym punkcie
+ * jest sobie równy). W przeciwnym wypadku, rozważa dwa przypadki. Jeśli
+ * argument jest równy zeru, zwraca wielomian odpowiadający jednomianowi
+ * o wykładniku równym zeru (lub wielomian zerowy, jeśli takiego nie posiada).
+ * Inaczej argument jest różny od zera. Wówczas, mając jednomian @f$px_i^k@f$
+ * oblicza @f$p \cdot x^k@f$ dla każdego z jednomianów, a następnie sumuje je
+ * naraz funkcją @p MergeSum, przejmując je na własność. Jest to wynik. Współczynniki zamrożonego
+ * wielomianu są odczytywane bezpośrednio z obrazu funkcją @p ResolveCoeff.
+ */
+Poly PolyAt(const Poly *p, poly_coeff_t x) {
+  assert(p != NULL);
+
+  if (PolyIsCoeff(p)) {
+    return PolyClone(p);
+  }
+  else {
+    // Jako że wykładniki jednomianów nie powtarzają się,
+    // wystarczy rozpatrzeć tylko pierwszy jednomian
+    if (x == 0) {
+      // Jeśli wykładnik jest równy 0, to z równości 0^0 = 1 wynika,
+      // że wynikiem będzie kopia wielomianu,
+      // z którego składa się ten jednomian
+      if (MonoGetExp(&p->arr[0]) == 0) {
+        const Poly coeff = ResolveCoeff(p, 0);
+
+        return PolyClone(&coeff);
+      }
+      // W przeciwnym przypadku (gdy nie ma jednomianu o zerowym
+      // wykładniku) wynikiem jest wielomian zerowy
+      else {
+        return PolyZero();
+      }
+    }
+    else {
+      // Zmienna tymczasowa dla wielomianów
+      Poly tmp;
+      // Wartości kolejnych jednomianów w danym punkcie
+      Poly *values = malloc(p->size * sizeof(Poly));
+
+      CHECK_PTR(values);
+
+      for (size_t i = 0; i < p->size; i++) {
+        // Oblicza x^k, gdzie k to wartość wykładnika
+        // dla danego jednomianu
+        tmp = PolyFromCoeff(FastExp(x, p->arr[i].exp));
+        // Wielomian, z którego składa się dany jednomian
+        const Poly coeff = ResolveCoeff(p, i);
+        // Mnoży go z wynikiem potęgowania
+        values[i] = PolyMul(&coeff, &tmp);
+      }
+
+      // Wartość wielomianu w danym punkcie -- wynik; wartości jednomianów
+      // są przenoszone do sumy bez kopiowania
+      Poly result = MergeSum(p->size, values, true);
+
+      free(values);
+
+      return result;
+    }
+  }
+}
+
+
+//////////////////////////
+//                      //
+//      PolyCompose     //
+//                      //
+//////////////////////////
+
+
+/**
+ * Podnosi wielomian do potęgi. Zakłada, ze przekazany wskaźnik na wielomian
+ * wskazuje na istniejącą i poprawną strukturę danych. Zakłada także, że
+ * @f$0 ^ 0 = 1@f$.
+ * @param[in] p : wielomian
+ * @param[in] exp : wartość wykładnika
+ * @return @f$p ^ { exp }@f$
+ * 
+ * @details
+ * Funkcja korzysta z algorytmu szybkiego potęgowania, podnosząc wielomiany
+ * do kwadratu funkcją @p PolySqr. Traktuje ujemne wykładniki jako dodatnie.
  */
-static inline Mono NextMonoSub(const Poly *p, const Poly *q,
-                               size_t *i, size_t *j) {
-  // Wyjściowy jednomian
-  Mono monomial;
+static inline Poly PolyFastExp(const Poly *p, poly_exp_t exp) {
+  if (exp == 0) {
+    return PolyFromCoeff(1);
+  }
+  else if (exp == 1) {
+    return PolyClone(p);
+  }
+
+  // Akumulator
+  Poly acc = PolyFromCoeff(1);
+  // Wielomian wynikowy
+  Poly result = PolyClone(p);
+
+  while (exp != 0) {
+    Poly tmp;
+
+    if (exp % 2 != 0) {
+      tmp = PolyMul(&acc, &result);
+      PolyDestroy(&acc);
+      acc = tmp;
+    }
+
+    // Jeśli `exp` jest równy 1, to nie ma sensu podnosić jeszcze raz
+    // wielomianu do kwadratu, bo i tak nie wykorzystamy go przy
+    // następnym wykonaniu pętli
+    if (exp != 1) {
+      tmp = PolySqr(&result);
+      PolyDestroy(&result);
+      result = tmp;
+    }
+
+    exp /= 2;
+  }
+
+  PolyDestroy(&result);
+
+  return acc;
+}
+
+/**
+ * Oblicza wartość złożenia wielomianu @f$p@f$ z @f$k@f$ wielomianami,
+ * z których składa się tablica @p q. Funkcja zakłada, że przekazane
+ * wskaźniki wskazują na istniejące i poprawne struktury danych.
+ * @param[in] p : wielomian
+ * @param[in] level : indeks głównej zmiennej w wielomianie @f$p@f$
+ * @param[in] k : liczba wielomianów w tablicy @p q
+ * @param[in] q : tablica wielomianów
+ * @return Złożenie wielomianu @f$p@f$ z wielomianami z tablicy @p q.
+ */
+static inline Poly AuxPolyCompose(const Poly *p, const size_t level,
+                                  const size_t k, const Poly q[]) {
+  if (PolyIsCoeff(p)) {
+    return PolyClone(p);
+  }
+  else if (level + 1 > k || PolyIsZero(&q[level])) {
+    if (MonoGetExp(&p->arr[0]) == 0) {
+      const Poly coeff = ResolveCoeff(p, 0);
+
+      return AuxPolyCompose(&coeff, level + 1, k, q);
+    }
+    else {
+      return PolyZero();
+    }
+  }
+
+  // Suma wyników jednomianów, z których składa się `p`
+  PolyAccum sum;
+
+  PolyAccumInit(&sum);
+
+  // Wielomiany pomocnicze
+  Poly tmp, tmp2;
+  // Wielomian `q[level]` podniesiony do kolejnych potęg odpowiadających
+  // jednomianom, z których składa się wielomian `p`
+  Poly exp = PolyFromCoeff(1);
+  // Wartość wykładnika ostatniego analizowanego jednomianu
+  poly_exp_t expVal = 0;
+  
+  for (size_t i = 0; i < p->size; i++) {
+    // Malejący wykładnik może pochodzić jedynie z uszkodzonego obrazu
+    if (MonoGetExp(&p->arr[i]) < expVal) {
+      continue;
+    }
+
+    const Poly coeff = ResolveCoeff(p, i);
+
+    // Wielomian po złożeniu z wielomianami z tablicy `q`
+    tmp = AuxPolyCompose(&coeff, level + 1, k, q);
+    
+    if (!PolyIsZero(&tmp)) {
+      tmp2 = PolyPow(&q[level], MonoGetExp(&p->arr[i]) - expVal);
+      if (!PolyIsZero(&tmp2)) {
+        exp = PolyMulOwn(&exp, &tmp2);
+        // Aktualizacja wartości wykładnika
+        expVal = MonoGetExp(&p->arr[i]);
+        if (!PolyIsZero(&exp)) {
+          // Obliczenie wartości tego jednomianu po podstawieniu
+          // wielomianu `q[level]`
+          tmp2 = PolyMul(&tmp, &exp);
+          PolyDestroy(&tmp);
+          // Sumowanie wyniku
+          PolyAccumAdd(&sum, &tmp2);
+        }
+        else {
+          PolyDestroy(&tmp);
+        }
+      }
+      else {
+        PolyDestroy(&tmp);
+      }
+    }
+  }
+
+  PolyDestroy(&exp);
+
+  return PolyAccumFinish(&sum);
+}
+
+/**
+ * Wywołuje funkcję @p AuxPolyCompose dla wielomianu @f$p@f$, zaczynając
+ * od podstawienia pierwszego z wielomianów pod zmienną @f$x_0@f$. Następnie
+ * zwraca wynik. Zamrożony wielomian @f$p@f$ jest odczytywany bezpośrednio
+ * z obrazu, a zamrożone wielomiany z tablicy @p q, które są potęgowane,
+ * są najpierw zastępowane kopiami funkcją @p ThawedArr.
+ */
+Poly PolyCompose(const Poly *p, size_t k, const Poly q[]) {
+  const Poly *thawed = ThawedArr(k, q);
+  Poly result = AuxPolyCompose(p, 0, k, thawed);
+
+  FreeThawedArr(k, q, thawed);
+
+  return result;
+}
+
+//////////////////////////
+//                      //
+//       PolyPow        //
+//                      //
+//////////////////////////
+
+
+/**
+ * Największa liczba jednomianów wielomianu, dla której potęga jest
+ * obliczana rozwinięciem wielomianowym.
+ */
+#define MULTINOMIAL_MAX_TERMS 3
+
+/**
+ * Największy stosunek rozpiętości wykładników wielomianu jednej zmiennej
+ * do liczby jego jednomianów, dla którego potęga jest obliczana rekurencją
+ * Millera. Dla rzadszych wielomianów tablica współczynników wyniku byłaby
+ * w większości pusta.
+ */
+#define MILLER_MAX_SPAN_RATIO 4
+
+/**
+ * Zwraca odwrotność liczby nieparzystej modulo @f$2^{64}@f$, obliczaną
+ * metodą Newtona.
+ * @param[in] a : liczba nieparzysta
+ * @return @f$a^{-1} \bmod 2^{64}@f$
+ */
+static inline uint64_t InverseOdd(const uint64_t a) {
+  // Przybliżenie poprawne na trzech najmłodszych bitach
+  uint64_t x = a;
+
+  // Każdy krok podwaja liczbę poprawnych bitów
+  for (int i = 0; i < 5; i++) {
+    x *= 2 - a * x;
+  }
+
+  return x;
+}
+
+/**
+ * Wypełnia tablicę współczynnikami dwumianowymi @f$\binom{n}{k}@f$ dla
+ * @f$k = 0, 1, \dots, n@f$ modulo @f$2^{64}@f$, czyli w arytmetyce
+ * współczynników wielomianów.
+ * @param[in] n : wykładnik dwumianu
+ * @param[out] row : tablica o rozmiarze co najmniej @f$n + 1@f$
+ *
+ * @details
+ * Korzysta z zależności @f$\binom{n}{k} = \binom{n}{k - 1}
+ * \cdot (n - k + 1) / k@f$. Potęga dwójki dzieląca współczynnik jest
+ * pamiętana osobno, a dzielenie przez nieparzystą część @f$k@f$ zastępuje
+ * mnożenie przez jej odwrotność modulo @f$2^{64}@f$.
+ */
+static void BinomialRow(const poly_exp_t n, poly_coeff_t row[]) {
+  // Nieparzysta część współczynnika
+  uint64_t odd = 1;
+  // Wykładnik potęgi dwójki dzielącej współczynnik
+  unsigned twos = 0;
+
+  row[0] = 1;
+
+  for (poly_exp_t k = 1; k <= n; k++) {
+    uint64_t num = (uint64_t) (n - k + 1), den = (uint64_t) k;
+
+    while (num % 2 == 0) {
+      num /= 2;
+      twos++;
+    }
+
+    while (den % 2 == 0) {
+      den /= 2;
+      twos--;
+    }
+
+    odd *= num * InverseOdd(den);
+    row[k] = twos >= 64 ? 0 : (poly_coeff_t) (odd << twos);
+  }
+}
+
+/**
+ * Dopisuje jednomian na koniec tablicy, powiększając ją w razie potrzeby.
+ * @param[in,out] monos : tablica jednomianów z nagłówkiem
+ * @param[in,out] count : liczba jednomianów w tablicy
+ * @param[in,out] capacity : rozmiar tablicy
+ * @param[in] m : jednomian
+ */
+static inline void AppendMono(Mono **monos, size_t *count, size_t *capacity,
+                              const Mono m) {
+  if (*count == *capacity) {
+    *capacity *= 2;
+    *monos = ResizeMonos(*monos, *capacity);
+  }
+
+  (*monos)[(*count)++] = m;
+}
+
+/**
+ * Podnosi wielomian o niewielkiej liczbie jednomianów do potęgi,
+ * rozwijając ją wzorem dwumianowym względem pierwszego jednomianu.
+ * @param[in] p : wielomian nie będący wielomianem stałym o co najmniej
+ * dwóch jednomianach
+ * @param[in] n : wykładnik, @f$n \ge 2@f$
+ * @return @f$p^n@f$
+ *
+ * @details
+ * Zapisuje wielomian jako @f$c x^e + r@f$, gdzie @f$r@f$ składa się
+ * z pozostałych jednomianów, i oblicza
+ * @f$\sum_k \binom{n}{k} c^k x^{ke} r^{n - k}@f$. Kolejne potęgi @f$r@f$
+ * wymagają mnożenia tylko przez wielomian o małej liczbie jednomianów,
+ * a potęga jednomianu @f$c x^e@f$ sprowadza się do przesunięcia
+ * wykładników. Wszystkie otrzymane jednomiany są sumowane jednym
+ * wywołaniem funkcji @p OwnMonos, więc rozwinięcie @f$r^{n - k}@f$
+ * (dla @f$r@f$ o więcej niż jednym jednomianie) daje rozwinięcie
+ * wielomianowe.
+ * @sa BinomialRow, OwnMonos
+ */
+static Poly MultinomialPow(const Poly *p, const poly_exp_t n) {
+  const Poly *c = &p->arr[0].p;
+  const poly_exp_t e = MonoGetExp(&p->arr[0]);
+  // Wielomian złożony z pozostałych jednomianów
+  Poly rest = PolyCloneMonos(p->size - 1, &p->arr[1]);
+  poly_coeff_t *binom = malloc((n + 1) * sizeof(poly_coeff_t));
+  Poly *cPow = malloc((n + 1) * sizeof(Poly));
+
+  CHECK_PTR(binom);
+  CHECK_PTR(cPow);
+
+  BinomialRow(n, binom);
+
+  // Potęgi współczynnika pierwszego jednomianu
+  cPow[0] = PolyFromCoeff(1);
+
+  for (poly_exp_t k = 1; k <= n; k++) {
+    cPow[k] = PolyMul(&cPow[k - 1], c);
+  }
+
+  size_t count = 0, capacity = 2 * (size_t) (n + 1);
+  Mono *monos = AllocMonos(capacity);
+  // Potęga r^(n - k)
+  Poly restPow = PolyFromCoeff(1);
+
+  for (poly_exp_t k = n; k >= 0; k--) {
+    if (binom[k] != 0 && !PolyIsZero(&cPow[k])) {
+      // Jednomiany wielomianu r^(n - k) i ich liczba
+      const Mono single = {.p = restPow, .exp = 0};
+      const Mono *arr = PolyIsCoeff(&restPow) ? &single : restPow.arr;
+      const size_t size = PolyIsCoeff(&restPow) ? 1 : restPow.size;
+
+      for (size_t i = 0; i < size; i++) {
+        Poly coeff = PolyMul(&cPow[k], &arr[i].p);
+
+        MulCoeffInPlace(&coeff, binom[k]);
+
+        if (!PolyIsZero(&coeff)) {
+          AppendMono(&monos, &count, &capacity, (Mono) {
+            .p = coeff,
+            .exp = MonoGetExp(&arr[i]) + k * e
+          });
+        }
+      }
+    }
+
+    PolyDestroy(&cPow[k]);
+
+    if (k > 0) {
+      Poly tmp = PolyMul(&restPow, &rest);
+      PolyDestroy(&restPow);
+      restPow = tmp;
+    }
+  }
+
+  PolyDestroy(&restPow);
+  PolyDestroy(&rest);
+  free(cPow);
+  free(binom);
+
+  if (count == 0) {
+    FreeMonos(monos);
+    return PolyZero();
+  }
+
+  return OwnMonos(count, monos);
+}
+
+/**
+ * Podnosi do potęgi wielomian jednej zmiennej o stałych współczynnikach
+ * rekurencją J.C.P. Millera, jeśli wszystkie obliczenia mieszczą się
+ * w zakresie typu @p poly_coeff_t.
+ * @param[in] p : wielomian nie będący wielomianem stałym o co najmniej
+ * dwóch jednomianach, których współczynniki są stałe
+ * @param[in] n : wykładnik, @f$n \ge 2@f$
+ * @param[out] result : @f$p^n@f$, jeśli funkcja zwraca @p true
+ * @return @p false, jeśli wystąpiło przepełnienie lub wielomian jest zbyt
+ * rzadki; @p true w przeciwnym razie
+ *
+ * @details
+ * Dla @f$p = x^{e_0} \sum_i a_i x^i@f$, gdzie @f$a_0 \ne 0@f$, współczynniki
+ * @f$b_k@f$ wielomianu @f$(\sum_i a_i x^i)^n@f$ spełniają
+ * @f$b_0 = a_0^n@f$ oraz
+ * @f$b_k = \frac{1}{k a_0} \sum_{i=1}^{k} ((n + 1) i - k) a_i b_{k - i}@f$.
+ * Każdy współczynnik wyniku wymaga więc jednego mnożenia na każdy
+ * jednomian @f$p@f$. Dzielenie jest dokładne tylko w liczbach całkowitych,
+ * dlatego obliczenia są prowadzone z wykrywaniem przepełnienia; w razie
+ * przepełnienia funkcja zwraca @p false, a potęga jest obliczana inaczej.
+ */
+static bool MillerPow(const Poly *p, const poly_exp_t n, Poly *result) {
+  const poly_exp_t e0 = MonoGetExp(&p->arr[0]);
+  const poly_exp_t span = MonoGetExp(&p->arr[p->size - 1]) - e0;
+
+  if ((size_t) span > MILLER_MAX_SPAN_RATIO * p->size ||
+      (long long) n * MonoGetExp(&p->arr[p->size - 1]) > INT_MAX) {
+    return false;
+  }
+
+  // Stopień wielomianu (sum_i a_i x^i)^n
+  const poly_exp_t deg = n * span;
+  const poly_coeff_t a0 = p->arr[0].p.coeff;
+  poly_coeff_t *b = malloc((deg + 1) * sizeof(poly_coeff_t));
+
+  CHECK_PTR(b);
+
+  bool overflow = false;
+
+  b[0] = 1;
+
+  for (poly_exp_t i = 0; i < n && !overflow; i++) {
+    overflow = __builtin_mul_overflow(b[0], a0, &b[0]);
+  }
+
+  // Liczba niezerowych współczynników wyniku
+  size_t count = 1;
+
+  for (poly_exp_t k = 1; k <= deg && !overflow; k++) {
+    poly_coeff_t sum = 0, divisor;
+
+    for (size_t j = 1; j < p->size && !overflow; j++) {
+      const poly_exp_t i = MonoGetExp(&p->arr[j]) - e0;
+
+      if (i > k) {
+        break;
+      }
+
+      const poly_coeff_t factor = (poly_coeff_t) (n + 1) * i - k;
+      poly_coeff_t term;
+
+      overflow = __builtin_mul_overflow(factor, p->arr[j].p.coeff, &term) ||
+                 __builtin_mul_overflow(term, b[k - i], &term) ||
+                 __builtin_add_overflow(sum, term, &sum);
+    }
+
+    overflow = overflow || __builtin_mul_overflow(a0, k, &divisor) ||
+               (divisor == -1 && sum == LONG_MIN) || sum % divisor != 0;
+
+    if (!overflow) {
+      b[k] = sum / divisor;
+      count += b[k] != 0;
+    }
+  }
+
+  if (overflow) {
+    free(b);
+    return false;
+  }
+
+  Mono *monos = AllocMonos(count);
+  size_t index = 0;
+
+  for (poly_exp_t k = 0; k <= deg; k++) {
+    if (b[k] != 0) {
+      monos[index++] = (Mono) {.p = PolyFromCoeff(b[k]), .exp = n * e0 + k};
+    }
+  }
+
+  free(b);
+
+  *result = BuildPolyFromMonos(monos, count, count);
+
+  return true;
+}
+
+/**
+ * Wybiera sposób potęgowania na podstawie kształtu wielomianu. Wielomian
+ * stały jest potęgowany algorytmem szybkiego potęgowania liczb, a jednomian
+ * @f$c x^e@f$ -- jako @f$c^n x^{ne}@f$. Dla wielomianu jednej zmiennej
+ * o stałych współczynnikach próbuje rekurencji Millera. Wielomiany o co
+ * najwyżej @p MULTINOMIAL_MAX_TERMS jednomianach są potęgowane
+ * rozwinięciem wielomianowym, a pozostałe -- przez wielokrotne podnoszenie
+ * do kwadratu.
+ * @sa MillerPow, MultinomialPow, PolyFastExp
+ */
+Poly PolyPow(const Poly *p, poly_exp_t n) {
+  assert(p != NULL && n >= 0);
+
+  // Zamrożony wielomian jest zastępowany kopią
+  if (IsFrozen(p)) {
+    Poly copy = PolyClone(p);
+    Poly result = PolyPow(&copy, n);
+
+    PolyDestroy(&copy);
+    return result;
+  }
+
+  if (PolyIsCoeff(p)) {
+    return PolyFromCoeff(FastExp(p->coeff, n));
+  }
+  else if (n <= 1) {
+    return n == 0 ? PolyFromCoeff(1) : PolyClone(p);
+  }
+  else if (p->size == 1) {
+    Poly coeff = PolyPow(&p->arr[0].p, n);
 
-  // Oba indeksy mieszczą się w zakresie odpowiadającym im tablic
-  if (*i < p->size && *j < q->size) {
-    if (MonoGetExp(&p->arr[*i]) < MonoGetExp(&q->arr[*j])) {
-      monomial = MonoClone(&p->arr[*i]);
-      *i = *i + 1;
+    if (PolyIsZero(&coeff)) {
+      return coeff;
     }
-    else if (MonoGetExp(&p->arr[*i]) > MonoGetExp(&q->arr[*j])) {
-      monomial = (Mono) {
-        .p = PolyNeg(&q->arr[*j].p),
-        .exp = MonoGetExp(&q->arr[*j])
-      };
 
-      *j = *j + 1;
-    }
-    else {
-      // Oblicza różnicę jednomianów
-      monomial = (Mono) {
-        .p = PolySub(&p->arr[*i].p, &q->arr[*j].p),
-        .exp = MonoGetExp(&p->arr[*i])
-      };
+    Mono *monos = AllocMonos(1);
+    monos[0] = (Mono) {.p = coeff, .exp = n * MonoGetExp(&p->arr[0])};
 
-      *i = *i + 1;
-      *j = *j + 1;
-    }
+    return BuildPolyFromMonos(monos, 1, 1);
   }
-  // Indeks `j` wyszedł poza zakres swojej tablicy
-  else if (*i < p->size) {
-    monomial = MonoClone(&p->arr[*i]);
-    *i = *i + 1;
+
+  Poly result;
+
+  if (PolyDepth(p) == 1 && MillerPow(p, n, &result)) {
+    return result;
+  }
+  else if (p->size <= MULTINOMIAL_MAX_TERMS) {
+    return MultinomialPow(p, n);
   }
-  // Indeks `i` wyszedł poza zakres swojej tablicy
   else {
-    monomial = (Mono) {
-      .p = PolyNeg(&q->arr[*j].p),
-      .exp = MonoGetExp(&q->arr[*j])
-    };
-    *j = *j + 1;
+    return PolyFastExp(p, n);
   }
-
-  return monomial;
 }
 
+//////////////////////////
+//                      //
+//     PolyMulTrunc     //
+//                      //
+//////////////////////////
+
+
 /**
- * Zwraca różnicę dwóch wielomianów nie będących wielomianami stałymi.
- * Zakłada, że przekazane wskaźniki na wielomiany nie są puste.
+ * Zwraca liczbę jednomianów z początku tablicy wielomianu o wykładnikach
+ * nie większych od @p bound.
  * @param[in] p : wielomian nie będący wielomianem stałym
- * @param[in] q : wielomian nie będący wielomianem stałym
- * @return @f$p - q@f$
- * 
- * @details
- * Oblicza liczbę unikalnych wykładników wśrod jednomianów, z których
- * składają się wielomiany @p p i @p q, a następnie alokuje tablicę
- * jednomianów o takim rozmiarze. Rozważa kolejne jednomiany z tablic
- * jednomianów wielomianów @p p i @p q i zapisuje ich kopie
- * (lub jednomiany do nich przeciwne) w nowo stworzonej tablicy
- * jednomianów (jeśli mają te same wykładniki, zapisuje zamiast tego
- * ich różnicę). Służy do tego funkcja pomocnicza @p NextMonoSub.
- * Ostatecznie jednomiany w nowej tablicy są uporządkowane w sposób
- * rosnący ze względu na wykładniki, a wśród nich nie ma żadnego
- * tożsamościowo równego zeru. Zwraca następnie wielomian złożony
- * z tych jednomian, stworzny za pomocą funkcji
- * pomocniczej @p BuildPolyFromMonos.
- * @sa NextMonoSub, BuildPolyFromMonos, SumPolyPoly
+ * @param[in] bound : ograniczenie wykładnika
+ * @return liczba jednomianów @p p o wykładnikach @f$\le bound@f$
  */
-static inline Poly SubPolyPoly(const Poly *p, const Poly *q) {
-  // Liczba parami różnych wykładników wśród jednomianów
-  // z tablic jednomianów wielomianów wejściowych
-  const size_t newSize = NumOfUniqueExps(p, q);
+static inline size_t NumOfMonosUpTo(const Poly *p, const poly_exp_t bound) {
+  if (bound < 0) {
+    return 0;
+  }
+  else if (bound == INT_MAX) {
+    return p->size;
+  }
 
-  // Tablica jednomianów wyjściowego wielomianu
-  Mono *newArr = malloc(newSize * sizeof(Mono));
+  // Indeks pierwszego jednomianu o wykładniku większym od `bound`
+  return GallopExp(p->arr, 0, p->size, bound + 1);
+}
 
-  // Indeksy rozważanych aktualnie jednomianów
-  // -- odpowiednio w tablicy wielomianu p i q
-  size_t i = 0, j = 0;
-  // Indeks, pod którym są zapisywane kolejne jednomiany w tablicy newArr
+/**
+ * Jeśli stopień wielomianu względem danej zmiennej nie przekracza @p n,
+ * zwraca jego kopię. W przeciwnym razie dla @p var_idx równego zeru kopiuje
+ * jednomiany o wykładnikach nie większych od @p n (tworzą one początek
+ * tablicy), a dla większych indeksów obcina rekurencyjnie współczynniki
+ * względem zmiennej o indeksie o jeden mniejszym.
+ */
+Poly PolyTrunc(const Poly *p, size_t var_idx, poly_exp_t n) {
+  assert(p != NULL && n >= 0);
+
+  if (PolyDegBy(p, var_idx) <= n) {
+    return PolyClone(p);
+  }
+
+  // Zamrożony wielomian jest zastępowany kopią
+  if (IsFrozen(p)) {
+    Poly copy = PolyClone(p);
+    Poly result = PolyTrunc(&copy, var_idx, n);
+
+    PolyDestroy(&copy);
+    return result;
+  }
+
+  Mono *newArr;
   size_t index = 0;
-  // Jednomian pomocniczy
-  Mono tmpMonomial;
 
-  while (i < p->size || j < q->size) {
-    // Wybór kolejnego do zapisania w tablicy jednomianu
-    // i modyfikacja indeksów `i` oraz `j`
-    tmpMonomial = NextMonoSub(p, q, &i, &j);
+  if (var_idx == 0) {
+    index = NumOfMonosUpTo(p, n);
 
-    //Aktualizacja tablicy jednomianów
-    if (!PolyIsZero(&tmpMonomial.p)) {
-      newArr[index] = tmpMonomial;
-      index++;
+    if (index == 0) {
+      return PolyZero();
     }
-    // Zwolnienie nieużywanej pamięci
-    else {
-      MonoDestroy(&tmpMonomial);
+
+    newArr = AllocMonos(index);
+
+    for (size_t i = 0; i < index; i++) {
+      newArr[i] = MonoClone(&p->arr[i]);
     }
+
+    return BuildPolyFromMonos(newArr, index, index);
   }
 
-  // W tym momencie zmienna `index` jest równa liczbie jednomianów
-  // w tablicy newArr
+  newArr = AllocMonos(p->size);
 
-  // Analizuje newArr i zwraca wielomian składający się z jednomianów
-  // znajdujących się w tablicy newArr
-  return BuildPolyFromMonos(newArr, index, newSize);
+  for (size_t i = 0; i < p->size; i++) {
+    Poly coeff = PolyTrunc(&p->arr[i].p, var_idx - 1, n);
+
+    if (!PolyIsZero(&coeff)) {
+      newArr[index++] = (Mono) {.p = coeff, .exp = MonoGetExp(&p->arr[i])};
+    }
+  }
+
+  return BuildPolyFromMonos(newArr, index, p->size);
 }
 
 /**
- * Sprawdza za pomocą asercji, czy żaden ze wskaźników na wielomiany
- * nie jest pustym wskaźnikiem.
- * Następnie sprawdza rodzaj każdego z wielomianu: wielomian stały / niestały,
- * i oblicza różnicę @f$p - q@f$ za pomocą jednej z funkcji pomocniczych:
- * @p PolyFromCoeff, @p SubConstPoly, @p SubPolyConst, @p SubPolyPoly
- * @sa PolyFromCoeff, SubConstPoly, SubPolyConst, SubPolyPoly
+ * Jeśli któryś z wielomianów jest stały, obcina drugi funkcją
+ * @p PolyTrunc i mnoży go w miejscu przez stałą. W przeciwnym razie
+ * mnoży tylko te pary jednomianów, których iloczyn może mieć stopień
+ * względem danej zmiennej nie większy od @p n:
+ * - dla @p var_idx równego zeru są to pary o sumie wykładników
+ *   nie większej od @p n. Ich liczba jest wyznaczana przed mnożeniem
+ *   (dla każdego jednomianu @p p pasujące jednomiany @p q tworzą początek
+ *   tablicy), więc tablica wynikowa ma od razu właściwy rozmiar;
+ * - dla większych indeksów współczynniki są mnożone rekurencyjnie z tym
+ *   samym ograniczeniem względem zmiennej o indeksie o jeden mniejszym.
+ *
+ * Na koniec jednomiany są sumowane funkcją @p OwnMonos.
+ * @sa PolyTrunc, NumOfMonosUpTo, OwnMonos
  */
-Poly PolySub(const Poly *p, const Poly *q) {
-  assert(p != NULL && q != NULL);
+Poly PolyMulTrunc(const Poly *p, const Poly *q, size_t var_idx,
+                  poly_exp_t n) {
+  assert(p != NULL && q != NULL && n >= 0);
+
+  // Zamrożone wielomiany są zastępowane kopiami
+  if (IsFrozen(p) || IsFrozen(q)) {
+    Poly copies[2];
+    Poly result = PolyMulTrunc(Thawed(p, &copies[0]), Thawed(q, &copies[1]),
+                               var_idx, n);
+
+    PolyDestroy(&copies[0]);
+    PolyDestroy(&copies[1]);
+    return result;
+  }
 
   if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-    return PolyFromCoeff(p->coeff - q->coeff);
+    return PolyFromCoeff(p->coeff * q->coeff);
   }
   else if (PolyIsCoeff(p)) {
     if (PolyIsZero(p)) {
-      return PolyNeg(q);
+      return PolyZero();
     }
 
-    return SubConstPoly(p, q);
+    Poly result = PolyTrunc(q, var_idx, n);
+    MulCoeffInPlace(&result, p->coeff);
+
+    return result;
   }
   else if (PolyIsCoeff(q)) {
-    if (PolyIsZero(q)) {
-      return PolyClone(p);
+    return PolyMulTrunc(q, p, var_idx, n);
+  }
+
+  if (var_idx == 0) {
+    // Liczba par jednomianów o sumie wykładników nie większej od `n`
+    size_t count = 0;
+
+    for (size_t i = 0; i < p->size; i++) {
+      count += NumOfMonosUpTo(q, n - MonoGetExp(&p->arr[i]));
     }
 
-    return SubPolyConst(p, q);
+    if (count == 0) {
+      return PolyZero();
+    }
+
+    Mono *newArr = AllocMonos(count);
+    size_t index = 0;
+
+    for (size_t i = 0; i < p->size; i++) {
+      const poly_exp_t bound = n - MonoGetExp(&p->arr[i]);
+
+      for (size_t j = 0; j < q->size && MonoGetExp(&q->arr[j]) <= bound;
+           j++) {
+        newArr[index++] = (Mono) {
+          .exp = p->arr[i].exp + q->arr[j].exp,
+          .p = PolyMul(&p->arr[i].p, &q->arr[j].p)
+        };
+      }
+    }
+
+    return OwnMonos(count, newArr);
   }
-  else {
-    return SubPolyPoly(p, q);
+
+  Mono *newArr = AllocMonos(p->size * q->size);
+
+  for (size_t i = 0; i < p->size; i++) {
+    for (size_t j = 0; j < q->size; j++) {
+      newArr[q->size * i + j] = (Mono) {
+        .exp = p->arr[i].exp + q->arr[j].exp,
+        .p = PolyMulTrunc(&p->arr[i].p, &q->arr[j].p, var_idx - 1, n)
+      };
+    }
   }
-}
 
-///////////////////////////
-//                       //
-//       PolyDegBy       //
-//                       //
-///////////////////////////
+  return OwnMonos(p->size * q->size, newArr);
+}
 
 /**
- * Sprawdza, czy wskaźnik na wielomian nie jest pusty za pomocą asercji.
- * Jeśli wielomian jest stały, to zachodzi jeden z następujących przypadków: 
- * a) wielomian jest tożsamościowo równy 0 -- wówczas wynikiem jest -1; 
- * b) w przeciwnym wypadku wynikiem jest 0, bo jest to stopień wielomianu 
- * stałego nie będącego zerem. 
- * Jeśli zaś wielomian nie jest wielomianem stałym, to zachodzi jeden
- * z dwóch przypadków: 
- * a) rozpatruje "poziom" wielomianu, na którym znajdują się zmienne 
- * o indeksie @p var_idx, 
- * b) rozpatruje "niższy poziom" wielomianu niż @p var_idx
- * -- musi się zagłębić w poszczególne jednomiany.
+ * Obcina podstawę funkcją @p PolyTrunc, a następnie stosuje algorytm
+ * szybkiego potęgowania, w którym każde mnożenie i podnoszenie do kwadratu
+ * jest wykonywane funkcją @p PolyMulTrunc.
+ * @sa PolyTrunc, PolyMulTrunc
  */
-poly_exp_t PolyDegBy(const Poly *p, size_t var_idx) {
-  assert(p != NULL);
+Poly PolyPowTrunc(const Poly *p, poly_exp_t exp, size_t var_idx,
+                  poly_exp_t n) {
+  assert(p != NULL && exp >= 0 && n >= 0);
 
-  if (PolyIsCoeff(p)) {
-    if (PolyIsZero(p)) { return -1; }
-    else               { return  0; }
-  }
-  else
-  {
-    // Maksymalny znaleziony wykładnik zmiennej o indeksie var_idx
-    poly_exp_t maxExp = -1;
+  // Akumulator
+  Poly acc = PolyFromCoeff(1);
+  // Kolejne kwadraty podstawy
+  Poly base = PolyTrunc(p, var_idx, n);
 
-    // Rozpatruje "poziom" wielomianu, na którym znajdują się zmienne
-    // o indeksie var_idx
-    if (var_idx == 0) {
-      for (size_t i = 0; i < p->size; i++) {
-        if (MonoGetExp(&p->arr[i]) > maxExp) {
-          maxExp = MonoGetExp(&p->arr[i]);
-        }
-      }
-    }
-    // Rozpatruje "niższy poziom" wielomianu niż var_idx.
-    // Funkcja zagłębia się w poszczególne jednomiany
-    else {
-      // Tymczasowy wynik z poszczególnych jednomianów
-      poly_exp_t tmpResult;
+  while (exp != 0) {
+    Poly tmp;
 
-      for (size_t i = 0; i < p->size; i++) {
-        tmpResult = PolyDegBy(&p->arr[i].p, var_idx - 1);
+    if (exp % 2 != 0) {
+      tmp = PolyMulTrunc(&acc, &base, var_idx, n);
+      PolyDestroy(&acc);
+      acc = tmp;
+    }
 
-        // Aktualizujemy wynik
-        if (tmpResult > maxExp) {
-          maxExp = tmpResult;
-        }
-      }
+    if (exp != 1) {
+      tmp = PolyMulTrunc(&base, &base, var_idx, n);
+      PolyDestroy(&base);
+      base = tmp;
     }
 
-    return maxExp;
+    exp /= 2;
   }
+
+  PolyDestroy(&base);
+
+  return acc;
 }
 
 //////////////////////////
 //                      //
-//       PolyDeg        //
+//     Serializacja     //
 //                      //
 //////////////////////////
 
+/** Sygnatura rozpoczynająca zapis binarny wielomianu */
+static const uint8_t SERIAL_MAGIC[] = {'P', 'O', 'L', 'Y'};
+
+/** Długość nagłówka zapisu binarnego: sygnatura i bajt wersji */
+#define SERIAL_HEADER_SIZE (sizeof(SERIAL_MAGIC) + 1)
+
+/** Maksymalna długość zapisu liczby 64-bitowej w kodzie zmiennej długości */
+#define MAX_VARINT_SIZE 10
+
+/**
+ * Koduje liczbę ze znakiem jako liczbę bez znaku tak, aby liczby o małej
+ * wartości bezwzględnej miały krótki zapis (kodowanie zigzag):
+ * @f$0, -1, 1, -2, \ldots@f$ przechodzą na @f$0, 1, 2, 3, \ldots@f$.
+ * @param[in] x : liczba
+ * @return zakodowana liczba
+ */
+static inline uint64_t ZigZagEncode(const poly_coeff_t x) {
+  return ((uint64_t) x << 1) ^ (uint64_t) (x < 0 ? -1 : 0);
+}
+
+/**
+ * Odwraca kodowanie funkcji @p ZigZagEncode.
+ * @param[in] x : zakodowana liczba
+ * @return liczba ze znakiem
+ */
+static inline poly_coeff_t ZigZagDecode(const uint64_t x) {
+  return (poly_coeff_t) ((x >> 1) ^ (0 - (x & 1)));
+}
+
+/**
+ * Zwraca liczbę bajtów zapisu liczby w kodzie zmiennej długości, w którym
+ * każdy bajt przechowuje 7 bitów liczby, a najstarszy bit bajtu oznacza,
+ * że po nim następuje kolejny bajt.
+ * @param[in] x : liczba
+ * @return długość zapisu liczby @p x
+ */
+static inline size_t VarintSize(uint64_t x) {
+  size_t size = 1;
+
+  while (x >= 0x80) {
+    x >>= 7;
+    size++;
+  }
+
+  return size;
+}
+
+/**
+ * Zapisuje liczbę w kodzie zmiennej długości.
+ * @param[in] out : miejsce zapisu
+ * @param[in] x : liczba
+ * @return wskaźnik na pierwszy bajt za zapisem liczby
+ */
+static inline uint8_t *WriteVarint(uint8_t *out, uint64_t x) {
+  while (x >= 0x80) {
+    *out++ = (uint8_t) (x | 0x80);
+    x >>= 7;
+  }
+
+  *out++ = (uint8_t) x;
+
+  return out;
+}
+
+/**
+ * Odczytuje liczbę zapisaną w kodzie zmiennej długości i przesuwa
+ * wskaźnik @p *pos za jej zapis.
+ * @param[in,out] pos : wskaźnik na pierwszy bajt zapisu
+ * @param[in] end : wskaźnik za ostatni dostępny bajt
+ * @param[out] x : odczytana liczba
+ * @return @p false, jeśli zapis jest ucięty lub nie mieści się w 64 bitach;
+ * @p true w przeciwnym razie
+ */
+static inline bool ReadVarint(const uint8_t **pos, const uint8_t *end,
+                              uint64_t *x) {
+  uint64_t value = 0;
+
+  for (unsigned shift = 0; *pos < end && shift < 7 * MAX_VARINT_SIZE;
+       shift += 7) {
+    const uint8_t byte = *(*pos)++;
+
+    // Ostatni bajt liczby 64-bitowej może przechowywać tylko jeden bit
+    if (shift == 7 * (MAX_VARINT_SIZE - 1) && byte > 1) {
+      return false;
+    }
+
+    value |= (uint64_t) (byte & 0x7f) << shift;
+
+    if (byte < 0x80) {
+      *x = value;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Zwraca liczbę bajtów zapisu binarnego wielomianu (bez nagłówka).
+ * @param[in] p : wielomian (być może zamrożony)
+ * @return długość zapisu wielomianu @p p
+ */
+static size_t SerializedSize(const Poly *p) {
+  if (PolyIsCoeff(p)) {
+    return 1 + VarintSize(ZigZagEncode(p->coeff));
+  }
+
+  size_t size = VarintSize(p->size);
+  poly_exp_t prev = 0;
+
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly coeff = ResolveCoeff(p, i);
+
+    size += VarintSize((uint64_t) (MonoGetExp(&p->arr[i]) - prev));
+    size += SerializedSize(&coeff);
+    prev = MonoGetExp(&p->arr[i]);
+  }
+
+  return size;
+}
+
+/**
+ * Zapisuje wielomian w postaci binarnej (bez nagłówka).
+ * @param[in] p : wielomian (być może zamrożony)
+ * @param[in] out : miejsce zapisu
+ * @return wskaźnik na pierwszy bajt za zapisem wielomianu
+ */
+static uint8_t *SerializePoly(const Poly *p, uint8_t *out) {
+  if (PolyIsCoeff(p)) {
+    *out++ = 0;
+    return WriteVarint(out, ZigZagEncode(p->coeff));
+  }
+
+  out = WriteVarint(out, p->size);
+
+  poly_exp_t prev = 0;
+
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly coeff = ResolveCoeff(p, i);
+
+    out = WriteVarint(out, (uint64_t) (MonoGetExp(&p->arr[i]) - prev));
+    out = SerializePoly(&coeff, out);
+    prev = MonoGetExp(&p->arr[i]);
+  }
+
+  return out;
+}
+
 /**
- * Jeśli wielomian jest stały, to zwraca odpowiedni stopień. 
- * W przypadku wielomianu nie będącego wielomianem stałym, sumuje 
- * wykładnik każdego z jednomianów z wynikiem otrzymanym z odpowiadającego
- * mu wielomianu i aktualizuje wynik. Następnie zwraca najwyższy z nich.
+ * Zapis wielomianu stałego składa się z bajtu zerowego i współczynnika
+ * zakodowanego funkcją @p ZigZagEncode. Zapis wielomianu niestałego
+ * składa się z liczby jednomianów i kolejnych jednomianów: różnicy
+ * wykładnika i wykładnika poprzedniego jednomianu (dla pierwszego
+ * jednomianu -- samego wykładnika) oraz zapisu współczynnika. Wszystkie
+ * liczby są zapisywane w kodzie zmiennej długości. Długość zapisu jest
+ * obliczana przed jego utworzeniem, więc tablica ma dokładnie taki rozmiar.
  */
-poly_exp_t PolyDeg(const Poly *p) {
-  assert(p != NULL);
+uint8_t *PolySerialize(const Poly *p, size_t *size) {
+  assert(p != NULL && size != NULL);
 
-  if (PolyIsCoeff(p)) {
-    if (PolyIsZero(p)) { return -1; }
-    else               { return  0; }
-  }
-  else {
-    // Największy znaleziony dotąd wynik
-    poly_exp_t maxExp = -1;
-    poly_exp_t tmpResult;
+  *size = SERIAL_HEADER_SIZE + SerializedSize(p);
 
-    for (size_t i = 0; i < p->size; i++) {
-      // Nie jest to możliwe, aby któryś z jednomianów był
-      // tożsamościowo równy zeru
-      tmpResult = PolyDeg(&p->arr[i].p) + MonoGetExp(&p->arr[i]);
+  uint8_t *data = malloc(*size);
 
-      //Aktualizuje wynik
-      if (tmpResult > maxExp) {
-        maxExp = tmpResult;
-      }
-    }
+  CHECK_PTR(data);
 
-    return maxExp;
-  }
-}
+  memcpy(data, SERIAL_MAGIC, sizeof(SERIAL_MAGIC));
+  data[sizeof(SERIAL_MAGIC)] = POLY_SERIAL_VERSION;
 
-///////////////////////////
-//                       //
-//       PolyIsEq        //
-//                       //
-///////////////////////////
+  uint8_t *end = SerializePoly(p, data + SERIAL_HEADER_SIZE);
+
+  assert(end == data + *size);
+  (void) end;
+
+  return data;
+}
 
 /**
- * Sprawdza, czy żaden ze wskaźników na wielomiany
- * nie jest pustym wskaźnikiem.
- * Następnie bada rodzaj wielomianów: wielomian stały / niestały.
- * Jeśli nie są tego samego rodzaju -- nie mogą być równe.
- * Jeśli oba są wielomianami stałymi -- porównuje ich współczynniki.
- * Jeśli oba są wielomianami niestałymi -- porównuje każdy z ich jednomianów.
+ * Odczytuje wielomian zapisany funkcją @p SerializePoly i przesuwa
+ * wskaźnik @p *pos za jego zapis. Sprawdza wszystkie niezmienniki
+ * wielomianu: wykładniki jednomianów muszą rosnąć i mieścić się w zakresie
+ * typu @p poly_exp_t, współczynniki nie mogą być zerowe, a wielomian nie może
+ * składać się z jednego jednomianu równego stałej.
+ * @param[in,out] pos : wskaźnik na pierwszy bajt zapisu
+ * @param[in] end : wskaźnik za ostatni dostępny bajt
+ * @param[out] p : odczytany wielomian
+ * @return @p false, jeśli zapis jest niepoprawny; @p true w przeciwnym razie
+ *
+ * @details
+ * Liczba jednomianów jest znana przed ich odczytaniem, więc tablica
+ * jednomianów jest alokowana od razu w docelowym rozmiarze. Każdy jednomian
+ * zajmuje co najmniej dwa bajty, dzięki czemu uszkodzony zapis nie może
+ * wymusić alokacji większej niż dwukrotność długości danych.
  */
-bool PolyIsEq(const Poly *p, const Poly *q) {
-  assert(p != NULL && q != NULL);
+static bool DeserializePoly(const uint8_t **pos, const uint8_t *end,
+                            Poly *p) {
+  uint64_t size;
 
-  if (PolyIsCoeff(p) && PolyIsCoeff(q)) {
-    return p->coeff == q->coeff;
-  }
-  else if (PolyIsCoeff(p) || PolyIsCoeff(q)) {
+  if (!ReadVarint(pos, end, &size)) {
     return false;
   }
-  else {
-    // Jeśli wielomiany nie mają takiej samej liczby jednomianów,
-    // nie mogą być równe
-    if (p->size != q->size) {
-      return false;
-    }
 
-    // Porównywanie każdego z jednomianów. Najpierw ich wykładniki,
-    // a potem równość wielomianów, z których są złożone
-    for (size_t i = 0; i < p->size; i++) {
-      if (MonoGetExp(&p->arr[i]) != MonoGetExp(&q->arr[i])) {
-        return false;
-      }
-      else if (!PolyIsEq(&p->arr[i].p, &q->arr[i].p)) {
-        return false;
-      }
+  // Wielomian stały
+  if (size == 0) {
+    uint64_t coeff;
+
+    if (!ReadVarint(pos, end, &coeff)) {
+      return false;
     }
 
+    *p = PolyFromCoeff(ZigZagDecode(coeff));
     return true;
   }
-}
 
-//////////////////////////
-//                      //
-//        PolyAt        //
-//                      //
-//////////////////////////
+  if (size > (uint64_t) (end - *pos) / 2) {
+    return false;
+  }
 
-/**
- * Zwraca wynik potęgowania liczby całkowitej do naturalnej potęgi. 
- * Zakłada, że @f$0^0 = 1@f$. Korzysta z algortymu szybkiego potęgowania.
- * @param[in] base : podstawa potęgi
- * @param[in] exp : wykładnik
- * @return @f$base ^ { exp }@f$
- */
-static inline poly_coeff_t FastExp(poly_coeff_t base, poly_exp_t exp) {
-  poly_coeff_t accumulator = 1;
+  Mono *monos = AllocMonos(size);
+  // Liczba poprawnie odczytanych jednomianów
+  size_t count = 0;
+  // Wykładnik poprzedniego jednomianu
+  uint64_t exp = 0;
 
-  while (exp > 0) {
-    if (exp % 2 != 0) {
-      accumulator *= base;
+  while (count < size) {
+    uint64_t delta;
+
+    // Wykładniki muszą rosnąć i mieścić się w zakresie typu poly_exp_t
+    if (!ReadVarint(pos, end, &delta) || (count > 0 && delta == 0) ||
+        delta > (uint64_t) INT_MAX - exp) {
+      break;
     }
 
-    base *= base;
-    exp /= 2;
+    exp += delta;
+
+    if (!DeserializePoly(pos, end, &monos[count].p)) {
+      break;
+    }
+
+    monos[count].exp = (poly_exp_t) exp;
+    count++;
+
+    if (PolyIsZero(&monos[count - 1].p)) {
+      break;
+    }
   }
 
-  return accumulator;
+  // Błędny zapis lub wielomian równy stałej -- usunięcie
+  // odczytanych jednomianów
+  if (count < size || PolyIsZero(&monos[count - 1].p) ||
+      (size == 1 && exp == 0 && PolyIsCoeff(&monos[0].p))) {
+    for (size_t i = 0; i < count; i++) {
+      MonoDestroy(&monos[i]);
+    }
+
+    FreeMonos(monos);
+    return false;
+  }
+
+  *p = PolyFromMonoArr(monos, size);
+  return true;
 }
 
 /**
- * Na początku sprawdza, czy wskaźnik na wielomian nie jest pusty.
- * Jeśli wielomian jest stały, to zwraca jego kopię (w każdym punkcie
- * jest sobie równy). W przeciwnym wypadku, rozważa dwa przypadki. Jeśli
- * argument jest równy zeru, zwraca wielomian odpowiadający jednomianowi
- * o wykładniku równym zeru (lub wielomian zerowy, jeśli takiego nie posiada).
- * Inaczej argument jest różny od zera. Wówczas, mając jednomian @f$px_i^k@f$
- * oblicza @f$p \cdot x^k@f$ dla każdego z jednomianów, a następnie sumuje je.
- * Jest to wynik.
+ * Sprawdza nagłówek zapisu, a następnie odczytuje wielomian w jednym
+ * przebiegu funkcją @p DeserializePoly.
  */
-Poly PolyAt(const Poly *p, poly_coeff_t x) {
-  assert(p != NULL);
+size_t PolyDeserialize(const uint8_t *data, size_t size, Poly *p) {
+  assert(p != NULL && (data != NULL || size == 0));
 
-  if (PolyIsCoeff(p)) {
-    return PolyClone(p);
+  if (size < SERIAL_HEADER_SIZE ||
+      memcmp(data, SERIAL_MAGIC, sizeof(SERIAL_MAGIC)) != 0 ||
+      data[sizeof(SERIAL_MAGIC)] != POLY_SERIAL_VERSION) {
+    return 0;
   }
-  else {
-    // Jako że wykładniki jednomianów nie powtarzają się,
-    // wystarczy rozpatrzeć tylko pierwszy jednomian
-    if (x == 0) {
-      // Jeśli wykładnik jest równy 0, to z równości 0^0 = 1 wynika,
-      // że wynikiem będzie kopia wielomianu,
-      // z którego składa się ten jednomian
-      if (MonoGetExp(&p->arr[0]) == 0) {
-        return PolyClone(&p->arr[0].p);
-      }
-      // W przeciwnym przypadku (gdy nie ma jednomianu o zerowym
-      // wykładniku) wynikiem jest wielomian zerowy
-      else {
-        return PolyZero();
-      }
-    }
-    else {
-      // Zmienne tymczasowe dla wielomianów
-      Poly tmp1, tmp2;
-      // Wartość wielomianu w danym punkcie -- wynik
-      Poly result = PolyZero();
 
-      for (size_t i = 0; i < p->size; i++) {
-        // Oblicza x^k, gdzie k to wartość wykładnika
-        // dla danego jednomianu
-        tmp1 = PolyFromCoeff(FastExp(x, p->arr[i].exp));
-        // Mnoży wielomian, z którego składa się dany jednomian,
-        // z wynikiem potęgowania
-        tmp1 = PolyMul(&p->arr[i].p, &tmp1);
-        // Sumuje aktualny wynik z nowym wielomianem
-        tmp2 = PolyAdd(&result, &tmp1);
-        // Zwalnia nieużywaną już pamięć
-        PolyDestroy(&result);
-        // Aktualizuje wynik
-        result = tmp2;
-        // Zwalnia nieużywaną pamięć
-        PolyDestroy(&tmp1);
-      }
+  const uint8_t *pos = data + SERIAL_HEADER_SIZE;
 
-      return result;
-    }
+  if (!DeserializePoly(&pos, data + size, p)) {
+    return 0;
   }
-}
 
+  return (size_t) (pos - data);
+}
 
 //////////////////////////
 //                      //
-//      PolyCompose     //
+//     Zamrażanie       //
 //                      //
 //////////////////////////
 
+/** Sygnatura rozpoczynająca obraz zamrożonego wielomianu */
+static const char FROZEN_MAGIC[8] = "POLYFRZ";
 
 /**
- * Podnosi wielomian do potęgi. Zakłada, ze przekazany wskaźnik na wielomian
- * wskazuje na istniejącą i poprawną strukturę danych. Zakłada także, że
- * @f$0 ^ 0 = 1@f$.
- * @param[in] p : wielomian
- * @param[in] exp : wartość wykładnika
- * @return @f$p ^ { exp }@f$
- * 
- * @details
- * Funkcja korzysta z algorytmu szybkiego potęgowania. Traktuje ujemne
- * wykładniki jako dodatnie.
+ * Opis rozmiarów typów, od których zależy układ obrazu -- obraz można
+ * wykorzystać tylko na maszynie, na której się zgadzają.
  */
-static inline Poly PolyFastExp(const Poly *p, poly_exp_t exp) {
-  if (exp == 0) {
-    return PolyFromCoeff(1);
-  }
-  else if (exp == 1) {
-    return PolyClone(p);
-  }
+#define FROZEN_LAYOUT ((uint32_t) (sizeof(PolyMeta) << 16 | \
+                                   sizeof(Mono) << 8 | sizeof(void *)))
 
-  // Akumulator
-  Poly acc = PolyFromCoeff(1);
-  // Wielomian wynikowy
-  Poly result = PolyClone(p);
+/** Przesunięcie tablicy jednomianów korzenia względem początku obrazu */
+#define FROZEN_ROOT_OFFSET (FrozenAlign(sizeof(FrozenHeader)) + \
+                            sizeof(PolyMeta))
 
-  while (exp != 0) {
-    Poly tmp;
+/**
+ * Zwraca łączny rozmiar węzłów obrazu odpowiadających wielomianowi i jego
+ * niestałym współczynnikom.
+ * @param[in] p : wielomian (być może zamrożony)
+ * @return rozmiar węzłów
+ */
+static size_t FrozenSize(const Poly *p) {
+  if (PolyIsCoeff(p)) {
+    return 0;
+  }
 
-    if (exp % 2 != 0) {
-      tmp = PolyMul(&acc, &result);
-      PolyDestroy(&acc);
-      acc = tmp;
-    }
+  size_t size = FrozenNodeSize(p->size, Meta(p)->depth);
 
-    // Jeśli `exp` jest równy 1, to nie ma sensu podnosić jeszcze raz
-    // wielomianu do kwadratu, bo i tak nie wykorzystamy go przy
-    // następnym wykonaniu pętli
-    if (exp != 1) {
-      tmp = PolyMul(&result, &result);
-      PolyDestroy(&result);
-      result = tmp;
-    }
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly coeff = ResolveCoeff(p, i);
 
-    exp /= 2;
+    size += FrozenSize(&coeff);
   }
 
-  PolyDestroy(&result);
-
-  return acc;
+  return size;
 }
 
 /**
- * Mnoży wielomiany @f$p@f$ i @f$q@f$, usuwa je z pamięci i zwraca wynik
- * mnożenia. Funkcja zakłada, że przekazane wskaźniki wskazują na istniejące
- * i poprawne struktury danych.
- * @param[in] p : wielomina
- * @param[in] q : wielomian
- * @return @f$p * q@f$
+ * Zapisuje wielomian w obrazie, w kolejności prefiksowej: węzeł wielomianu
+ * poprzedza węzły jego współczynników. Zamiast wskaźnika na tablicę
+ * jednomianów niestałego współczynnika zapisywane jest jej przesunięcie
+ * względem tablicy jednomianów węzła, oznaczone znacznikiem
+ * @p FROZEN_NODE. Stopnie względem wszystkich zmiennych są obliczane
+ * z góry, gdyż obraz jest tylko do odczytu.
+ * @param[in] p : wielomian (być może zamrożony)
+ * @param[in] image : obraz
+ * @param[in] size : rozmiar obrazu
+ * @param[in,out] offset : przesunięcie pierwszego wolnego bajtu obrazu
+ * @param[in] from : przesunięcie tablicy jednomianów rodzica lub @p 0 dla
+ * korzenia, którego położenie jest liczone od początku obrazu
+ * @return wielomian z przesunięciem zamiast wskaźnika
  */
-static inline Poly SmartPolyMul(Poly *p, Poly *q) {
-  Poly tmp = PolyMul(p, q);
-  PolyDestroy(p);
-  PolyDestroy(q);
-  
-  return tmp;
+static Poly FreezePoly(const Poly *p, char *image, const size_t size,
+                       size_t *offset, const size_t from) {
+  if (PolyIsCoeff(p)) {
+    return *p;
+  }
+
+  const poly_exp_t depth = Meta(p)->depth;
+  PolyMeta *meta = (PolyMeta *) (image + *offset);
+  Mono *monos = (Mono *) (meta + 1);
+  poly_exp_t *degBy = (poly_exp_t *) (monos + p->size);
+  // Przesunięcie tablicy jednomianów w obrazie
+  const size_t monosOffset = *offset + sizeof(PolyMeta);
+
+  *offset += FrozenNodeSize(p->size, depth);
+
+  *meta = (PolyMeta) {
+    .terms = Meta(p)->terms,
+    .hash = Meta(p)->hash,
+    .frozen = (size - monosOffset) << FROZEN_TAG_BITS | FROZEN_NODE |
+              (from == 0 ? FROZEN_ROOT : 0),
+    .deg = Meta(p)->deg,
+    .depth = depth
+  };
+
+  for (poly_exp_t i = 0; i < depth; i++) {
+    degBy[i] = PolyDegBy(p, (size_t) i);
+  }
+
+  for (size_t i = 0; i < p->size; i++) {
+    const Poly coeff = ResolveCoeff(p, i);
+
+    monos[i] = (Mono) {
+      .p = FreezePoly(&coeff, image, size, offset, monosOffset),
+      .exp = MonoGetExp(&p->arr[i])
+    };
+  }
+
+  return (Poly) {.size = p->size,
+                 .arr = (Mono *) ((monosOffset - from) | FROZEN_NODE)};
 }
 
 /**
- * Dodaje wielomiany @f$p@f$ i @f$q@f$, usuwa je z pamięci i zwraca wynik
- * dodawania. Funkcja zakłada, że przekazane wskaźniki wskazują na istniejące
- * i poprawne struktury danych.
- * @param[in] p : wielomina
- * @param[in] q : wielomian
- * @return @f$p + q@f$
+ * Obraz składa się z nagłówka @p FrozenHeader i węzłów zapisanych funkcją
+ * @p FreezePoly, z węzłem korzenia bezpośrednio za nagłówkiem. Obraz
+ * nie zawiera żadnych wskaźników, więc nie zależy od adresu, pod którym
+ * zostanie odwzorowany.
  */
-static inline Poly SmartPolyAdd(Poly *p, Poly *q) {
-  Poly tmp = PolyAdd(p, q);
-  PolyDestroy(p);
-  PolyDestroy(q);
+bool PolyFreeze(const Poly *p, const char *path) {
+  assert(p != NULL && path != NULL);
+
+  const size_t offset = FrozenAlign(sizeof(FrozenHeader));
+  const size_t size = offset + FrozenSize(p);
+  char *image = calloc(size, 1);
 
-  return tmp;
+  CHECK_PTR(image);
+
+  FrozenHeader *header = (FrozenHeader *) image;
+  size_t end = offset;
+
+  memcpy(header->magic, FROZEN_MAGIC, sizeof(FROZEN_MAGIC));
+  header->version = POLY_FROZEN_VERSION;
+  header->layout = FROZEN_LAYOUT;
+  header->size = size;
+  header->root = FreezePoly(p, image, size, &end, 0);
+
+  assert(end == size);
+
+  FILE *file = fopen(path, "wb");
+  bool written = false;
+
+  if (file != NULL) {
+    written = fwrite(image, 1, size, file) == size;
+    // Błąd może zostać zgłoszony dopiero przy zamknięciu pliku
+    written = fclose(file) == 0 && written;
+  }
+
+  free(image);
+  return written;
 }
 
 /**
- * Oblicza wartość złożenia wielomianu @f$p@f$ z @f$k@f$ wielomianami,
- * z których składa się tablica @p q. Funkcja zakłada, że przekazane
- * wskaźniki wskazują na istniejące i poprawne struktury danych.
- * @param[in] p : wielomian
- * @param[in] level : indeks głównej zmiennej w wielomianie @f$p@f$
- * @param[in] k : liczba wielomianów w tablicy @p q
- * @param[in] q : tablica wielomianów
- * @return Złożenie wielomianu @f$p@f$ z wielomianami z tablicy @p q.
+ * Odwzorowuje plik tylko do odczytu pod adresem wybranym przez jądro.
+ * Obraz nie zawiera wskaźników, więc nie jest przesuwany ani przeglądany:
+ * w czasie stałym sprawdzane są jedynie nagłówek obrazu i węzeł korzenia,
+ * a pozostałe węzły -- dopiero przy odczycie funkcją @p ResolveFrozen.
  */
-static inline Poly AuxPolyCompose(const Poly *p, const size_t level,
-                                  const size_t k, const Poly q[]) {
-  if (PolyIsCoeff(p)) {
-    return PolyClone(p);
+bool PolyLoadFrozen(const char *path, Poly *p) {
+  assert(path != NULL && p != NULL);
+
+  const int fd = open(path, O_RDONLY);
+
+  if (fd < 0) {
+    return false;
   }
-  else if (level + 1 > k || PolyIsZero(&q[level])) {
-    if (MonoGetExp(&p->arr[0]) == 0) {
-      return AuxPolyCompose(&p->arr[0].p, level + 1, k, q);
-    }
-    else {
-      return PolyZero();
-    }
+
+  struct stat info;
+  FrozenHeader header;
+
+  if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(header) ||
+      pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header) ||
+      memcmp(header.magic, FROZEN_MAGIC, sizeof(FROZEN_MAGIC)) != 0 ||
+      header.version != POLY_FROZEN_VERSION || header.layout != FROZEN_LAYOUT ||
+      header.size != (uint64_t) info.st_size) {
+    close(fd);
+    return false;
   }
 
-  // Suma wyników jednomianów, z których składa się `p`; wynik funkcji
-  Poly sum = PolyZero();
-  // Wielomiany pomocnicze
-  Poly tmp, tmp2;
-  // Wielomian `q[level]` podniesiony do kolejnych potęg odpowiadających
-  // jednomianom, z których składa się wielomian `p`
-  Poly exp = PolyFromCoeff(1);
-  // Wartość wykładnika ostatniego analizowanego jednomianu
-  poly_exp_t expVal = 0;
-  
-  for (size_t i = 0; i < p->size; i++) {
-    // Wielomian po złożeniu z wielomianami z tablicy `q`
-    tmp = AuxPolyCompose(&p->arr[i].p, level + 1, k, q);
-    
-    if (!PolyIsZero(&tmp)) {
-      tmp2 = PolyFastExp(&q[level], MonoGetExp(&p->arr[i]) - expVal);
-      if (!PolyIsZero(&tmp2)) {
-        exp = SmartPolyMul(&exp, &tmp2);
-        // Aktualizacja wartości wykładnika
-        expVal = MonoGetExp(&p->arr[i]);
-        if (!PolyIsZero(&exp)) {
-          // Obliczenie wartości tego jednomianu po podstawieniu
-          // wielomianu `q[level]`
-          tmp2 = PolyMul(&tmp, &exp);
-          PolyDestroy(&tmp);
+  // Wielomian stały -- nie ma czego odwzorowywać
+  if (PolyIsCoeff(&header.root)) {
+    close(fd);
+    *p = header.root;
+    return true;
+  }
 
-          if (!PolyIsZero(&tmp2)) {
-            // Sumowanie wyniku
-            sum = SmartPolyAdd(&sum, &tmp2);
-          }
-        }
-        else {
-          PolyDestroy(&tmp);
-        }
-      }
-      else {
-        PolyDestroy(&tmp);
-      }
-    }
+  const size_t size = (size_t) header.size;
+
+  // Korzeń musi zaczynać się bezpośrednio za nagłówkiem
+  if ((uintptr_t) header.root.arr != (FROZEN_ROOT_OFFSET | FROZEN_NODE) ||
+      size < FROZEN_ROOT_OFFSET || header.root.size == 0 ||
+      header.root.size > (size - FROZEN_ROOT_OFFSET) / sizeof(Mono)) {
+    close(fd);
+    return false;
   }
 
-  PolyDestroy(&exp);
+  char *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  close(fd);
+
+  if (image == MAP_FAILED) {
+    return false;
+  }
+
+  const Poly root = {.size = header.root.size,
+                     .arr = (Mono *) (image + FROZEN_ROOT_OFFSET)};
+  const PolyMeta *meta = Meta(&root);
+
+  // Węzeł korzenia musi mieścić się w obrazie
+  if (meta->frozen != ((size - FROZEN_ROOT_OFFSET) << FROZEN_TAG_BITS |
+                       FROZEN_NODE | FROZEN_ROOT) ||
+      meta->depth <= 0 || FrozenNodeSize(root.size, meta->depth) >
+                          size - FrozenAlign(sizeof(FrozenHeader))) {
+    munmap(image, size);
+    return false;
+  }
 
-  return sum;
+  *p = root;
+  return true;
 }
 
 /**
- * Wywołuje funkcję @p AuxPolyCompose dla wielomianu @f$p@f$, zaczynając
- * od podstawienia pierwszego z wielomianów pod zmienną @f$x_0@f$. Następnie
- * zwraca wynik.
+ * Wielomian jest zamrożony, jeśli jego nagłówek jest oznaczony znacznikiem
+ * @p FROZEN_NODE.
  */
-Poly PolyCompose(const Poly *p, size_t k, const Poly q[]) {
-  return AuxPolyCompose(p, 0, k, q);
-}
-
+bool PolyIsFrozen(const Poly *p) {
+  assert(p != NULL);
 
+  return IsFrozen(p);
+}
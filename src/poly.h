@@ -16,6 +16,7 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /** Type representing coefficients of a polynomial */
 typedef long poly_coeff_t;
@@ -46,7 +47,12 @@ typedef struct Poly {
 	 * Array consisting of monomials. They are sorted in regard to
 	 * the value of their corresponding exponents. None of the monomials
 	 * is equal to zero. It never consists of a single monomial
-	 * corresponding to a constant polynomial.
+	 * corresponding to a constant polynomial. The array is allocated
+	 * by the library together with a header caching the degree, depth
+	 * and term count of the polynomial, so it must never be allocated,
+	 * reallocated or freed directly. The coefficients of a polynomial
+	 * mapped by `PolyLoadFrozen` store offsets instead of pointers, so
+	 * its monomials must only be read by the functions of the library.
 	 */
 	struct Mono *arr;
 } Poly;
@@ -161,6 +167,18 @@ static inline Mono MonoClone(const Mono *m) {
  */
 Poly PolyAdd(const Poly *p, const Poly *q);
 
+/**
+ * Sums two polynomials taking ownership of both of them.
+ * The memory allocated for @p p and @p q is reused or freed,
+ * and both of them are set to zero polynomials afterwards.
+ * When one polynomial has many more monomials than the other,
+ * the bigger one is updated in place.
+ * @param[in,out] p : polynomial @f$p@f$
+ * @param[in,out] q : polynomial @f$q@f$ (distinct from @p p)
+ * @return @f$p + q@f$
+ */
+Poly PolyAddOwn(Poly *p, Poly *q);
+
 /**
  * Sums an array of monomials and creates a polynomial
  * formed from the result. The created polynomial
@@ -172,10 +190,26 @@ Poly PolyAdd(const Poly *p, const Poly *q);
  */
 Poly PolyAddMonos(size_t count, const Mono monos[]);
 
+/**
+ * Creates a polynomial from an array of monomials sorted in strictly
+ * ascending order of exponents, none of which is a zero monomial.
+ * The monomials are neither sorted nor merged. The created polynomial
+ * is responsible for freeing the memory allocated for the monomials
+ * in the array @p monos; the array itself is copied.
+ * If @p count is equal to zero or if @p monos is a NULL pointer,
+ * returns a zero polynomial.
+ * @param[in] count : number of monomials
+ * @param[in] monos : array of monomials
+ * @return polynomial being the sum of the monomials
+ */
+Poly PolyAddSortedMonos(size_t count, const Mono monos[]);
+
 /**
  * Sums an array of monomials and creates a polynomial
  * formed from the result. The polynomial is responsible for
  * freeing the allocated memory for the monomials and the array @p monos.
+ * The array must have been allocated with @p malloc; it may be moved
+ * by @p realloc to make room for the polynomial's header.
  * If @p count is equal to zero or if @p monos is a NULL pointer,
  * returns a zero polynomial.
  * @param[in] count : number of monomials
@@ -195,6 +229,48 @@ Poly PolyOwnMonos(size_t count, Mono *monos);
  */
 Poly PolyCloneMonos(size_t count, const Mono monos[]);
 
+/** Name of the environment variable overriding the multiplication
+    cost model thresholds, e.g. `hash_min_terms=64,hash_distinct_cost=12` */
+#define POLY_MUL_CONFIG_ENV "POLY_MUL_CONFIG"
+
+/**
+ * Thresholds of the cost model that selects the multiplication kernel
+ * at every level of recursion of `PolyMul`. The costs are relative to one
+ * step of merging sorted rows of monomial products.
+ */
+typedef struct PolyMulConfig {
+	size_t hash_min_terms; ///< fewest pairwise products for which the hash kernel is considered
+	unsigned hash_probe_cost; ///< cost of inserting a product into the hash table
+	unsigned hash_distinct_cost; ///< cost of handling a distinct exponent in the hash table
+	size_t unbalanced_min_ratio; ///< smallest ratio of operand sizes for which rows of the product are merged on the fly
+} PolyMulConfig;
+
+/**
+ * Reads the current multiplication cost model thresholds. Unless they were
+ * set with `PolyMulConfigSet`, they are the defaults overridden by the
+ * environment variable #POLY_MUL_CONFIG_ENV.
+ * @param[out] config : thresholds
+ */
+void PolyMulConfigGet(PolyMulConfig *config);
+
+/**
+ * Sets the multiplication cost model thresholds. Takes precedence over
+ * the environment variable #POLY_MUL_CONFIG_ENV. Must not be called while
+ * other threads multiply polynomials.
+ * @param[in] config : thresholds
+ */
+void PolyMulConfigSet(const PolyMulConfig *config);
+
+/**
+ * Updates thresholds from a string of comma-separated `name=value` pairs,
+ * where the names are those of the fields of #PolyMulConfig. Fields not
+ * mentioned in the string are left unchanged.
+ * @param[in] str : string with thresholds
+ * @param[in,out] config : thresholds
+ * @return @p false if the string is malformed (then @p config is unchanged)
+ */
+bool PolyMulConfigParse(const char *str, PolyMulConfig *config);
+
 /**
  * Multiplies two polynomials.
  * @param[in] p : polynomial @f$p@f$
@@ -203,6 +279,139 @@ Poly PolyCloneMonos(size_t count, const Mono monos[]);
  */
 Poly PolyMul(const Poly *p, const Poly *q);
 
+/**
+ * Multiplies two polynomials taking ownership of both of them.
+ * The memory allocated for @p p and @p q is reused or freed,
+ * and both of them are set to zero polynomials afterwards.
+ * When one of the polynomials is constant or consists of a single
+ * monomial, the other one is multiplied in place: its exponents
+ * are shifted and its coefficients scaled in one pass.
+ * @param[in,out] p : polynomial @f$p@f$
+ * @param[in,out] q : polynomial @f$q@f$ (distinct from @p p)
+ * @return @f$p * q@f$
+ */
+Poly PolyMulOwn(Poly *p, Poly *q);
+
+/**
+ * Adds the product of two polynomials to an accumulator:
+ * @f$acc \leftarrow acc + a \cdot b@f$. The accumulator is modified
+ * in place. When the factors differ a lot in size, the rows of the
+ * product are merged into @p acc as they are generated, without
+ * materializing the product; otherwise the product is computed with
+ * the kernel chosen by `PolyMul` and added to @p acc.
+ * @param[in,out] acc : accumulator
+ * @param[in] a : polynomial @f$a@f$
+ * @param[in] b : polynomial @f$b@f$
+ */
+void PolyFma(Poly *acc, const Poly *a, const Poly *b);
+
+/**
+ * Sums an array of polynomials in a single pass: the monomial arrays
+ * of all the polynomials are merged at once using a loser tree, and
+ * coefficients with equal exponents are summed recursively. Unlike
+ * repeated `PolyAdd`, the result is written only once.
+ * It doesn't modify the polynomials from @p ps.
+ * @param[in] n : number of polynomials
+ * @param[in] ps : array of polynomials
+ * @return @f$ps_0 + ps_1 + \ldots + ps_{n-1}@f$
+ */
+Poly PolySumMany(size_t n, const Poly ps[]);
+
+/** Number of buckets of a polynomial accumulator */
+#define POLY_ACCUM_BUCKETS 32
+
+/**
+ * Accumulator for long sequences of additions (a geobucket).
+ * Bucket @f$i@f$ holds a partial sum of at most @f$4^{i+1}@f$ terms
+ * (the last bucket is unbounded). An added polynomial is merged into the
+ * bucket matching its size, and a bucket is merged into the next one only
+ * when it overflows, so @f$n@f$ additions of @f$N@f$ terms in total cost
+ * @f$O(N \log n)@f$ instead of @f$O(N \cdot n)@f$.
+ */
+typedef struct PolyAccum {
+	Poly buckets[POLY_ACCUM_BUCKETS]; ///< partial sums
+} PolyAccum;
+
+/**
+ * Initializes an empty accumulator (equal to zero).
+ * @param[out] acc : accumulator
+ */
+void PolyAccumInit(PolyAccum *acc);
+
+/**
+ * Adds a polynomial to an accumulator. The accumulator takes ownership
+ * of @p p, which is set to a zero polynomial.
+ * @param[in,out] acc : accumulator
+ * @param[in,out] p : polynomial
+ */
+void PolyAccumAdd(PolyAccum *acc, Poly *p);
+
+/**
+ * Returns the sum of all polynomials added to an accumulator
+ * and leaves the accumulator empty.
+ * @param[in,out] acc : accumulator
+ * @return sum of the accumulated polynomials
+ */
+Poly PolyAccumFinish(PolyAccum *acc);
+
+/**
+ * Squares a polynomial. Equivalent to `PolyMul(p, p)`, but every
+ * product of two distinct monomials is computed only once and doubled.
+ * @param[in] p : polynomial @f$p@f$
+ * @return @f$p^2@f$
+ */
+Poly PolySqr(const Poly *p);
+
+/**
+ * Raises a polynomial to a non-negative power (@f$0^0 = 1@f$).
+ * The strategy depends on the shape of the polynomial: multinomial
+ * expansion for polynomials with few terms, J.C.P. Miller's recurrence
+ * for univariate polynomials with constant coefficients (when it does not
+ * overflow) and repeated squaring otherwise.
+ * @param[in] p : polynomial @f$p@f$
+ * @param[in] n : exponent @f$n \ge 0@f$
+ * @return @f$p^n@f$
+ */
+Poly PolyPow(const Poly *p, poly_exp_t n);
+
+/**
+ * Truncates a polynomial: removes all of its terms whose degree
+ * in regard to the variable with index @p var_idx exceeds @p n.
+ * @param[in] p : polynomial @f$p@f$
+ * @param[in] var_idx : index of the variable
+ * @param[in] n : degree bound @f$n \ge 0@f$
+ * @return @f$p@f$ truncated above degree @f$n@f$
+ */
+Poly PolyTrunc(const Poly *p, size_t var_idx, poly_exp_t n);
+
+/**
+ * Multiplies two polynomials, keeping only the terms whose degree
+ * in regard to the variable with index @p var_idx does not exceed @p n.
+ * Terms above the bound are never generated, so both work and memory
+ * are bounded by the size of the truncated result rather than
+ * by the size of the full product.
+ * @param[in] p : polynomial @f$p@f$
+ * @param[in] q : polynomial @f$q@f$
+ * @param[in] var_idx : index of the variable
+ * @param[in] n : degree bound @f$n \ge 0@f$
+ * @return @f$p * q@f$ truncated above degree @f$n@f$
+ */
+Poly PolyMulTrunc(const Poly *p, const Poly *q, size_t var_idx,
+                  poly_exp_t n);
+
+/**
+ * Raises a polynomial to a non-negative power, keeping only the terms
+ * whose degree in regard to the variable with index @p var_idx does not
+ * exceed @p n. Every intermediate product is truncated as well.
+ * @param[in] p : polynomial @f$p@f$
+ * @param[in] exp : exponent @f$e \ge 0@f$
+ * @param[in] var_idx : index of the variable
+ * @param[in] n : degree bound @f$n \ge 0@f$
+ * @return @f$p^e@f$ truncated above degree @f$n@f$
+ */
+Poly PolyPowTrunc(const Poly *p, poly_exp_t exp, size_t var_idx,
+                  poly_exp_t n);
+
 /**
  * Returns the opposite (negated) polynomial.
  * @param[in] p : polynomial @f$p@f$
@@ -218,6 +427,16 @@ Poly PolyNeg(const Poly *p);
  */
 Poly PolySub(const Poly *p, const Poly *q);
 
+/**
+ * Subtracts one polynomial from another taking ownership of both of them.
+ * The memory allocated for @p p and @p q is reused or freed,
+ * and both of them are set to zero polynomials afterwards.
+ * @param[in,out] p : polynomial @f$p@f$
+ * @param[in,out] q : polynomial @f$q@f$ (distinct from @p p)
+ * @return @f$p - q@f$
+ */
+Poly PolySubOwn(Poly *p, Poly *q);
+
 /**
  * Returns the degree of a polynomial in regard to the index of the variable
  * (-1 for a constant zero polynomial). The variables are indexed from 0.
@@ -245,6 +464,42 @@ poly_exp_t PolyDeg(const Poly *p);
  */
 bool PolyIsEq(const Poly *p, const Poly *q);
 
+/**
+ * Returns a 64-bit structural hash of a polynomial. Equal polynomials
+ * always have equal hashes, so the value can be used as a cache key.
+ * The hash is computed once, when the polynomial is built, so this
+ * function runs in constant time.
+ * @param[in] p : polynomial @f$p@f$
+ * @return hash of @f$p@f$
+ */
+uint64_t PolyHash(const Poly *p);
+
+/**
+ * Checks if a polynomial is equal to the product of @p count factors
+ * without multiplying them, using a randomized test: @p p and the factors
+ * are evaluated at random points modulo the prime @f$2^{61} - 1@f$.
+ * An evaluation takes time roughly linear in the total number of terms
+ * of @p p and the factors, while expanding the product takes time
+ * proportional to the number of pairs of terms, so the test pays off when
+ * the product has many more terms than its factors. A product of zero
+ * or one factor is compared exactly with `PolyIsEq`, which is always
+ * faster than evaluating two expanded polynomials.
+ * A result of `false` is always correct, while `true` may be wrong with
+ * probability at most @f$(d / (2^{61} - 1))^{trials}@f$, where @f$d@f$ is
+ * the degree of the difference, unless every coefficient of the difference
+ * is a multiple of the prime. The product is taken with exact integer
+ * coefficients, so the result may differ from comparing with the result
+ * of `PolyMul` when the latter overflows. The points are chosen
+ * deterministically, so the result is reproducible.
+ * @param[in] p : polynomial @f$p@f$
+ * @param[in] count : number of factors
+ * @param[in] factors : factors @f$f_0, \ldots, f_{count - 1}@f$
+ * @param[in] trials : number of evaluations (greater than zero)
+ * @return whether @f$p = f_0 \cdots f_{count - 1}@f$ with high probability
+ */
+bool PolyProbablyEqProduct(const Poly *p, size_t count, const Poly factors[],
+                           unsigned trials);
+
 /**
  * Computes the value of a polynomial at point @p x
  * by applying the argument to the main variable of the polynomial
@@ -269,4 +524,75 @@ Poly PolyAt(const Poly *p, poly_coeff_t x);
  */
 Poly PolyCompose(const Poly *p, size_t k, const Poly q[]);
 
+/** Version of the binary format written by `PolySerialize` */
+#define POLY_SERIAL_VERSION 1
+
+/**
+ * Encodes a polynomial in a compact, versioned binary format. The encoding
+ * starts with the signature `POLY` and the version of the format, followed
+ * by the tree of monomials. Exponents are stored as differences between
+ * consecutive exponents and coefficients in the zigzag encoding, all as
+ * variable-length integers.
+ * @param[in] p : polynomial
+ * @param[out] size : length of the encoding in bytes
+ * @return array of @p *size bytes allocated with `malloc`
+ */
+uint8_t *PolySerialize(const Poly *p, size_t *size);
+
+/**
+ * Decodes a polynomial encoded by `PolySerialize` in a single pass. Every
+ * array of monomials is allocated with its exact size. The encoding may be
+ * followed by other data, so the function returns the number of bytes it
+ * has read.
+ * @param[in] data : encoding
+ * @param[in] size : number of available bytes
+ * @param[out] p : decoded polynomial
+ * @return length of the encoding; @p 0 if @p data is not a valid encoding
+ * (then @p p is left unchanged)
+ */
+size_t PolyDeserialize(const uint8_t *data, size_t size, Poly *p);
+
+/** Version of the frozen image format written by `PolyFreeze` */
+#define POLY_FROZEN_VERSION 2
+
+/**
+ * Writes a frozen image of a polynomial to a file. The image is a single
+ * contiguous block holding every level of the polynomial together with
+ * its precomputed metadata. It stores offsets instead of pointers, so it
+ * can be used in place at whatever address `PolyLoadFrozen` maps it. The
+ * image can only be loaded on a machine with the same sizes of types and
+ * byte order.
+ * @param[in] p : polynomial
+ * @param[in] path : path of the file
+ * @return whether the file was written
+ */
+bool PolyFreeze(const Poly *p, const char *path);
+
+/**
+ * Maps a frozen image written by `PolyFreeze` into memory, read-only, and
+ * sets @p p to the polynomial it holds, without copying or reading the rest
+ * of the image: only its header and top-level node are checked, in constant
+ * time. The other nodes are checked when they are reached, so an offset in
+ * a damaged image never leads outside the mapping, but such an image may
+ * hold a different polynomial. `PolyDeg`, `PolyDegBy`, `PolyHash`,
+ * `PolyIsEq`, `PolyAt`, `PolyProbablyEqProduct`, `PolyClone`,
+ * `PolySerialize`, `PolyFreeze` and the polynomial being composed by
+ * `PolyCompose` read the image directly. The polynomial can be passed to
+ * every other function of the library, which then works on a copy; functions
+ * taking it over replace it with a copy and unmap the image. `PolyDestroy`
+ * unmaps the image and may be called by any thread.
+ * @param[in] path : path of the file
+ * @param[out] p : polynomial stored in the image
+ * @return whether the image was loaded (if not, @p p is left unchanged)
+ */
+bool PolyLoadFrozen(const char *path, Poly *p);
+
+/**
+ * Checks whether a polynomial refers to a frozen image mapped with
+ * `PolyLoadFrozen`.
+ * @param[in] p : polynomial
+ * @return whether @p p is frozen
+ */
+bool PolyIsFrozen(const Poly *p);
+
 #endif /* __POLY_H__ */
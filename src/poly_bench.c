@@ -0,0 +1,179 @@
+/** @file
+  Program kalibrujący progi modelu kosztu mnożenia wielomianów
+
+  Mierzy czas mnożenia zestawu par wielomianów o różnej liczbie jednomianów,
+  rozpiętości wykładników i głębokości dla siatki progów, a następnie
+  wypisuje najlepsze progi w formacie zmiennej środowiskowej
+  @p POLY_MUL_CONFIG -- na standardowe wyjście lub do pliku podanego jako
+  pierwszy argument programu.
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#include "poly.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Liczba powtórzeń każdego pomiaru; wynikiem jest najkrótszy czas */
+#define REPEATS 3
+
+/** Liczba par mnożonych wielomianów */
+#define NUM_OF_WORKLOADS (sizeof(Workloads) / sizeof(Workloads[0]))
+
+/** Kształt pary mnożonych wielomianów */
+typedef struct {
+  size_t size; ///< liczba jednomianów pierwszego czynnika
+  size_t otherSize; ///< liczba jednomianów drugiego czynnika
+  poly_exp_t range; ///< wykładniki są losowane z przedziału [0, range)
+  int depth; ///< liczba poziomów poniżej najwyższego
+} Workload;
+
+/** Zestaw mierzonych kształtów */
+static const Workload Workloads[] = {
+  { .size = 12,    .otherSize = 12,  .range = 1000000, .depth = 0 },
+  { .size = 40,    .otherSize = 40,  .range = 60,      .depth = 0 },
+  { .size = 40,    .otherSize = 40,  .range = 1000000, .depth = 0 },
+  { .size = 150,   .otherSize = 150, .range = 300,     .depth = 0 },
+  { .size = 150,   .otherSize = 150, .range = 30000,   .depth = 0 },
+  { .size = 250,   .otherSize = 250, .range = 250,     .depth = 0 },
+  { .size = 250,   .otherSize = 250, .range = 1000000, .depth = 0 },
+  { .size = 60,    .otherSize = 60,  .range = 60,      .depth = 1 },
+  { .size = 100,   .otherSize = 100, .range = 20000,   .depth = 1 },
+  { .size = 20,    .otherSize = 20,  .range = 40,      .depth = 2 },
+  { .size = 20000, .otherSize = 4,   .range = 1000000, .depth = 0 },
+  { .size = 5000,  .otherSize = 24,  .range = 20000,   .depth = 0 },
+  { .size = 2000,  .otherSize = 6,   .range = 100000,  .depth = 1 }
+};
+
+/**
+ * Tworzy losowy wielomian o danym kształcie.
+ * @param[in] size : liczba jednomianów
+ * @param[in] range : ograniczenie wykładników
+ * @param[in] depth : liczba poziomów poniżej najwyższego
+ * @return losowy wielomian
+ */
+static Poly RandPoly(size_t size, poly_exp_t range, int depth) {
+  Mono *monos = malloc(size * sizeof(Mono));
+
+  if (monos == NULL) {
+    exit(1);
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    Poly coeff = depth > 0 ? RandPoly(4, 8, depth - 1)
+                           : PolyFromCoeff(1 + rand() % 9);
+    monos[i] = (Mono) {.p = coeff, .exp = rand() % range};
+  }
+
+  return PolyOwnMonos(size, monos);
+}
+
+/**
+ * Mierzy łączny czas mnożenia wszystkich par wielomianów przy aktualnych
+ * progach modelu kosztu.
+ * @param[in] ps : pierwsze czynniki
+ * @param[in] qs : drugie czynniki
+ * @return łączny czas w sekundach
+ */
+static double MeasureAll(const Poly ps[], const Poly qs[]) {
+  double total = 0;
+
+  for (size_t i = 0; i < NUM_OF_WORKLOADS; i++) {
+    double best = -1;
+
+    for (int r = 0; r < REPEATS; r++) {
+      clock_t start = clock();
+      Poly product = PolyMul(&ps[i], &qs[i]);
+      double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+      PolyDestroy(&product);
+
+      if (best < 0 || elapsed < best) {
+        best = elapsed;
+      }
+    }
+
+    total += best;
+  }
+
+  return total;
+}
+
+/**
+ * Przeszukuje siatkę progów i wypisuje najlepsze z nich.
+ */
+int main(int argc, char *argv[]) {
+  static const size_t minTerms[] = {16, 64, 256, 1024};
+  static const unsigned probeCosts[] = {1, 2, 4};
+  static const unsigned distinctCosts[] = {4, 8, 12, 16, 24};
+  static const size_t minRatios[] = {4, 16, 64};
+
+  Poly ps[NUM_OF_WORKLOADS], qs[NUM_OF_WORKLOADS];
+
+  srand(2021);
+
+  for (size_t i = 0; i < NUM_OF_WORKLOADS; i++) {
+    const Workload *w = &Workloads[i];
+
+    ps[i] = RandPoly(w->size, w->range, w->depth);
+    qs[i] = RandPoly(w->otherSize, w->range, w->depth);
+  }
+
+  PolyMulConfig best;
+  PolyMulConfigGet(&best);
+  double bestTime = MeasureAll(ps, qs);
+
+  fprintf(stderr, "current: %.4fs\n", bestTime);
+
+  for (size_t a = 0; a < sizeof(minTerms) / sizeof(minTerms[0]); a++) {
+    for (size_t b = 0; b < sizeof(probeCosts) / sizeof(probeCosts[0]); b++) {
+      for (size_t c = 0; c < sizeof(distinctCosts) / sizeof(distinctCosts[0]);
+           c++) {
+        for (size_t d = 0; d < sizeof(minRatios) / sizeof(minRatios[0]);
+             d++) {
+          PolyMulConfig config = {
+            .hash_min_terms = minTerms[a],
+            .hash_probe_cost = probeCosts[b],
+            .hash_distinct_cost = distinctCosts[c],
+            .unbalanced_min_ratio = minRatios[d]
+          };
+
+          PolyMulConfigSet(&config);
+          double time = MeasureAll(ps, qs);
+
+          if (time < bestTime) {
+            best = config;
+            bestTime = time;
+          }
+        }
+      }
+    }
+  }
+
+  fprintf(stderr, "best: %.4fs\n", bestTime);
+
+  FILE *out = argc > 1 ? fopen(argv[1], "w") : stdout;
+
+  if (out == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  fprintf(out, "hash_min_terms=%zu,hash_probe_cost=%u,hash_distinct_cost=%u,"
+          "unbalanced_min_ratio=%zu\n", best.hash_min_terms,
+          best.hash_probe_cost, best.hash_distinct_cost,
+          best.unbalanced_min_ratio);
+
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  for (size_t i = 0; i < NUM_OF_WORKLOADS; i++) {
+    PolyDestroy(&ps[i]);
+    PolyDestroy(&qs[i]);
+  }
+
+  return 0;
+}
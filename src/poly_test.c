@@ -4,8 +4,11 @@
 
 #include "poly.h"
 #include <assert.h>
+#include <limits.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #define CHECK_PTR(p)  \
@@ -175,6 +178,83 @@ static bool SimpleAddTest(void) {
   return res;
 }
 
+static bool TestAddOwn(Poly a, Poly b, Poly res) {
+  Poly c = PolyAddOwn(&a, &b);
+  bool is_eq = PolyIsEq(&c, &res) && PolyIsZero(&a) && PolyIsZero(&b);
+  PolyDestroy(&c);
+  PolyDestroy(&res);
+  return is_eq;
+}
+
+// Wielomian o jednomianach x_0^2, x_0^4, ..., x_0^{2n} o współczynnikach 1,
+// do którego dodano count jednomianów (przejmowanych na własność)
+static Poly SparsePoly(size_t n, size_t count, const Mono extra[]) {
+  Mono *arr = calloc(n + count, sizeof (Mono));
+  CHECK_PTR(arr);
+  for (size_t i = 0; i < n; i++)
+    arr[i] = M(C(1), 2 * (poly_exp_t) i + 2);
+  for (size_t i = 0; i < count; i++)
+    arr[n + i] = extra[i];
+  Poly res = PolyAddMonos(n + count, arr);
+  free(arr);
+  return res;
+}
+
+// Mały wielomian dla SparsePoly(40, ...): wstawia jednomiany przed
+// początkiem, w środku i za końcem, znosi jeden jednomian i zmienia inny
+#define SMALL_POLY P(C(3), 0, C(3), 5, C(-1), 6, C(2), 8, C(5), 83)
+#define SMALL_MONOS (Mono[]) {M(C(3), 0), M(C(3), 5), M(C(-1), 6), \
+                              M(C(2), 8), M(C(5), 83)}
+#define NEG_SMALL_MONOS (Mono[]) {M(C(-3), 0), M(C(-3), 5), M(C(1), 6), \
+                                  M(C(-2), 8), M(C(-5), 83)}
+
+static bool TestSubOwn(Poly a, Poly b, Poly res) {
+  Poly c = PolySubOwn(&a, &b);
+  bool is_eq = PolyIsEq(&c, &res) && PolyIsZero(&a) && PolyIsZero(&b);
+  PolyDestroy(&c);
+  PolyDestroy(&res);
+  return is_eq;
+}
+
+static bool SimpleAddOwnTest(void) {
+  bool res = true;
+  res &= TestAddOwn(C(1), P(C(1), 1), P(C(1), 0, C(1), 1));
+  res &= TestAddOwn(P(C(-1), 0, C(1), 1), C(1), P(C(1), 1));
+  // Wielomiany o bardzo różnej liczbie jednomianów
+  res &= TestAddOwn(P(C(1), 0, C(1), 1, C(1), 2, C(1), 3, C(1), 4, C(1), 5,
+                      C(1), 6, C(1), 7, C(1), 8, C(1), 9),
+                    P(C(1), 5),
+                    P(C(1), 0, C(1), 1, C(1), 2, C(1), 3, C(1), 4, C(2), 5,
+                      C(1), 6, C(1), 7, C(1), 8, C(1), 9));
+  res &= TestAddOwn(P(C(1), 0, C(1), 1, C(1), 2, C(1), 3, C(1), 4, C(1), 5,
+                      C(1), 6, C(1), 7, C(1), 8, C(1), 9),
+                    P(C(-1), 3, C(2), 11),
+                    P(C(1), 0, C(1), 1, C(1), 2, C(1), 4, C(1), 5, C(1), 6,
+                      C(1), 7, C(1), 8, C(1), 9, C(2), 11));
+  res &= TestAddOwn(P(C(1), 0, C(1), 1, C(1), 2, C(1), 3, C(1), 4, C(1), 5,
+                      C(1), 6, C(1), 7, C(1), 8, C(1), 9),
+                    P(C(-1), 1, C(-1), 2, C(-1), 3, C(-1), 4, C(-1), 5,
+                      C(-1), 6, C(-1), 7, C(-1), 8, C(-1), 9),
+                    C(1));
+  // Wstawianie i znoszenie jednomianów przy wyszukiwaniu wykładniczym
+  res &= TestAddOwn(SparsePoly(40, 0, NULL), SMALL_POLY,
+                    SparsePoly(40, 5, SMALL_MONOS));
+  res &= TestAddOwn(SMALL_POLY, SparsePoly(40, 0, NULL),
+                    SparsePoly(40, 5, SMALL_MONOS));
+  res &= TestSubOwn(SparsePoly(40, 0, NULL), SMALL_POLY,
+                    SparsePoly(40, 5, NEG_SMALL_MONOS));
+  res &= TestSubOwn(SparsePoly(40, 5, SMALL_MONOS), SMALL_POLY,
+                    SparsePoly(40, 0, NULL));
+  Poly a = P(P(C(1), 1), 0, C(2), 2);
+  Poly b = P(P(C(1), 1), 0, C(1), 2);
+  Poly c = PolySubOwn(&a, &b);
+  Poly d = P(C(1), 2);
+  res &= PolyIsEq(&c, &d);
+  PolyDestroy(&c);
+  PolyDestroy(&d);
+  return res;
+}
+
 static bool SimpleAddMonosTest(void) {
   bool res = true;
   {
@@ -206,6 +286,81 @@ static bool SimpleAddMonosTest(void) {
                 M(P(C(2), 2), 2)};
     res &= TestAddMonos(6, m, P(C(2), 0, C(1), 1, P(C(2), 1, C(2), 2), 2));
   }
+  // Małe tablice -- sortowanie przez scalanie; każdy wykładnik występuje
+  // dwa razy, w różnych fragmentach sortowanych przez wstawianie
+  for (poly_exp_t n = 50; n <= 64; n += 14) {
+    Mono m[64], e[32];
+    for (poly_exp_t i = 0; i < n; i++) {
+      m[i] = M(C(1), i * 7 % (n / 2) * 5);
+    }
+    for (poly_exp_t i = 0; i < n / 2; i++) {
+      e[i] = M(C(2), i * 5);
+    }
+    res &= TestAddMonos((size_t) n, m, PolyAddSortedMonos((size_t) n / 2, e));
+  }
+  // Krótkie fragmenty rosnące -- sortowanie pozycyjne; wykładniki zajmują
+  // wszystkie przebiegi, a jednomiany o parzystym k się znoszą
+  {
+    Mono m[300], e[100];
+    for (poly_exp_t i = 0; i < 200; i++) {
+      poly_exp_t k = i * 7919 % 200;
+      m[i] = M(C(k + 1), k * 40000);
+    }
+    for (poly_exp_t k = 0; k < 200; k += 2) {
+      m[200 + k / 2] = M(C(-k - 1), k * 40000);
+      e[k / 2] = M(C(k + 2), (k + 1) * 40000);
+    }
+    res &= TestAddMonos(300, m, PolyAddSortedMonos(100, e));
+  }
+  {
+    Mono m[100];
+    for (poly_exp_t i = 0; i < 50; i++) {
+      m[i] = M(C(1), i * 13 % 50 * 3);
+      m[50 + i] = M(C(-1), i * 17 % 50 * 3);
+    }
+    res &= TestAddMonos(100, m, C(0));
+  }
+  // Długie fragmenty rosnące -- scalanie fragmentów; wykładniki podzielne
+  // przez 10 znoszą się, a wykładniki przystające do 1 się podwajają
+  {
+    Mono m[120], e[90];
+    for (poly_exp_t r = 0; r < 5; r++) {
+      for (poly_exp_t j = 0; j < 20; j++) {
+        m[r * 20 + j] = M(C(1), r + 5 * j);
+      }
+    }
+    for (poly_exp_t j = 0; j < 10; j++) {
+      m[100 + j] = M(C(-1), 10 * j);
+      m[110 + j] = M(C(1), 10 * j + 1);
+    }
+    size_t count = 0;
+    for (poly_exp_t i = 0; i < 100; i++) {
+      if (i % 10 != 0) {
+        e[count++] = M(C(i % 10 == 1 ? 2 : 1), i);
+      }
+    }
+    res &= TestAddMonos(120, m, PolyAddSortedMonos(count, e));
+  }
+  return res;
+}
+
+static bool SimpleAddSortedMonosTest(void) {
+  bool res = true;
+  {
+    Mono m[] = {M(C(3), 0)};
+    Poly b = PolyAddSortedMonos(1, m);
+    res &= PolyIsCoeff(&b) && b.coeff == 3;
+    PolyDestroy(&b);
+  }
+  {
+    Mono m[] = {M(C(2), 0), M(P(C(1), 1), 3), M(C(-1), 7)};
+    Poly b = PolyAddSortedMonos(3, m);
+    Poly c = P(C(2), 0, P(C(1), 1), 3, C(-1), 7);
+    res &= PolyIsEq(&b, &c) && PolyHash(&b) == PolyHash(&c) &&
+           PolyDeg(&b) == 7;
+    PolyDestroy(&b);
+    PolyDestroy(&c);
+  }
   return res;
 }
 
@@ -229,6 +384,64 @@ static bool SimpleMulTest(void) {
   res &= TestMul(P(P(C(1), 2), 0, P(C(1), 1), 1, C(1), 2),
                  P(P(C(1), 2), 0, P(C(-1), 1), 1, C(1), 2),
                  P(P(C(1), 4), 0, P(C(1), 2), 2, C(1), 4));
+  // Gęsty iloczyn z wieloma kolizjami wykładników
+  {
+    Mono m[100], r[199];
+    for (poly_exp_t i = 0; i < 100; i++) {
+      m[i] = (Mono) {.p = P(C(1), 1), .exp = i};
+    }
+    for (poly_exp_t i = 0; i < 199; i++) {
+      r[i] = (Mono) {.p = P(C(i < 100 ? i + 1 : 199 - i), 2), .exp = i};
+    }
+    Poly a = PolyAddMonos(100, m);
+    Poly b = PolyClone(&a);
+    res &= TestMul(a, b, PolyAddMonos(199, r));
+  }
+  return res;
+}
+
+static bool SimpleMulConfigTest(void) {
+  bool res = true;
+  PolyMulConfig saved, config;
+  PolyMulConfigGet(&saved);
+  config = saved;
+  res &= PolyMulConfigParse("hash_min_terms=5,hash_distinct_cost=7", &config);
+  res &= config.hash_min_terms == 5 && config.hash_distinct_cost == 7 &&
+         config.hash_probe_cost == saved.hash_probe_cost;
+  // Niepoprawne napisy nie zmieniają progów
+  res &= !PolyMulConfigParse("hash_min_terms=1,unknown=2", &config);
+  res &= !PolyMulConfigParse("hash_probe_cost=", &config);
+  res &= !PolyMulConfigParse("hash_probe_cost=3x", &config);
+  res &= config.hash_min_terms == 5;
+  res &= PolyMulConfigParse("unbalanced_min_ratio=4", &config);
+  res &= config.unbalanced_min_ratio == 4 && config.hash_min_terms == 5;
+  // Wynik mnożenia nie zależy od wybranego algorytmu
+  Poly a = P(P(C(1), 0, C(2), 1), 0, C(3), 1, P(C(1), 2), 2, C(4), 3,
+             P(C(-1), 1), 5, C(1), 8, C(2), 13, C(5), 21, C(1), 34);
+  Poly s = P(P(C(-1), 1), 1, C(3), 4);
+  Poly expected = PolyMul(&a, &a);
+  Poly expectedSmall = PolyMul(&a, &s);
+  PolyMulConfig forced[] = {
+    { .hash_min_terms = SIZE_MAX, .hash_probe_cost = 0,
+      .hash_distinct_cost = 0, .unbalanced_min_ratio = SIZE_MAX },
+    { .hash_min_terms = 0, .hash_probe_cost = 0, .hash_distinct_cost = 0,
+      .unbalanced_min_ratio = SIZE_MAX },
+    { .hash_min_terms = 0, .hash_probe_cost = UINT_MAX,
+      .hash_distinct_cost = UINT_MAX, .unbalanced_min_ratio = 1 }
+  };
+  for (size_t i = 0; i < 3; i++) {
+    PolyMulConfigSet(&forced[i]);
+    Poly b = PolyMul(&a, &a);
+    Poly c = PolyMul(&s, &a);
+    res &= PolyIsEq(&b, &expected) && PolyIsEq(&c, &expectedSmall);
+    PolyDestroy(&b);
+    PolyDestroy(&c);
+  }
+  PolyMulConfigSet(&saved);
+  PolyDestroy(&a);
+  PolyDestroy(&s);
+  PolyDestroy(&expected);
+  PolyDestroy(&expectedSmall);
   return res;
 }
 
@@ -244,13 +457,238 @@ static bool SimpleNegTest(void) {
 }
 
 static bool SimpleSubTest(void) {
-  return TestSub(P(P(C(1), 2), 0, P(C(2), 1), 1, C(1), 2),
+  bool res = true;
+  res &= TestSub(P(P(C(1), 2), 0, P(C(2), 1), 1, C(1), 2),
                  P(P(C(1), 2), 0, P(C(-1), 0, C(-2), 1, C(-1), 2), 1, C(1), 2),
                  P(P(C(1), 0, C(4), 1, C(1), 2), 1));
+  // Odejmowanie wielomianu o wielokrotnie mniejszej liczbie jednomianów
+  res &= TestSub(SparsePoly(40, 0, NULL), SMALL_POLY,
+                 SparsePoly(40, 5, NEG_SMALL_MONOS));
+  res &= TestSub(SparsePoly(40, 5, SMALL_MONOS), SMALL_POLY,
+                 SparsePoly(40, 0, NULL));
+  return res;
 }
 
 #define POLY_P P(P(C(1), 3), 0, P(C(1), 2), 2, C(1), 3)
 
+static bool TestSqr(Poly a) {
+  Poly b = PolySqr(&a);
+  Poly c = PolyMul(&a, &a);
+  bool is_eq = PolyIsEq(&b, &c);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&c);
+  return is_eq;
+}
+
+static bool SimpleSqrTest(void) {
+  bool res = true;
+  res &= TestSqr(C(3));
+  res &= TestSqr(P(C(1), 0, C(-1), 1));
+  res &= TestSqr(POLY_P);
+  res &= TestSqr(P(P(C(1), 0, C(2), 2), 0, P(C(-3), 1), 1, C(4), 5));
+  // Podwojony iloczyn jest zerem wskutek przepełnienia
+  res &= TestSqr(P(C(1L << 32), 0, C(1L << 31), 1, C(1), 2));
+  return res;
+}
+
+static bool TestSumMany(size_t n, Poly ps[]) {
+  Poly expected = PolyZero();
+  for (size_t i = 0; i < n; i++) {
+    Poly tmp = PolyAdd(&expected, &ps[i]);
+    PolyDestroy(&expected);
+    expected = tmp;
+  }
+  Poly sum = PolySumMany(n, ps);
+  bool is_eq = PolyIsEq(&sum, &expected);
+  for (size_t i = 0; i < n; i++) {
+    PolyDestroy(&ps[i]);
+  }
+  PolyDestroy(&sum);
+  PolyDestroy(&expected);
+  return is_eq;
+}
+
+static bool SimpleSumManyTest(void) {
+  bool res = true;
+  res &= TestSumMany(0, NULL);
+  res &= TestSumMany(3, (Poly[]) {C(1), C(0), C(-4)});
+  res &= TestSumMany(2, (Poly[]) {C(0), POLY_P});
+  res &= TestSumMany(3, (Poly[]) {C(2), POLY_P, P(C(1), 1)});
+  res &= TestSumMany(5, (Poly[]) {P(C(1), 1), P(C(1), 2), P(C(1), 1, C(1), 3),
+                                  POLY_P, P(P(C(1), 1), 0)});
+  // Składniki znoszące się
+  res &= TestSumMany(3, (Poly[]) {P(C(1), 0, C(1), 2), P(C(-1), 2),
+                                  P(C(-1), 0)});
+  res &= TestSumMany(4, (Poly[]) {P(P(C(1), 1), 2), P(P(C(-1), 1), 2),
+                                  P(P(C(1), 2), 2), P(C(3), 5)});
+  return res;
+}
+
+static bool SimpleAccumTest(void) {
+  bool res = true;
+  PolyAccum acc;
+  Poly expected = PolyZero();
+
+  PolyAccumInit(&acc);
+  // Wiele dodawań przepełniających kolejne kubełki
+  for (poly_exp_t i = 0; i < 300; i++) {
+    Poly p = P(C(i % 7 - 3 + (i % 7 == 3)), i % 50, P(C(1), i % 3), 50 + i % 11);
+    Poly tmp = PolyAdd(&expected, &p);
+    PolyDestroy(&expected);
+    expected = tmp;
+    PolyAccumAdd(&acc, &p);
+    res &= PolyIsZero(&p);
+  }
+  {
+    Poly neg = PolyNeg(&expected);
+    Poly sum = PolyAccumFinish(&acc);
+    res &= PolyIsEq(&sum, &expected);
+    PolyDestroy(&sum);
+    // Akumulator jest pusty po zakończeniu
+    sum = PolyAccumFinish(&acc);
+    res &= PolyIsZero(&sum);
+    // Suma znosząca się do stałej
+    PolyAccumAdd(&acc, &neg);
+    Poly copy = PolyClone(&expected);
+    PolyAccumAdd(&acc, &copy);
+    sum = PolyAccumFinish(&acc);
+    res &= PolyIsZero(&sum);
+  }
+  // Składniki w różnych kubełkach, których współczynniki częściowo się
+  // znoszą przy scalaniu
+  {
+    Poly small = P(P(C(1), 1, C(2), 2), 0);
+    Poly c = C(5);
+    Poly big = SparsePoly(100, 1, (Mono[]) {M(P(C(-1), 1), 0)});
+    Poly expectedSum = SparsePoly(100, 1,
+                                  (Mono[]) {M(P(C(5), 0, C(2), 2), 0)});
+    PolyAccumAdd(&acc, &small);
+    PolyAccumAdd(&acc, &c);
+    PolyAccumAdd(&acc, &big);
+    Poly sum = PolyAccumFinish(&acc);
+    res &= PolyIsEq(&sum, &expectedSum);
+    PolyDestroy(&sum);
+    PolyDestroy(&expectedSum);
+  }
+  PolyDestroy(&expected);
+  return res;
+}
+
+static bool TestFma(Poly acc, Poly a, Poly b) {
+  Poly prod = PolyMul(&a, &b);
+  Poly expected = PolyAdd(&acc, &prod);
+  PolyFma(&acc, &a, &b);
+  bool is_eq = PolyIsEq(&acc, &expected);
+  PolyDestroy(&acc);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&prod);
+  PolyDestroy(&expected);
+  return is_eq;
+}
+
+static bool SimpleFmaTest(void) {
+  bool res = true;
+  res &= TestFma(C(1), C(2), C(3));
+  res &= TestFma(C(0), POLY_P, C(0));
+  res &= TestFma(C(5), C(2), POLY_P);
+  res &= TestFma(POLY_P, POLY_P, POLY_P);
+  res &= TestFma(P(C(1), 1), P(C(1), 0, C(1), 1), P(C(-1), 0, C(1), 1));
+  // Skrócenie się akumulatora z iloczynem
+  res &= TestFma(P(C(1), 0, C(-1), 2), P(C(1), 0, C(1), 1),
+                 P(C(-1), 0, C(1), 1));
+  res &= TestFma(P(P(C(1), 1), 0, C(2), 3), P(C(1), 1, C(1), 2),
+                 P(P(C(-1), 1), 2));
+  // Scalanie wierszy iloczynu z akumulatorem (czynniki bardzo różnej
+  // wielkości), ze skróceniem się jednomianów i akumulatorem stałym
+  res &= TestFma(P(C(-1), 2, C(7), 5, C(1), 1000), SparsePoly(100, 0, NULL),
+                 P(C(1), 0, C(-1), 1, C(1), 3));
+  res &= TestFma(C(4), SparsePoly(100, 1, (Mono[]) {M(C(-4), 0)}),
+                 P(C(1), 0, C(-1), 1, C(1), 3));
+  res &= TestFma(P(P(C(1), 1), 0, C(-2), 4), SparsePoly(100, 0, NULL),
+                 P(P(C(2), 1), 0, C(1), 2, C(-1), 5));
+  // Akumulator będący jednym z czynników
+  {
+    Poly a = POLY_P;
+    Poly b = P(C(1), 0, C(2), 1);
+    Poly prod = PolyMul(&a, &b);
+    Poly expected = PolyAdd(&a, &prod);
+    PolyFma(&a, &a, &b);
+    res &= PolyIsEq(&a, &expected);
+    PolyDestroy(&a);
+    PolyDestroy(&b);
+    PolyDestroy(&prod);
+    PolyDestroy(&expected);
+  }
+  return res;
+}
+
+static bool TestPow(Poly a, poly_exp_t n) {
+  Poly b = PolyPow(&a, n);
+  Poly c = PolyFromCoeff(1);
+  for (poly_exp_t i = 0; i < n; i++) {
+    Poly tmp = PolyMul(&c, &a);
+    PolyDestroy(&c);
+    c = tmp;
+  }
+  bool is_eq = PolyIsEq(&b, &c);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&c);
+  return is_eq;
+}
+
+static bool SimplePowTest(void) {
+  bool res = true;
+  res &= TestPow(C(3), 5);
+  res &= TestPow(POLY_P, 0);
+  res &= TestPow(P(P(C(2), 1), 3), 4);
+  // Rekurencja Millera
+  res &= TestPow(P(C(1), 0, C(-2), 1, C(3), 2), 7);
+  // Rekurencja Millera z przepełnieniem
+  res &= TestPow(P(C(1L << 20), 0, C(3), 1), 5);
+  // Rozwinięcie wielomianowe
+  res &= TestPow(P(C(1), 0, C(1), 100, C(-1), 1000), 6);
+  res &= TestPow(P(P(C(1), 1), 0, C(2), 3), 9);
+  // Wielokrotne podnoszenie do kwadratu
+  res &= TestPow(P(P(C(1), 1), 0, C(1), 1, C(-1), 2, P(C(2), 2), 3), 5);
+  return res;
+}
+
+static bool TestMulTrunc(Poly a, Poly b, size_t var_idx, poly_exp_t n) {
+  Poly c = PolyMul(&a, &b);
+  Poly expected = PolyTrunc(&c, var_idx, n);
+  Poly d = PolyMulTrunc(&a, &b, var_idx, n);
+  bool is_eq = PolyIsEq(&d, &expected);
+  Poly e = PolyPowTrunc(&a, 3, var_idx, n);
+  Poly f = PolyPow(&a, 3);
+  Poly g = PolyTrunc(&f, var_idx, n);
+  is_eq &= PolyIsEq(&e, &g);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&c);
+  PolyDestroy(&d);
+  PolyDestroy(&e);
+  PolyDestroy(&f);
+  PolyDestroy(&g);
+  PolyDestroy(&expected);
+  return is_eq;
+}
+
+static bool SimpleTruncTest(void) {
+  bool res = true;
+  res &= TestMulTrunc(C(2), C(3), 0, 0);
+  res &= TestMulTrunc(C(2), POLY_P, 0, 1);
+  res &= TestMulTrunc(POLY_P, POLY_P, 0, 4);
+  res &= TestMulTrunc(POLY_P, POLY_P, 1, 2);
+  res &= TestMulTrunc(P(C(1), 0, C(1), 1, C(1), 5), P(C(1), 0, C(-1), 1), 0, 3);
+  // Obcięcie usuwające wszystkie wyrazy
+  res &= TestMulTrunc(P(C(1), 2), P(P(C(1), 1), 3), 0, 4);
+  res &= TestMulTrunc(P(P(C(1), 1), 0, P(C(1), 2), 1), POLY_P, 1, 0);
+  return res;
+}
+
 static bool SimpleDegByTest(void) {
   bool res = true;
   res &= TestDegBy(C(0), 1, -1);
@@ -258,6 +696,14 @@ static bool SimpleDegByTest(void) {
   res &= TestDegBy(P(C(1), 1), 1, 0);
   res &= TestDegBy(POLY_P, 0, 3);
   res &= TestDegBy(POLY_P, 1, 3);
+  res &= TestDegBy(POLY_P, 2, 0);
+  res &= TestDegBy(P(P(P(C(1), 4), 1), 2), 2, 4);
+  // Stopień po modyfikacji wielomianu w miejscu
+  {
+    Poly a = P(P(C(1), 3), 0, C(1), 1);
+    Poly b = P(P(C(-1), 3), 0);
+    res &= TestDegBy(PolyAddOwn(&a, &b), 1, 0);
+  }
   return res;
 }
 
@@ -267,6 +713,12 @@ static bool SimpleDegTest(void) {
   res &= TestDeg(C(1), 0);
   res &= TestDeg(P(C(1), 1), 1);
   res &= TestDeg(POLY_P, 4);
+  {
+    Poly a = P(C(1), 0, C(1), 1, C(1), 2, C(1), 3, C(1), 4, C(1), 5,
+               C(1), 6, C(1), 7, C(1), 8, C(1), 9);
+    Poly b = P(C(-1), 9);
+    res &= TestDeg(PolyAddOwn(&a, &b), 8);
+  }
   return res;
 }
 
@@ -290,6 +742,71 @@ static bool SimpleIsEqTest(void) {
   return res;
 }
 
+static bool SimpleHashTest(void) {
+  bool res = true;
+  Poly a = POLY_P;
+  Poly b = POLY_P;
+  Poly c = P(P(C(1), 3), 0, P(C(1), 2), 2, C(2), 3);
+  res &= PolyHash(&a) == PolyHash(&b);
+  res &= PolyHash(&a) != PolyHash(&c);
+  // Skrót wielomianu zmodyfikowanego w miejscu
+  Poly d = P(C(-1), 3);
+  c = PolyAddOwn(&c, &d);
+  res &= PolyHash(&b) == PolyHash(&c);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&c);
+  return res;
+}
+
+static bool SimpleProbablyEqTest(void) {
+  bool res = true;
+  Poly a = POLY_P;
+  Poly b = P(P(C(1), 3), 0, P(C(1), 2), 2, C(2), 3);
+  Poly c = P(C(1), 0, C(1), 1);
+  Poly e = P(C(1), 0, C(2), 1, C(1), 2);
+  Poly ab = PolyMul(&a, &b);
+  Poly abc = PolyMul(&ab, &c);
+  Poly one = C(1);
+  Poly zero = C(0);
+  // Iloczyn zera i jednego czynnika jest porównywany dokładnie
+  res &= PolyProbablyEqProduct(&one, 0, NULL, 4);
+  res &= !PolyProbablyEqProduct(&a, 0, NULL, 4);
+  res &= PolyProbablyEqProduct(&a, 1, &a, 4);
+  res &= !PolyProbablyEqProduct(&a, 1, &b, 4);
+  res &= PolyProbablyEqProduct(&e, 2, (Poly[]) {c, c}, 4);
+  res &= !PolyProbablyEqProduct(&c, 2, (Poly[]) {c, c}, 4);
+  res &= PolyProbablyEqProduct(&ab, 2, (Poly[]) {b, a}, 4);
+  res &= !PolyProbablyEqProduct(&ab, 2, (Poly[]) {a, c}, 4);
+  res &= PolyProbablyEqProduct(&abc, 3, (Poly[]) {a, b, c}, 1);
+  res &= !PolyProbablyEqProduct(&abc, 3, (Poly[]) {a, b, e}, 1);
+  res &= PolyProbablyEqProduct(&zero, 2, (Poly[]) {a, zero}, 4);
+  res &= !PolyProbablyEqProduct(&a, 2, (Poly[]) {a, zero}, 4);
+  // Wielomiany stałe o ujemnych współczynnikach
+  res &= PolyProbablyEqProduct((Poly[]) {C(-6)}, 2, (Poly[]) {C(2), C(-3)}, 4);
+  res &= !PolyProbablyEqProduct((Poly[]) {C(6)}, 2, (Poly[]) {C(2), C(-3)}, 4);
+  // Iloczyn rzadkich wielomianów o odległych wykładnikach
+  {
+    Poly f = SparsePoly(60, 1, (Mono[]) {M(C(-7), 100000)});
+    Poly g = P(C(-1), 0, C(3), 50, C(1), 70000);
+    Poly fg = PolyMul(&f, &g);
+    Poly fgg = PolyMul(&fg, &g);
+    res &= PolyProbablyEqProduct(&fgg, 3, (Poly[]) {g, f, g}, 4);
+    res &= !PolyProbablyEqProduct(&fg, 3, (Poly[]) {g, f, g}, 4);
+    PolyDestroy(&f);
+    PolyDestroy(&g);
+    PolyDestroy(&fg);
+    PolyDestroy(&fgg);
+  }
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  PolyDestroy(&c);
+  PolyDestroy(&e);
+  PolyDestroy(&ab);
+  PolyDestroy(&abc);
+  return res;
+}
+
 static bool SimpleAtTest(void) {
   bool res = true;
   res &= TestAt(C(2), 1, C(2));
@@ -309,15 +826,300 @@ static bool OverflowTest(void) {
   return res;
 }
 
+static bool TestMulOwn(Poly a, Poly b) {
+  Poly expected = PolyMul(&a, &b);
+  Poly res = PolyMulOwn(&a, &b);
+  bool is_eq = PolyIsEq(&res, &expected) && PolyIsZero(&a) && PolyIsZero(&b);
+  PolyDestroy(&res);
+  PolyDestroy(&expected);
+  return is_eq;
+}
+
+static bool SimpleMulOwnTest(void) {
+  bool res = true;
+  res &= TestMulOwn(C(2), C(3));
+  res &= TestMulOwn(POLY_P, C(0));
+  res &= TestMulOwn(C(-2), POLY_P);
+  res &= TestMulOwn(POLY_P, POLY_P);
+  // Mnożenie przez jeden jednomian -- przesunięcie wykładników
+  res &= TestMulOwn(POLY_P, P(C(3), 4));
+  res &= TestMulOwn(P(P(C(2), 1), 3), POLY_P);
+  res &= TestMulOwn(P(P(C(1), 0, C(1), 2), 1), P(P(P(C(5), 1), 2), 7));
+  // Współczynnik zerujący się wskutek przepełnienia
+  res &= TestMulOwn(P(C(1L << 32), 0, C(3), 1), P(C(1L << 32), 2));
+  return res;
+}
+
+static bool TestSerialize(Poly a) {
+  size_t size;
+  uint8_t *data = PolySerialize(&a, &size);
+  Poly b;
+  bool res = PolyDeserialize(data, size, &b) == size;
+  res = res && PolyIsEq(&a, &b) && PolyHash(&a) == PolyHash(&b);
+  // Ucięty zapis jest odrzucany
+  for (size_t i = 0; res && i < size; i++) {
+    Poly c;
+    res &= PolyDeserialize(data, i, &c) == 0;
+  }
+  if (res) {
+    PolyDestroy(&b);
+  }
+  free(data);
+  PolyDestroy(&a);
+  return res;
+}
+
+static bool TestDeserializeInvalid(size_t size, const uint8_t data[]) {
+  Poly p;
+  return PolyDeserialize(data, size, &p) == 0;
+}
+
+static bool SimpleSerializeTest(void) {
+  bool res = true;
+  res &= TestSerialize(C(0));
+  res &= TestSerialize(C(-1));
+  res &= TestSerialize(C(LONG_MIN));
+  res &= TestSerialize(C(LONG_MAX));
+  res &= TestSerialize(POLY_P);
+  res &= TestSerialize(P(C(-5), 1, C(LONG_MIN), INT_MAX));
+  res &= TestSerialize(P(P(P(C(7), 2), 0, C(-3), 1), 5));
+  // Za zapisem mogą znajdować się inne dane
+  Poly a = POLY_P;
+  size_t size;
+  uint8_t *data = PolySerialize(&a, &size);
+  uint8_t *longer = malloc(size + 1);
+  CHECK_PTR(longer);
+  for (size_t i = 0; i < size; i++) {
+    longer[i] = data[i];
+  }
+  longer[size] = 0xff;
+  Poly b;
+  res &= PolyDeserialize(longer, size + 1, &b) == size;
+  res &= PolyIsEq(&a, &b);
+  PolyDestroy(&a);
+  PolyDestroy(&b);
+  free(data);
+  free(longer);
+  // Niepoprawna wersja
+  res &= TestDeserializeInvalid(7, (uint8_t[]) {'P', 'O', 'L', 'Y', 2, 0, 2});
+  // Jednomian równy stałej
+  res &= TestDeserializeInvalid(9, (uint8_t[]) {'P', 'O', 'L', 'Y', 1,
+                                                1, 0, 0, 2});
+  // Zerowy współczynnik
+  res &= TestDeserializeInvalid(9, (uint8_t[]) {'P', 'O', 'L', 'Y', 1,
+                                                1, 1, 0, 0});
+  // Powtórzony wykładnik
+  res &= TestDeserializeInvalid(12, (uint8_t[]) {'P', 'O', 'L', 'Y', 1,
+                                                 2, 1, 0, 2, 0, 0, 2});
+  // Wykładnik spoza zakresu
+  res &= TestDeserializeInvalid(13, (uint8_t[]) {'P', 'O', 'L', 'Y', 1,
+                                                 1, 0x80, 0x80, 0x80, 0x80,
+                                                 0x08, 0, 2});
+  return res;
+}
+
+#define FROZEN_TEST_PATH "poly_test_frozen.img"
+
+static bool TestFrozen(Poly a) {
+  bool res = PolyFreeze(&a, FROZEN_TEST_PATH);
+  // Ten sam obraz odwzorowany dwukrotnie, pod różnymi adresami
+  Poly b, c, d;
+  res = res && PolyLoadFrozen(FROZEN_TEST_PATH, &b);
+  res = res && PolyLoadFrozen(FROZEN_TEST_PATH, &c);
+  res = res && PolyLoadFrozen(FROZEN_TEST_PATH, &d);
+  remove(FROZEN_TEST_PATH);
+  if (!res) {
+    PolyDestroy(&a);
+    return false;
+  }
+  res &= PolyIsFrozen(&b) == !PolyIsCoeff(&a);
+  res &= PolyIsEq(&a, &b) && PolyIsEq(&a, &c);
+  res &= PolyDeg(&b) == PolyDeg(&a) && PolyDegBy(&c, 1) == PolyDegBy(&a, 1);
+  Poly at = PolyAt(&b, 3);
+  Poly expectedAt = PolyAt(&a, 3);
+  res &= PolyIsEq(&at, &expectedAt);
+  Poly composed = PolyCompose(&b, 1, (Poly[]) {C(2)});
+  Poly expectedComposed = PolyCompose(&a, 1, (Poly[]) {C(2)});
+  res &= PolyIsEq(&composed, &expectedComposed);
+  res &= PolyProbablyEqProduct(&b, 1, &c, 1);
+  // Pozostałe funkcje działają na kopii
+  Poly product = PolyMul(&b, &c);
+  Poly expectedProduct = PolyMul(&a, &a);
+  res &= PolyIsEq(&product, &expectedProduct) && !PolyIsFrozen(&product);
+  // Zamrożony współczynnik przekazany na własność jest kopiowany
+  Poly aCopy = PolyClone(&a);
+  Poly mono = PolyAddMonos(1, (Mono[]) {MonoFromPoly(&d, 1)});
+  Poly expectedMono = PolyAddMonos(1, (Mono[]) {MonoFromPoly(&aCopy, 1)});
+  res &= PolyIsEq(&mono, &expectedMono);
+  // Modyfikacja w miejscu tworzy kopię i usuwa odwzorowanie obrazu
+  Poly sum = PolyAddOwn(&b, &c);
+  Poly expectedSum = PolyAdd(&a, &a);
+  res &= PolyIsEq(&sum, &expectedSum) && !PolyIsFrozen(&sum);
+  PolyDestroy(&at);
+  PolyDestroy(&expectedAt);
+  PolyDestroy(&composed);
+  PolyDestroy(&expectedComposed);
+  PolyDestroy(&product);
+  PolyDestroy(&expectedProduct);
+  PolyDestroy(&mono);
+  PolyDestroy(&expectedMono);
+  PolyDestroy(&sum);
+  PolyDestroy(&expectedSum);
+  PolyDestroy(&a);
+  return res;
+}
+
+static bool SimpleFrozenTest(void) {
+  bool res = true;
+  res &= TestFrozen(C(-7));
+  res &= TestFrozen(POLY_P);
+  res &= TestFrozen(P(P(P(C(7), 2), 0, C(-3), 1), 5, POLY_P, 6));
+  // Obraz bez zapisanego wielomianu jest odrzucany
+  Poly a = POLY_P;
+  Poly b;
+  res &= PolyFreeze(&a, FROZEN_TEST_PATH);
+  FILE *file = fopen(FROZEN_TEST_PATH, "ab");
+  CHECK_PTR(file);
+  fputc(0, file);
+  fclose(file);
+  res &= !PolyLoadFrozen(FROZEN_TEST_PATH, &b);
+  remove(FROZEN_TEST_PATH);
+  res &= !PolyLoadFrozen(FROZEN_TEST_PATH, &b);
+  PolyDestroy(&a);
+  // Obraz z nadpisanym słowem jest odrzucany przy odwzorowaniu albo
+  // odczytywany bez wychodzenia poza odwzorowanie, a jego kopia jest
+  // poprawnym wielomianem
+  a = P(P(P(C(7), 2), 0, C(-3), 1), 5, POLY_P, 6);
+  res &= PolyFreeze(&a, FROZEN_TEST_PATH);
+  FILE *image = fopen(FROZEN_TEST_PATH, "r+b");
+  CHECK_PTR(image);
+  fseek(image, 0, SEEK_END);
+  long size = ftell(image);
+  for (long offset = 0; offset + 8 <= size; offset += 8) {
+    unsigned char word[8], garbage[8] = {0x41, 0x41, 0x41, 0x41,
+                                         0x41, 0x41, 0x41, 0x41};
+    fseek(image, offset, SEEK_SET);
+    res &= fread(word, 1, 8, image) == 8;
+    fseek(image, offset, SEEK_SET);
+    fwrite(garbage, 1, 8, image);
+    fflush(image);
+    Poly c;
+    if (PolyLoadFrozen(FROZEN_TEST_PATH, &c)) {
+      PolyIsEq(&c, &a);
+      for (size_t var = 0; var < 4; var++) {
+        PolyDegBy(&c, var);
+      }
+      Poly at = PolyAt(&c, 3);
+      Poly composed = PolyCompose(&c, 1, (Poly[]) {C(2)});
+      PolyProbablyEqProduct(&c, 2, (Poly[]) {a, C(1)}, 1);
+      Poly copy = PolyClone(&c);
+      size_t length;
+      uint8_t *data = PolySerialize(&copy, &length);
+      Poly decoded;
+      res &= PolyDeserialize(data, length, &decoded) == length;
+      res &= PolyIsEq(&decoded, &copy);
+      free(data);
+      PolyDestroy(&decoded);
+      PolyDestroy(&copy);
+      PolyDestroy(&composed);
+      PolyDestroy(&at);
+      PolyDestroy(&c);
+    }
+    fseek(image, offset, SEEK_SET);
+    fwrite(word, 1, 8, image);
+    fflush(image);
+  }
+  fclose(image);
+  remove(FROZEN_TEST_PATH);
+  PolyDestroy(&a);
+  return res;
+}
+
+#define NUM_OF_TEST_THREADS 4
+
+typedef struct {
+  Poly shared; // obraz odwzorowany przez główny wątek
+  Poly own; // obraz odwzorowany przez wątek i usuwany przez główny wątek
+  bool res;
+} ConcurrentArg;
+
+// Każdy wątek odwzorowuje własny obraz i mnoży wielomiany niezależnie
+// od pozostałych, korzystając też z obrazu wspólnego dla wszystkich wątków
+static void *ConcurrentWorker(void *arg) {
+  ConcurrentArg *data = arg;
+  Poly a = P(P(C(7), 2), 0, POLY_P, 6);
+  data->own = PolyZero();
+  data->res = PolyLoadFrozen(FROZEN_TEST_PATH, &data->own);
+  if (!data->res) {
+    PolyDestroy(&a);
+    return NULL;
+  }
+  data->res &= PolyIsFrozen(&data->own);
+  for (int i = 0; i < 100; i++) {
+    Poly product = PolyMul(&data->own, &a);
+    Poly shared = PolyMul(&data->shared, &a);
+    Poly expected = PolyMul(&a, &a);
+    data->res &= PolyIsEq(&product, &expected);
+    data->res &= PolyIsEq(&shared, &expected);
+    PolyDestroy(&product);
+    PolyDestroy(&shared);
+    PolyDestroy(&expected);
+  }
+  PolyDestroy(&a);
+  return NULL;
+}
+
+static bool SimpleConcurrentTest(void) {
+  Poly a = P(P(C(7), 2), 0, POLY_P, 6);
+  bool res = PolyFreeze(&a, FROZEN_TEST_PATH);
+  PolyDestroy(&a);
+  Poly shared = PolyZero();
+  res = res && PolyLoadFrozen(FROZEN_TEST_PATH, &shared);
+  pthread_t threads[NUM_OF_TEST_THREADS];
+  ConcurrentArg args[NUM_OF_TEST_THREADS];
+  int created = 0;
+  while (res && created < NUM_OF_TEST_THREADS) {
+    args[created].shared = shared;
+    res &= pthread_create(&threads[created], NULL, ConcurrentWorker,
+                          &args[created]) == 0;
+    created += res;
+  }
+  for (int i = 0; i < created; i++) {
+    pthread_join(threads[i], NULL);
+    res &= args[i].res;
+    // Obraz może zostać usunięty przez inny wątek niż ten, który go
+    // odwzorował
+    PolyDestroy(&args[i].own);
+  }
+  PolyDestroy(&shared);
+  remove(FROZEN_TEST_PATH);
+  return res;
+}
+
 int main() {
   assert(SimpleAddTest());
+  assert(SimpleAddOwnTest());
   assert(SimpleAddMonosTest());
+  assert(SimpleAddSortedMonosTest());
   assert(SimpleMulTest());
+  assert(SimpleMulConfigTest());
+  assert(SimpleMulOwnTest());
+  assert(SimpleSqrTest());
+  assert(SimpleSumManyTest());
+  assert(SimpleAccumTest());
+  assert(SimpleFmaTest());
+  assert(SimplePowTest());
+  assert(SimpleTruncTest());
   assert(SimpleNegTest());
   assert(SimpleSubTest());
   assert(SimpleDegByTest());
   assert(SimpleDegTest());
   assert(SimpleIsEqTest());
+  assert(SimpleHashTest());
+  assert(SimpleProbablyEqTest());
   assert(SimpleAtTest());
   assert(OverflowTest());
+  assert(SimpleSerializeTest());
+  assert(SimpleFrozenTest());
+  assert(SimpleConcurrentTest());
 }
@@ -0,0 +1,260 @@
+/** @file
+  Implementacja skryptów kalkulatora wczytywanych ze standardowego wejścia
+  lub z plików odwzorowanych w pamięci
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "output.h"
+#include "script.h"
+
+
+/** Rozmiar bloku, w jakim wczytywane jest standardowe wejście */
+#define BLOCK_SIZE (1 << 17)
+
+/** Funkcja sprawdzająca, czy wskaźnik @p p jest równy @p NULL.
+ * Jeśli jest -- awaryjnie kończy działanie programu kodem @p 1.
+ * W przeciwnym wypadku nie robi nic.
+ * @param[in] p : wskaźnik
+ */
+#define CHECK_PTR(p)  \
+  do {                \
+    if (p == NULL) {  \
+      exit(1);        \
+    }                 \
+  } while (0)
+
+
+/**
+ * Pusty plik nie jest odwzorowywany, gdyż funkcja @p mmap nie przyjmuje
+ * zerowej długości. Jądro jest informowane, że plik będzie czytany
+ * sekwencyjnie, co pozwala mu wczytywać strony z wyprzedzeniem.
+ */
+bool MapFile(const char *path, MappedFile *file) {
+  const int fd = open(path, O_RDONLY);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return false;
+  }
+
+  file->size = (size_t) info.st_size;
+  file->data = NULL;
+
+  if (file->size > 0) {
+    void *data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+
+    posix_madvise(data, file->size, POSIX_MADV_SEQUENTIAL);
+    file->data = data;
+  }
+
+  // Odwzorowanie pozostaje ważne po zamknięciu deskryptora
+  close(fd);
+  return true;
+}
+
+/**
+ * Pusty plik nie ma odwzorowania -- wtedy funkcja nie robi nic.
+ */
+void UnmapFile(MappedFile *file) {
+  if (file->data != NULL) {
+    munmap(file->data, file->size);
+  }
+}
+
+/**
+ * Wypisuje na standardowe wyjście błędów ścieżkę pliku i opis błędu
+ * zapisanego w @p errno, tak jak funkcja @p perror, ale przez bufory
+ * wyjścia -- dzięki temu komunikat może zostać przechwycony przez wątek
+ * wykonujący skrypt.
+ * @param[in] path : ścieżka pliku
+ */
+static void PrintFileError(const char *path) {
+  char message[256];
+
+  if (strerror_r(errno, message, sizeof(message)) != 0) {
+    strcpy(message, "Unknown error");
+  }
+
+  WriteString(ErrorOutput, path);
+  WriteString(ErrorOutput, ": ");
+  WriteString(ErrorOutput, message);
+  WriteChar(ErrorOutput, '\n');
+}
+
+/**
+ * Jeśli nie podano ścieżek, przydziela bufor na bloki standardowego wejścia.
+ * W przeciwnym razie odwzorowuje kolejne pliki; przy pierwszym błędzie
+ * wypisuje jego przyczynę, usuwa odwzorowania utworzone wcześniej i kończy
+ * działanie.
+ */
+bool OpenScript(Script *script, size_t numOfPaths, char *const paths[]) {
+  assert(script != NULL && (paths != NULL || numOfPaths == 0));
+
+  MappedFile *files = malloc((numOfPaths > 0 ? numOfPaths : 1) *
+                             sizeof(MappedFile));
+  char *block = NULL;
+
+  CHECK_PTR(files);
+
+  if (numOfPaths == 0) {
+    block = malloc(BLOCK_SIZE);
+    CHECK_PTR(block);
+  }
+
+  for (size_t i = 0; i < numOfPaths; i++) {
+    if (!MapFile(paths[i], &files[i])) {
+      PrintFileError(paths[i]);
+
+      while (i > 0) {
+        UnmapFile(&files[--i]);
+      }
+
+      free(files);
+      return false;
+    }
+  }
+
+  *script = (Script) {
+    .files = files,
+    .numOfFiles = numOfPaths,
+    .file = 0,
+    .block = block,
+    .endOfInput = false,
+    .chunk = NULL,
+    .chunkSize = 0,
+    .pos = 0,
+    .carry = CreateString()
+  };
+
+  return true;
+}
+
+/**
+ * Przechodzi do kolejnego fragmentu skryptu: wczytuje funkcją @p read
+ * kolejny blok standardowego wejścia (najpierw opróżniając bufory wyjścia)
+ * lub przechodzi do kolejnego pliku. Błąd odczytu jest traktowany jak
+ * koniec wejścia.
+ * @param[in] script : skrypt
+ * @return @p false, jeśli skrypt się skończył; @p true w przeciwnym razie
+ */
+static bool NextChunk(Script *script) {
+  script->pos = 0;
+
+  // Kolejny plik
+  if (script->block == NULL) {
+    if (script->file == script->numOfFiles) {
+      return false;
+    }
+
+    script->chunk = script->files[script->file].data;
+    script->chunkSize = script->files[script->file].size;
+    script->file++;
+    return true;
+  }
+
+  // Kolejny blok standardowego wejścia. Odczyt może czekać na użytkownika,
+  // więc wcześniej wypisywane są odpowiedzi na poprzednie polecenia
+  FlushOutput();
+
+  ssize_t count;
+
+  do {
+    count = script->endOfInput ? 0 : read(STDIN_FILENO, script->block,
+                                          BLOCK_SIZE);
+  } while (count < 0 && errno == EINTR);
+
+  if (count <= 0) {
+    script->endOfInput = true;
+    return false;
+  }
+
+  script->chunk = script->block;
+  script->chunkSize = (size_t) count;
+  return true;
+}
+
+/**
+ * Szuka funkcją @p memchr najbliższego znaku nowej linii w bieżącym
+ * fragmencie skryptu (bloku wejścia lub pliku). Jeśli go znajdzie, a żaden
+ * fragment linii nie pochodzi z poprzednich fragmentów skryptu, zwraca
+ * widok na ten fragment -- rolę znaku @p '\\0' pełni w nim kończący linię
+ * znak nowej linii. W przeciwnym wypadku dołącza fragment linii do kopii
+ * i przechodzi do kolejnego fragmentu skryptu. Po wyczerpaniu skryptu
+ * zwraca widok na kopię, zakończoną znakiem @p '\\0'.
+ */
+LineType ReadScriptLine(Script *script, string_t *line) {
+  assert(script != NULL && line != NULL);
+
+  ResetString(&script->carry);
+
+  do {
+    // Liczba nieprzeczytanych znaków bieżącego fragmentu
+    const size_t remaining = script->chunkSize - script->pos;
+    char *start = remaining > 0 ? script->chunk + script->pos : NULL;
+    char *end = remaining > 0 ? memchr(start, '\n', remaining) : NULL;
+
+    // Linia kończy się w bieżącym fragmencie
+    if (end != NULL) {
+      const size_t length = (size_t) (end - start);
+
+      script->pos += length + 1;
+
+      if (StringLength(&script->carry) == 0) {
+        *line = StringView(start, length);
+      }
+      else {
+        AppendChars(&script->carry, start, length);
+        *line = StringView(script->carry.chars, script->carry.length);
+      }
+
+      return EndOfLine;
+    }
+
+    // Koniec fragmentu nie kończy linii -- jej początek jest kopiowany,
+    // gdyż fragment zostanie nadpisany lub znak za nim jest niedostępny
+    AppendChars(&script->carry, start, remaining);
+  } while (NextChunk(script));
+
+  *line = StringView(script->carry.chars, script->carry.length);
+  return EndOfFile;
+}
+
+/**
+ * Usuwa odwzorowania wszystkich plików skryptu, tablicę plików, bufor
+ * bloków wejścia i kopię linii.
+ */
+void CloseScript(Script *script) {
+  assert(script != NULL);
+
+  for (size_t i = 0; i < script->numOfFiles; i++) {
+    UnmapFile(&script->files[i]);
+  }
+
+  free(script->files);
+  free(script->block);
+  DestroyString(&script->carry);
+}
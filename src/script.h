@@ -0,0 +1,88 @@
+/** @file
+  Interface of calculator scripts read from the standard input
+  or from memory-mapped files
+
+  @author Dawid Mędrek
+  @date 2021
+*/
+
+#ifndef __SCRIPT__
+#define __SCRIPT__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "newstring.h"
+
+/**
+ * Struct representing a file mapped into memory.
+ */
+typedef struct {
+  char *data; ///< contents of the file or @p NULL if it is empty
+  size_t size; ///< size of the file
+} MappedFile;
+
+/**
+ * Maps a file into memory for reading.
+ * @param[in] path : path of the file
+ * @param[out] file : mapped file
+ * @return @p true on success; @p false if the file could not be opened
+ * or mapped (then @p errno holds the reason)
+ */
+bool MapFile(const char *path, MappedFile *file);
+
+/**
+ * Unmaps a file mapped with `MapFile`.
+ * @param[in] file : mapped file
+ */
+void UnmapFile(MappedFile *file);
+
+/**
+ * Struct representing a calculator script: either the standard input,
+ * read in large blocks, or a sequence of files read as if they were
+ * concatenated.
+ */
+typedef struct {
+  MappedFile *files; ///< mapped files
+  size_t numOfFiles; ///< number of files
+  size_t file; ///< index of the next file to be read
+  char *block; ///< buffer for blocks of the standard input or @p NULL
+  bool endOfInput; ///< whether the standard input has been exhausted
+  char *chunk; ///< characters being read: a block or a mapped file
+  size_t chunkSize; ///< number of characters in @p chunk
+  size_t pos; ///< position of the first unread character in @p chunk
+  string_t carry; ///< copy of a line that crosses the end of @p chunk
+} Script;
+
+/**
+ * Opens a script. If no paths are given, the script is the standard
+ * input. Otherwise the given files are mapped into memory; if a file
+ * cannot be opened or mapped, prints the reason to the standard error
+ * stream, unmaps the files mapped so far and returns @p false.
+ * @param[out] script : pointer to a script
+ * @param[in] numOfPaths : number of files
+ * @param[in] paths : paths of the files
+ * @return @p true if the script was opened; @p false otherwise
+ */
+bool OpenScript(Script *script, size_t numOfPaths, char *const paths[]);
+
+/**
+ * Reads the next line of a script, without its ending new line character.
+ * Lines are returned as views of the block of the standard input or of
+ * the mapped file they are in, without copying them; only a line that
+ * crosses the end of a block or of a file is copied. The line stays valid
+ * until the next call.
+ * @param[in] script : pointer to a script
+ * @param[out] line : pointer to a string set to the line
+ * @return @p EndOfFile if the line ends the script;
+ * @p EndOfLine otherwise
+ */
+LineType ReadScriptLine(Script *script, string_t *line);
+
+/**
+ * Unmaps the files of a script and frees the memory it uses.
+ * @param[in] script : pointer to a script
+ */
+void CloseScript(Script *script);
+
+#endif